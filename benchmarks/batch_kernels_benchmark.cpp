@@ -0,0 +1,114 @@
+// Batched transform kernels at 1M elements: a per-object loop over the
+// Matrix4 API, the batched kernel, and the batched kernel split across the
+// job system, reported as time and bytes moved per second. A memcpy of the
+// same bytes is the bandwidth ceiling to compare against.
+//
+// usage: batch_kernels_benchmark [count]
+#include "../engine/math/batch_kernels.hpp"
+#include "../engine/job_system.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+using mathplease::AABB;
+using mathplease::Matrix4;
+using mathplease::Quaternion;
+using mathplease::Vector3;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Fn> double secondsPerRun(int repeats, Fn &&fn) {
+  fn(); // warm up caches and page in the outputs
+  const auto start = Clock::now();
+  for (int r = 0; r < repeats; ++r) fn();
+  return std::chrono::duration<double>(Clock::now() - start).count() / repeats;
+}
+
+void report(const char *name, double seconds, double bytes) {
+  std::printf("%-22s %9.3f ms %8.2f GB/s\n", name, seconds * 1e3, bytes / seconds * 1e-9);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+  constexpr int REPEATS = 20;
+
+  JobSystem jobSystem;
+  jobSystem.initialize(std::max(1u, std::thread::hardware_concurrency()));
+
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+  const Matrix4 matrix = Matrix4::translate({1.0f, 2.0f, 3.0f}) *
+                         Quaternion::fromAxisAngle({0.0f, 1.0f, 0.0f}, 0.5f).toMatrix();
+  std::vector<Vector3> points(count), pointOut(count);
+  std::vector<AABB> boxes(count), boxOut(count);
+  std::vector<Matrix4> matrices(count), matrixOut(count);
+  for (size_t i = 0; i < count; ++i) {
+    points[i] = Vector3(unit(rng), unit(rng), unit(rng));
+    boxes[i] = AABB{points[i], points[i] + Vector3(1.0f, 1.0f, 1.0f)};
+    for (float &value : matrices[i].m) value = unit(rng);
+  }
+
+  std::printf("backend %s, %zu elements, %u threads\n", mathplease::matrixBackendName(), count,
+              jobSystem.getThreadCount());
+
+  const double pointBytes = 2.0 * count * sizeof(Vector3);
+  report("points memcpy", secondsPerRun(REPEATS, [&] {
+           std::memcpy(pointOut.data(), points.data(), count * sizeof(Vector3));
+         }), pointBytes);
+  report("points per object", secondsPerRun(REPEATS, [&] {
+           for (size_t i = 0; i < count; ++i) pointOut[i] = (matrix * mathplease::Vector4(points[i], 1.0f)).xyz();
+         }), pointBytes);
+  report("points batched", secondsPerRun(REPEATS, [&] {
+           mathplease::transformPoints(matrix, points, pointOut);
+         }), pointBytes);
+  report("points batched jobs", secondsPerRun(REPEATS, [&] {
+           mathplease::transformPoints(matrix, points, pointOut, &jobSystem);
+         }), pointBytes);
+
+  const double boxBytes = 2.0 * count * sizeof(AABB);
+  report("aabbs memcpy", secondsPerRun(REPEATS, [&] {
+           std::memcpy(boxOut.data(), boxes.data(), count * sizeof(AABB));
+         }), boxBytes);
+  report("aabbs per object", secondsPerRun(REPEATS, [&] {
+           for (size_t i = 0; i < count; ++i) {
+             const Vector3 center = matrix.transformPoint((boxes[i].min + boxes[i].max) * 0.5f);
+             const Vector3 e = (boxes[i].max - boxes[i].min) * 0.5f;
+             Vector3 extent;
+             for (int r = 0; r < 3; ++r) {
+               (&extent.x)[r] = std::fabs(matrix(r, 0)) * e.x + std::fabs(matrix(r, 1)) * e.y +
+                                std::fabs(matrix(r, 2)) * e.z;
+             }
+             boxOut[i] = AABB{center - extent, center + extent};
+           }
+         }), boxBytes);
+  report("aabbs batched", secondsPerRun(REPEATS, [&] {
+           mathplease::transformAABBs(matrix, boxes, boxOut);
+         }), boxBytes);
+  report("aabbs batched jobs", secondsPerRun(REPEATS, [&] {
+           mathplease::transformAABBs(matrix, boxes, boxOut, &jobSystem);
+         }), boxBytes);
+
+  const double matrixBytes = 3.0 * count * sizeof(Matrix4);
+  report("matrices scalar loop", secondsPerRun(REPEATS, [&] {
+           for (size_t i = 0; i < count; ++i) matrixOut[i] = mathplease::scalar::multiply(matrices[i], matrices[i]);
+         }), matrixBytes);
+  report("matrices batched", secondsPerRun(REPEATS, [&] {
+           mathplease::mulMatrices(matrices, matrices, matrixOut);
+         }), matrixBytes);
+  report("matrices batched jobs", secondsPerRun(REPEATS, [&] {
+           mathplease::mulMatrices(matrices, matrices, matrixOut, &jobSystem);
+         }), matrixBytes);
+
+  volatile float sink = pointOut[count / 2].x + boxOut[count / 2].max.y + matrixOut[count / 2].m[3];
+  (void)sink;
+  return 0;
+}
@@ -0,0 +1,215 @@
+// ECS microbenchmarks: structural changes, lookups, iteration and the
+// gravity system at several world sizes. Results are written as JSON (default
+// ecs_benchmarks.json; engine logging goes to stdout) so CI can track them;
+// progress goes to stderr.
+//
+// usage: ecs_benchmarks [--max-entities N] [--layout interleaved|split] [--out file]
+#include "../engine/entity/entity.h"
+#include "../engine/entity/motion_kernels.h"
+#include "../engine/entity/prefab.h"
+#include "../engine/entity/scheduler.h"
+#include "../engine/entity/systems.h"
+#include "../engine/job_system.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr ComponentMask MOVING = Components::Position | Components::Velocity | Components::Gravity;
+constexpr uint32_t SIZES[] = {1000, 10000, 100000, 1000000, 4000000};
+// Small worlds are repeated until roughly this many entity operations ran
+constexpr uint64_t TARGET_OPERATIONS = 2000000;
+
+struct Result {
+  std::string name;
+  uint32_t entities;
+  uint32_t iterations;
+  double seconds; // total measured time over all iterations
+};
+
+std::vector<Result> results;
+ColumnLayout layout = ColumnLayout::Interleaved;
+
+uint32_t iterationsFor(uint32_t entities) {
+  return static_cast<uint32_t>(std::max<uint64_t>(1, TARGET_OPERATIONS / entities));
+}
+
+Prefab movingPrefab() {
+  Prefab prefab(MOVING);
+  prefab.set(Components::Position, Position{mathplease::Vector4(0.0f, 100.0f, 0.0f, 1.0f)});
+  prefab.set(Components::Velocity, Velocity{mathplease::Vector4(1.0f, 0.0f, 2.0f, 0.0f)});
+  return prefab;
+}
+
+std::unique_ptr<EntityManager> makeWorld(uint32_t entities, std::vector<Entity_id> *ids = nullptr) {
+  auto world = std::make_unique<EntityManager>(layout);
+  world->instantiate(movingPrefab(), entities, ids);
+  return world;
+}
+
+/*
+ * Runs setup (untimed) then body (timed) `iterations` times and records the
+ * summed body time.
+ */
+void measure(const char *name, uint32_t entities, uint32_t iterations,
+             const std::function<void()> &setup, const std::function<void()> &body) {
+  double seconds = 0.0;
+  for (uint32_t it = 0; it < iterations; ++it) {
+    if (setup) setup();
+    const auto start = Clock::now();
+    body();
+    seconds += std::chrono::duration<double>(Clock::now() - start).count();
+  }
+  results.push_back({name, entities, iterations, seconds});
+  std::fprintf(stderr, "%-24s %9u entities %10.2f ns/entity\n", name, entities,
+               seconds * 1e9 / (double(entities) * iterations));
+}
+
+void runSize(uint32_t n, JobSystem &jobSystem) {
+  const uint32_t iterations = iterationsFor(n);
+  std::mt19937 rng(n);
+  std::unique_ptr<EntityManager> world;
+  std::vector<Entity_id> ids;
+
+  measure("create_entity", n, iterations, [&] { world = std::make_unique<EntityManager>(layout); },
+          [&] {
+            for (uint32_t i = 0; i < n; ++i) world->createEntity(MOVING);
+          });
+
+  // the empty world is built untimed, as for create_entity
+  const Prefab prefab = movingPrefab();
+  measure("instantiate_prefab", n, iterations, [&] { world = std::make_unique<EntityManager>(layout); },
+          [&] { world->instantiate(prefab, n); });
+
+  measure("destroy_entity_random", n, iterations,
+          [&] {
+            ids.clear();
+            world = makeWorld(n, &ids);
+            std::shuffle(ids.begin(), ids.end(), rng);
+          },
+          [&] {
+            for (Entity_id id : ids) world->destroyEntity(id);
+          });
+
+  ids.clear();
+  world = makeWorld(n, &ids);
+  measure("add_component", n, iterations, [&] {
+            for (Entity_id id : ids) world->removeComponent(id, Components::Health);
+          },
+          [&] {
+            for (Entity_id id : ids) world->addComponent(id, Components::Health);
+          });
+  measure("remove_component", n, iterations, [&] {
+            for (Entity_id id : ids) world->addComponent(id, Components::Health);
+          },
+          [&] {
+            for (Entity_id id : ids) world->removeComponent(id, Components::Health);
+          });
+
+  // lookups in random order defeat the prefetcher, like gameplay code would
+  std::vector<Entity_id> lookups = ids;
+  std::shuffle(lookups.begin(), lookups.end(), rng);
+  volatile float sink = 0.0f;
+  measure("get_component_random", n, iterations, nullptr, [&] {
+    float sum = 0.0f;
+    for (Entity_id id : lookups) {
+      if (layout == ColumnLayout::Split) {
+        // split columns have no struct to point at; gather instead
+        Velocity velocity;
+        world->readComponent(id, Components::Velocity, &velocity);
+        sum += velocity.value.x;
+        continue;
+      }
+      auto *velocity = static_cast<Velocity *>(world->getComponentData(id, Components::Velocity));
+      sum += velocity ? velocity->value.x : 0.0f;
+    }
+    sink = sink + sum;
+  });
+
+  measure("query_iterate", n, iterations, nullptr, [&] {
+    float sum = 0.0f;
+    forEachChunk(*world, nullptr, Components::Velocity, [&sum](Archetype &archetype, Chunk &chunk) {
+      const uint8_t index = componentMaskToIndex(Components::Velocity);
+      const float *x = reinterpret_cast<const float *>(archetype.column(chunk, index));
+      // interleaved Vector4 rows are 4 floats apart, split streams 1
+      const uint32_t stride = archetype.lanes[index] > 1 ? 1 : 4;
+      for (uint32_t row = 0; row < chunk.row; ++row) sum += x[row * stride];
+    });
+    sink = sink + sum;
+  });
+
+  GravitySystem gravity;
+  measure("gravity_update", n, iterations, nullptr,
+          [&] { gravity.update(*world, nullptr, 1.0f / 60.0f); });
+  measure("gravity_update_jobs", n, iterations, nullptr,
+          [&] { gravity.update(*world, &jobSystem, 1.0f / 60.0f); });
+}
+
+void writeJson(FILE *out, uint32_t threads) {
+  std::fprintf(out, "{\n  \"context\": {\n");
+  std::fprintf(out, "    \"layout\": \"%s\",\n",
+               layout == ColumnLayout::Split ? "split" : "interleaved");
+  std::fprintf(out, "    \"kernel_backend\": \"%s\",\n", kernelBackendName(detectKernelBackend()));
+  std::fprintf(out, "    \"threads\": %u\n  },\n  \"benchmarks\": [\n", threads);
+  for (size_t i = 0; i < results.size(); ++i) {
+    const Result &r = results[i];
+    const double operations = double(r.entities) * r.iterations;
+    std::fprintf(out,
+                 "    {\"name\": \"%s\", \"entities\": %u, \"iterations\": %u, "
+                 "\"seconds\": %.9f, \"ns_per_entity\": %.3f, \"entities_per_second\": %.1f}%s\n",
+                 r.name.c_str(), r.entities, r.iterations, r.seconds, r.seconds * 1e9 / operations,
+                 operations / r.seconds, i + 1 < results.size() ? "," : "");
+  }
+  std::fprintf(out, "  ]\n}\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  uint32_t maxEntities = SIZES[std::size(SIZES) - 1];
+  const char *outPath = "ecs_benchmarks.json";
+  for (int i = 1; i < argc; ++i) {
+    if (!std::strcmp(argv[i], "--max-entities") && i + 1 < argc) {
+      maxEntities = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (!std::strcmp(argv[i], "--layout") && i + 1 < argc) {
+      layout = !std::strcmp(argv[++i], "split") ? ColumnLayout::Split : ColumnLayout::Interleaved;
+    } else if (!std::strcmp(argv[i], "--out") && i + 1 < argc) {
+      outPath = argv[++i];
+    } else {
+      std::fprintf(stderr,
+                   "usage: %s [--max-entities N] [--layout interleaved|split] [--out file]\n",
+                   argv[0]);
+      return 1;
+    }
+  }
+
+  const uint32_t threads = std::max(1u, std::thread::hardware_concurrency());
+  JobSystem jobSystem;
+  jobSystem.initialize(threads);
+
+  for (uint32_t n : SIZES) {
+    if (n > maxEntities) break;
+    runSize(n, jobSystem);
+  }
+
+  FILE *out = std::fopen(outPath, "w");
+  if (!out) {
+    std::fprintf(stderr, "cannot open %s\n", outPath);
+    return 1;
+  }
+  writeJson(out, threads);
+  std::fclose(out);
+  std::fprintf(stderr, "wrote %s\n", outPath);
+  return 0;
+}
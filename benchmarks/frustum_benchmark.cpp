@@ -0,0 +1,85 @@
+// Frustum culling throughput: Frustum::intersects one object at a time
+// against the batched SoA kernels, serial and across the job system.
+//
+// usage: frustum_benchmark [objectCount] [threads]
+#include "../engine/job_system.h"
+#include "../engine/math/frustum.hpp"
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace mathplease;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Fn> double secondsPerCall(Fn &&fn, int repeats) {
+  fn(); // warm up
+  const auto start = Clock::now();
+  for (int r = 0; r < repeats; ++r) fn();
+  return std::chrono::duration<double>(Clock::now() - start).count() / repeats;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 500000;
+  const uint32_t threads = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 4;
+  constexpr int REPEATS = 20;
+
+  std::mt19937 rng(9);
+  std::uniform_real_distribution<float> position(-200.0f, 200.0f);
+  std::uniform_real_distribution<float> size(0.1f, 3.0f);
+  std::vector<AABB> aabbs(count);
+  std::vector<float> cx(count), cy(count), cz(count), ex(count), ey(count), ez(count), radius(count);
+  for (size_t i = 0; i < count; ++i) {
+    cx[i] = position(rng);
+    cy[i] = position(rng);
+    cz[i] = position(rng);
+    ex[i] = size(rng);
+    ey[i] = size(rng);
+    ez[i] = size(rng);
+    radius[i] = size(rng);
+    const Vector3 center(cx[i], cy[i], cz[i]), extent(ex[i], ey[i], ez[i]);
+    aabbs[i] = AABB{center - extent, center + extent};
+  }
+  const BoxStreams boxes{cx.data(), cy.data(), cz.data(), ex.data(), ey.data(), ez.data()};
+  const SphereStreams spheres{cx.data(), cy.data(), cz.data(), radius.data()};
+
+  const Matrix4 viewProjection = Matrix4::perspective(0.9f, 16.0f / 9.0f, 0.1f, 150.0f) *
+                                 Matrix4::translate(Vector3(0.0f, -2.0f, -20.0f));
+  const Frustum frustum = Frustum::fromMatrix(viewProjection);
+  std::vector<uint64_t> visibility(visibilityWords(count));
+  std::vector<uint8_t> visibleFlags(count);
+
+  JobSystem jobSystem;
+  jobSystem.initialize(threads);
+
+  const double single = secondsPerCall(
+      [&] {
+        for (size_t i = 0; i < count; ++i) visibleFlags[i] = frustum.intersects(aabbs[i]);
+      },
+      REPEATS);
+  const double batchedBoxes = secondsPerCall([&] { cullBoxes(frustum, boxes, count, visibility.data()); }, REPEATS);
+  const double batchedSpheres =
+      secondsPerCall([&] { cullSpheres(frustum, spheres, count, visibility.data()); }, REPEATS);
+  const double parallelBoxes =
+      secondsPerCall([&] { cullBoxes(frustum, boxes, count, visibility.data(), &jobSystem); }, REPEATS);
+
+  size_t visible = 0;
+  cullBoxes(frustum, boxes, count, visibility.data());
+  for (uint64_t word : visibility) visible += std::popcount(word);
+
+  std::printf("%zu objects, %zu visible, matrix backend %s, %u threads\n", count, visible, matrixBackendName(),
+              threads);
+  std::printf("%-16s %10s %14s\n", "test", "ms", "Mobjects/s");
+  std::printf("%-16s %10.3f %14.1f\n", "box, single", single * 1e3, count / single / 1e6);
+  std::printf("%-16s %10.3f %14.1f\n", "box, batched", batchedBoxes * 1e3, count / batchedBoxes / 1e6);
+  std::printf("%-16s %10.3f %14.1f\n", "sphere, batched", batchedSpheres * 1e3, count / batchedSpheres / 1e6);
+  std::printf("%-16s %10.3f %14.1f\n", "box, jobs", parallelBoxes * 1e3, count / parallelBoxes / 1e6);
+  return 0;
+}
@@ -0,0 +1,76 @@
+// Compares GravitySystem::update over interleaved (AoS Vector4) and split
+// (SoA float stream) Position/Velocity columns.
+//
+// usage: gravity_layout_benchmark [entityCount] [iterations]
+#include "../engine/entity/entity.h"
+#include "../engine/entity/prefab.h"
+#include "../engine/entity/systems.h"
+#include "../engine/job_system.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+namespace {
+
+std::unique_ptr<EntityManager> buildWorld(ColumnLayout layout, uint32_t entityCount) {
+  const ComponentMask mask =
+      Components::Position | Components::Velocity | Components::Gravity;
+  Prefab prefab(mask);
+  prefab.set(Components::Position, Position{mathplease::Vector4(0.0f, 100.0f, 0.0f, 1.0f)});
+  prefab.set(Components::Velocity, Velocity{mathplease::Vector4(1.0f, 0.0f, 2.0f, 0.0f)});
+
+  auto world = std::make_unique<EntityManager>(layout);
+  if (world->instantiate(prefab, entityCount) != entityCount) {
+    std::fprintf(stderr, "failed to allocate %u entities\n", entityCount);
+    std::exit(1);
+  }
+  return world;
+}
+
+double runSeconds(EntityManager &world, JobSystem *jobSystem, uint32_t iterations) {
+  GravitySystem gravity;
+  gravity.update(world, jobSystem, 1.0f / 60.0f); // warm up
+
+  const auto start = std::chrono::steady_clock::now();
+  for (uint32_t it = 0; it < iterations; ++it) {
+    gravity.update(world, jobSystem, 1.0f / 60.0f);
+  }
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() /
+         iterations;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const uint32_t entityCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+  const uint32_t iterations = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 50;
+
+  JobSystem jobSystem;
+  jobSystem.initialize(0);
+
+  std::printf("gravity update, %u entities, %u iterations\n", entityCount, iterations);
+  std::printf("%-12s %-8s %12s %12s\n", "layout", "threads", "ms/update", "Mentities/s");
+
+  const struct {
+    const char *name;
+    ColumnLayout layout;
+  } layouts[] = {{"interleaved", ColumnLayout::Interleaved},
+                 {"split", ColumnLayout::Split}};
+
+  for (const auto &entry : layouts) {
+    auto world = buildWorld(entry.layout, entityCount);
+    const double single = runSeconds(*world, nullptr, iterations);
+    const double multi = runSeconds(*world, &jobSystem, iterations);
+    std::printf("%-12s %-8s %12.3f %12.1f\n", entry.name, "1", single * 1e3,
+                entityCount / single / 1e6);
+    std::printf("%-12s %-8s %12.3f %12.1f\n", entry.name, "all", multi * 1e3,
+                entityCount / multi / 1e6);
+    const EcsMemoryStats memory = world->getMemoryStats();
+    std::printf("%-12s chunks %zu KB, %zu B/row, occupancy %.1f%%\n", entry.name,
+                memory.chunkBytesInUse / 1024, memory.archetypes[0].bytesPerRow,
+                memory.occupancy * 100.0f);
+  }
+  return 0;
+}
@@ -0,0 +1,85 @@
+// Cost of deterministic math. Built twice from this file: math_mode_benchmark_fast
+// with the default flags and math_mode_benchmark_deterministic with
+// MATHPLEASE_DETERMINISTIC and no FMA contraction (the two modes cannot share a
+// binary, the inline Matrix4 code would differ between translation units). Run
+// both with the same arguments and compare the columns.
+//
+// usage: math_mode_benchmark_{fast,deterministic} [count]
+#include "../engine/entity/motion_kernels.h"
+#include "../engine/math/vector.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using mathplease::Matrix4;
+using mathplease::Vector3;
+using mathplease::Vector4;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Fn> double nsPerOp(uint32_t count, int repeats, Fn &&fn) {
+  fn(); // warm up
+  const auto start = Clock::now();
+  for (int r = 0; r < repeats; ++r) fn();
+  return std::chrono::duration<double>(Clock::now() - start).count() * 1e9 / (double(count) * repeats);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const uint32_t count = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 100000;
+  constexpr int REPEATS = 20;
+  const float deltaTime = 1.0f / 60.0f;
+
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+  std::vector<Matrix4> matrices(count), out(count);
+  std::vector<Vector4> vectors(count), vectorOut(count);
+  std::vector<Vector3> directions(count), directionOut(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    for (float &value : matrices[i].m) value = unit(rng);
+    matrices[i].m[0] += 4.0f; // keep them comfortably invertible
+    matrices[i].m[5] += 4.0f;
+    matrices[i].m[10] += 4.0f;
+    matrices[i].m[15] += 4.0f;
+    vectors[i] = Vector4(unit(rng), unit(rng), unit(rng), 1.0f);
+    directions[i] = Vector3(unit(rng), unit(rng), unit(rng) + 2.0f);
+  }
+  std::vector<float> px(count, 0.0f), py(count, 100.0f), pz(count, 0.0f);
+  std::vector<float> vx(count, 1.0f), vy(count, 0.0f), vz(count, 2.0f);
+  const GravityKernels &kernels = getGravityKernels();
+
+  const double multiply = nsPerOp(count - 1, REPEATS, [&] {
+    for (uint32_t i = 1; i < count; ++i) out[i] = matrices[i - 1] * matrices[i];
+  });
+  const double matVec = nsPerOp(count, REPEATS, [&] {
+    for (uint32_t i = 0; i < count; ++i) vectorOut[i] = matrices[i] * vectors[i];
+  });
+  const double inverse = nsPerOp(count, REPEATS, [&] {
+    for (uint32_t i = 0; i < count; ++i) out[i] = matrices[i].inverse();
+  });
+  const double normalize = nsPerOp(count, REPEATS, [&] {
+    for (uint32_t i = 0; i < count; ++i) directionOut[i] = directions[i].normalized();
+  });
+  const double gravity = nsPerOp(count, REPEATS, [&] {
+    kernels.split({px.data(), py.data(), pz.data()}, {vx.data(), vy.data(), vz.data()}, count, deltaTime);
+  });
+
+  volatile float sink = out[count / 2].m[5] + vectorOut[count / 2].y + directionOut[count / 2].z + py[count / 2];
+  (void)sink;
+
+  std::printf("math mode: %s, matrix backend %s, gravity kernels %s, %u elements\n",
+              mathplease::isDeterministicMath() ? "deterministic" : "fast", mathplease::matrixBackendName(),
+              kernelBackendName(detectKernelBackend()), count);
+  std::printf("%-10s %10s\n", "op", "ns/op");
+  std::printf("%-10s %10.2f\n", "multiply", multiply);
+  std::printf("%-10s %10.2f\n", "mat*vec", matVec);
+  std::printf("%-10s %10.2f\n", "inverse", inverse);
+  std::printf("%-10s %10.2f\n", "normalize", normalize);
+  std::printf("%-10s %10.2f\n", "gravity", gravity);
+  return 0;
+}
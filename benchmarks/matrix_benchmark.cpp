@@ -0,0 +1,86 @@
+// Matrix4 operations: the inline backend selected at compile time (see
+// engine/math/matrix_simd.hpp) against the out-of-line scalar reference.
+// Build with -mavx (or LIGHTSPLEASE_NATIVE_ARCH) to measure the AVX path.
+//
+// usage: matrix_benchmark [count]
+#include "../engine/math/vector.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using mathplease::Matrix4;
+using mathplease::Vector4;
+namespace scalar = mathplease::scalar;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Fn> double nsPerOp(uint32_t count, int repeats, Fn &&fn) {
+  const auto start = Clock::now();
+  for (int r = 0; r < repeats; ++r) fn();
+  return std::chrono::duration<double>(Clock::now() - start).count() * 1e9 / (double(count) * repeats);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const uint32_t count = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 100000;
+  constexpr int REPEATS = 20;
+
+  std::mt19937 rng(5);
+  std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+  std::vector<Matrix4> matrices(count), out(count);
+  std::vector<Vector4> vectors(count), vectorOut(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    for (float &value : matrices[i].m) value = unit(rng);
+    matrices[i].m[0] += 4.0f; // keep them comfortably invertible
+    matrices[i].m[5] += 4.0f;
+    matrices[i].m[10] += 4.0f;
+    matrices[i].m[15] += 4.0f;
+    vectors[i] = Vector4(unit(rng), unit(rng), unit(rng), 1.0f);
+  }
+
+  // each element composed with its predecessor, like child = parent * local
+  const double scalarMul = nsPerOp(count - 1, REPEATS, [&] {
+    for (uint32_t i = 1; i < count; ++i) out[i] = scalar::multiply(matrices[i - 1], matrices[i]);
+  });
+  const double inlineMul = nsPerOp(count - 1, REPEATS, [&] {
+    for (uint32_t i = 1; i < count; ++i) out[i] = matrices[i - 1] * matrices[i];
+  });
+
+  const double scalarVec = nsPerOp(count, REPEATS, [&] {
+    for (uint32_t i = 0; i < count; ++i) vectorOut[i] = scalar::transform(matrices[i], vectors[i]);
+  });
+  const double inlineVec = nsPerOp(count, REPEATS, [&] {
+    for (uint32_t i = 0; i < count; ++i) vectorOut[i] = matrices[i] * vectors[i];
+  });
+
+  const double scalarTranspose = nsPerOp(count, REPEATS, [&] {
+    for (uint32_t i = 0; i < count; ++i) out[i] = scalar::transpose(matrices[i]);
+  });
+  const double inlineTranspose = nsPerOp(count, REPEATS, [&] {
+    for (uint32_t i = 0; i < count; ++i) out[i] = matrices[i].transposed();
+  });
+
+  const double scalarInv = nsPerOp(count, REPEATS, [&] {
+    for (uint32_t i = 0; i < count; ++i) out[i] = scalar::inverse(matrices[i]);
+  });
+  const double inlineInv = nsPerOp(count, REPEATS, [&] {
+    for (uint32_t i = 0; i < count; ++i) out[i] = matrices[i].inverse();
+  });
+
+  volatile float sink = out[count / 2].m[5] + vectorOut[count / 2].y;
+  (void)sink;
+
+  std::printf("backend: %s\n", mathplease::matrixBackendName());
+  std::printf("%-10s %10s %10s %8s\n", "op", "scalar ns", "inline ns", "speedup");
+  std::printf("%-10s %10.2f %10.2f %7.2fx\n", "multiply", scalarMul, inlineMul, scalarMul / inlineMul);
+  std::printf("%-10s %10.2f %10.2f %7.2fx\n", "mat*vec", scalarVec, inlineVec, scalarVec / inlineVec);
+  std::printf("%-10s %10.2f %10.2f %7.2fx\n", "transpose", scalarTranspose, inlineTranspose,
+              scalarTranspose / inlineTranspose);
+  std::printf("%-10s %10.2f %10.2f %7.2fx\n", "inverse", scalarInv, inlineInv, scalarInv / inlineInv);
+  return 0;
+}
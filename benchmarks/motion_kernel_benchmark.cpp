@@ -0,0 +1,57 @@
+// Raw throughput of the gravity integration kernels per backend and layout,
+// outside the ECS so chunk iteration and job overhead are not measured.
+//
+// usage: motion_kernel_benchmark [entityCount] [iterations]
+#include "../engine/entity/motion_kernels.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+template <typename Fn> double secondsPerCall(Fn &&fn, uint32_t iterations) {
+  fn(); // warm up
+  const auto start = std::chrono::steady_clock::now();
+  for (uint32_t it = 0; it < iterations; ++it) fn();
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() /
+         iterations;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const uint32_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+  const uint32_t iterations = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 100;
+  const float deltaTime = 1.0f / 60.0f;
+
+  std::vector<Position> positions(count, Position{mathplease::Vector4(0.0f, 100.0f, 0.0f, 1.0f)});
+  std::vector<Velocity> velocities(count, Velocity{mathplease::Vector4(1.0f, 0.0f, 2.0f, 0.0f)});
+  std::vector<float> px(count, 0.0f), py(count, 100.0f), pz(count, 0.0f);
+  std::vector<float> vx(count, 1.0f), vy(count, 0.0f), vz(count, 2.0f);
+
+  std::printf("gravity kernels, %u entities, %u iterations, detected %s\n", count, iterations,
+              kernelBackendName(detectKernelBackend()));
+  std::printf("%-8s %-12s %12s %12s\n", "backend", "layout", "ms/call", "Mentities/s");
+
+  for (KernelBackend backend : {KernelBackend::Scalar, KernelBackend::SSE, KernelBackend::AVX2}) {
+    if (!isKernelBackendSupported(backend)) continue;
+    const GravityKernels &kernels = getGravityKernels(backend);
+
+    const double interleaved = secondsPerCall(
+        [&] { kernels.interleaved(positions.data(), velocities.data(), count, deltaTime); },
+        iterations);
+    const double split = secondsPerCall(
+        [&] {
+          kernels.split({px.data(), py.data(), pz.data()}, {vx.data(), vy.data(), vz.data()},
+                        count, deltaTime);
+        },
+        iterations);
+
+    std::printf("%-8s %-12s %12.3f %12.1f\n", kernelBackendName(backend), "interleaved",
+                interleaved * 1e3, count / interleaved / 1e6);
+    std::printf("%-8s %-12s %12.3f %12.1f\n", kernelBackendName(backend), "split", split * 1e3,
+                count / split / 1e6);
+  }
+  return 0;
+}
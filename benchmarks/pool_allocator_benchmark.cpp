@@ -0,0 +1,95 @@
+// Multithreaded alloc/free throughput of ConcurrentPoolAllocator against
+// malloc/free for the same block size. Each thread repeatedly allocates a
+// burst of blocks, touches them and frees them; a second pattern frees
+// every block on the neighbouring thread, as jobs that hand data to each
+// other do.
+//
+// usage: pool_allocator_benchmark [blockSize] [maxThreads]
+#include "../engine/memory/concurrent_pool_allocator.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t BURST = 256;
+constexpr int ROUNDS = 4000;
+
+struct MallocSource {
+  size_t blockSize;
+  void *allocate() { return std::malloc(blockSize); }
+  void deallocate(void *block) { std::free(block); }
+};
+
+struct PoolSource {
+  ConcurrentPoolAllocator &pool;
+  void *allocate() { return pool.allocate(); }
+  void deallocate(void *block) { pool.deallocate(block); }
+};
+
+// Allocates on every thread; frees on thread (t + shift) % threads
+template <typename Source>
+double millionOpsPerSecond(Source source, size_t blockSize, unsigned threads, unsigned shift) {
+  std::vector<std::vector<void *>> handoff(threads, std::vector<void *>(BURST));
+  std::atomic<unsigned> arrived{0};
+  std::atomic<int> generation{0};
+  const auto barrier = [&](int &localGeneration) {
+    if (arrived.fetch_add(1) + 1 == threads) {
+      arrived.store(0);
+      generation.fetch_add(1);
+    } else {
+      while (generation.load() == localGeneration) std::this_thread::yield();
+    }
+    ++localGeneration;
+  };
+
+  const auto start = Clock::now();
+  std::vector<std::thread> workers;
+  for (unsigned t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      int localGeneration = 0;
+      for (int round = 0; round < ROUNDS; ++round) {
+        for (void *&block : handoff[t]) {
+          block = source.allocate();
+          std::memset(block, static_cast<int>(t), blockSize);
+        }
+        if (shift != 0) barrier(localGeneration);
+        for (void *block : handoff[(t + shift) % threads]) source.deallocate(block);
+        if (shift != 0) barrier(localGeneration);
+      }
+    });
+  }
+  for (std::thread &worker : workers) worker.join();
+  const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  return 2.0 * BURST * ROUNDS * threads / seconds / 1e6;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const size_t blockSize = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 64;
+  const unsigned maxThreads = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 8;
+
+  std::printf("block size %zu, %zu blocks per burst, %d rounds, %u hardware threads\n", blockSize, BURST, ROUNDS,
+              std::thread::hardware_concurrency());
+  std::printf("%-8s %-12s %14s %14s\n", "threads", "pattern", "malloc Mops/s", "pool Mops/s");
+  for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+    for (unsigned shift : {0u, 1u}) {
+      if (shift != 0 && threads == 1) continue;
+      ConcurrentPoolAllocator pool(blockSize, 4096);
+      const double viaMalloc = millionOpsPerSecond(MallocSource{blockSize}, blockSize, threads, shift);
+      const double viaPool = millionOpsPerSecond(PoolSource{pool}, blockSize, threads, shift);
+      std::printf("%-8u %-12s %14.1f %14.1f\n", threads, shift ? "cross-thread" : "same-thread", viaMalloc, viaPool);
+      const ConcurrentPoolAllocator::Stats stats = pool.getStats();
+      std::printf("%-8s pool: %zu slabs, %zu blocks, peak %zu used\n", "", stats.slabCount, stats.totalBlocks,
+                  stats.peakUsedBlocks);
+    }
+  }
+  return 0;
+}
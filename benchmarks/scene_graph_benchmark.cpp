@@ -0,0 +1,145 @@
+// Transform hierarchy benchmark at 100k transforms: building the graph, a
+// full world-matrix update, an update with 1% of the transforms dirty, and
+// reparenting throughput (same-depth relinks and depth-changing moves),
+// then serial vs level-parallel updates on deep and wide hierarchies.
+//
+// usage: scene_graph_benchmark [transforms]
+#include "../engine/entity/sceneGraph.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Roots with a fan-out of 4 below them, about 8 levels at 100k
+std::vector<Transform_id> build(SceneGraph &graph, uint32_t count) {
+  std::vector<Transform_id> ids;
+  ids.reserve(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    Transform_id parent = i < 16 ? NULL_TRANSFORM : ids[(i - 16) / 4];
+    ids.push_back(graph.createTransform(parent));
+    graph.setLocalPosition(ids.back(), mathplease::Vector4(0.01f * i, 1.0f, 0.0f, 1.0f));
+  }
+  return ids;
+}
+
+// `chains` independent chains of `depth` transforms: depth levels of `chains`
+// each. Returns the roots.
+std::vector<Transform_id> buildChains(SceneGraph &graph, uint32_t chains, uint32_t depth) {
+  std::vector<Transform_id> roots;
+  std::vector<Transform_id> tips(chains, NULL_TRANSFORM);
+  for (uint32_t level = 0; level < depth; ++level) {
+    for (Transform_id &tip : tips) {
+      tip = graph.createTransform(tip);
+      graph.setLocalPosition(tip, mathplease::Vector4(0.0f, 1.0f, 0.0f, 1.0f));
+      if (level == 0) roots.push_back(tip);
+    }
+  }
+  return roots;
+}
+
+// Moving every root dirties the whole graph, so each update recomputes it all
+void compareUpdates(const char *name, SceneGraph &graph, const std::vector<Transform_id> &roots,
+                    JobSystem &jobSystem) {
+  constexpr int UPDATES = 20;
+  double seconds[2] = {};
+  for (int pass = 0; pass < 2; ++pass) {
+    JobSystem *jobs = pass == 0 ? nullptr : &jobSystem;
+    graph.updateWorldTransforms(jobs);
+    const auto start = Clock::now();
+    for (int i = 0; i < UPDATES; ++i) {
+      for (Transform_id root : roots) graph.setLocalPosition(root, mathplease::Vector4(float(i), 0.0f, 0.0f, 1.0f));
+      graph.updateWorldTransforms(jobs);
+    }
+    seconds[pass] = secondsSince(start) / UPDATES;
+  }
+  std::printf("%-6s %5u levels  serial %8.3f ms  jobs %8.3f ms  speedup %.2fx\n", name,
+              graph.getLevelCount(), seconds[0] * 1e3, seconds[1] * 1e3, seconds[0] / seconds[1]);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const uint32_t count = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 100000;
+  std::mt19937 rng(7);
+  EntityManager em;
+
+  {
+    SceneGraph graph(em);
+    const auto start = Clock::now();
+    build(graph, count);
+    const double seconds = secondsSince(start);
+    std::printf("create        %10.2f ns/transform (%u levels)\n", seconds * 1e9 / count,
+                graph.getLevelCount());
+  }
+
+  SceneGraph graph(em);
+  std::vector<Transform_id> ids = build(graph, count);
+  graph.updateWorldTransforms(nullptr);
+
+  constexpr int UPDATES = 50;
+  auto start = Clock::now();
+  for (int i = 0; i < UPDATES; ++i) {
+    for (uint32_t r = 0; r < 16; ++r) graph.setLocalPosition(ids[r], mathplease::Vector4(float(i), 0.0f, 0.0f, 1.0f));
+    graph.updateWorldTransforms(nullptr);
+  }
+  double seconds = secondsSince(start);
+  std::printf("full update   %10.3f ms (%.2f ns/transform)\n", seconds * 1e3 / UPDATES,
+              seconds * 1e9 / (double(count) * UPDATES));
+
+  start = Clock::now();
+  for (int i = 0; i < UPDATES; ++i) {
+    for (uint32_t d = 0; d < count / 100; ++d) {
+      graph.setLocalPosition(ids[count - 1 - rng() % (count / 2)], mathplease::Vector4(float(i), 0.0f, 0.0f, 1.0f));
+    }
+    graph.updateWorldTransforms(nullptr);
+  }
+  seconds = secondsSince(start);
+  std::printf("1%% dirty      %10.3f ms\n", seconds * 1e3 / UPDATES);
+
+  // leaves moved between leaves' parents keep their depth: relink only
+  constexpr uint32_t REPARENTS = 20000;
+  const uint32_t leafStart = count - count / 2;
+  start = Clock::now();
+  for (uint32_t i = 0; i < REPARENTS; ++i) {
+    Transform_id leaf = ids[leafStart + rng() % (count - leafStart)];
+    Transform_id parent = graph.getParent(leaf);
+    Transform_id sibling = ids[leafStart + rng() % (count - leafStart)];
+    Transform_id newParent = graph.getParent(sibling);
+    if (parent != NULL_TRANSFORM && newParent != NULL_TRANSFORM) graph.setParent(leaf, newParent);
+  }
+  seconds = secondsSince(start);
+  std::printf("reparent same %10.0f ops/s\n", REPARENTS / seconds);
+
+  // leaves alternate between a root and their old parent: subtree re-sort
+  start = Clock::now();
+  for (uint32_t i = 0; i < REPARENTS; ++i) {
+    Transform_id leaf = ids[leafStart + rng() % (count - leafStart)];
+    graph.setParent(leaf, ids[rng() % 16]);
+  }
+  seconds = secondsSince(start);
+  std::printf("reparent move %10.0f ops/s\n", REPARENTS / seconds);
+
+  JobSystem jobSystem;
+  jobSystem.initialize(std::max(1u, std::thread::hardware_concurrency()));
+  struct Shape {
+    const char *name;
+    uint32_t chains;
+  } shapes[] = {{"wide", count / 2}, {"deep", count / 100}, {"deeper", count / 1000}};
+  for (const Shape &shape : shapes) {
+    SceneGraph shaped(em);
+    const std::vector<Transform_id> roots = buildChains(shaped, shape.chains, count / shape.chains);
+    compareUpdates(shape.name, shaped, roots, jobSystem);
+  }
+  return 0;
+}
@@ -0,0 +1,81 @@
+// Affine Transform (3x4) vs general Matrix4 on the operations hierarchy
+// propagation needs: building a local matrix from TRS, composing with the
+// parent, and inverting.
+//
+// usage: transform_benchmark [count]
+#include "../engine/math/vector.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using mathplease::Matrix4;
+using mathplease::Quaternion;
+using mathplease::Transform;
+using mathplease::Vector3;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Fn> double nsPerOp(uint32_t count, int repeats, Fn &&fn) {
+  const auto start = Clock::now();
+  for (int r = 0; r < repeats; ++r) fn();
+  return std::chrono::duration<double>(Clock::now() - start).count() * 1e9 / (double(count) * repeats);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const uint32_t count = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 100000;
+  constexpr int REPEATS = 20;
+
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+  std::vector<Vector3> positions(count), scales(count);
+  std::vector<Quaternion> rotations(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    positions[i] = Vector3(unit(rng), unit(rng), unit(rng));
+    scales[i] = Vector3(1.5f + unit(rng), 1.0f, 1.0f);
+    rotations[i] = Quaternion(unit(rng), unit(rng), unit(rng), unit(rng)).normalized();
+  }
+
+  std::vector<Matrix4> matrices(count), matrixOut(count);
+  std::vector<Transform> transforms(count), transformOut(count);
+
+  const double matrixTrs = nsPerOp(count, REPEATS, [&] {
+    for (uint32_t i = 0; i < count; ++i) {
+      matrices[i] = Matrix4::translate(positions[i]) * rotations[i].toMatrix() * Matrix4::scale(scales[i]);
+    }
+  });
+  const double transformTrs = nsPerOp(count, REPEATS, [&] {
+    for (uint32_t i = 0; i < count; ++i) {
+      transforms[i] = Transform::fromTRS(positions[i], rotations[i], scales[i]);
+    }
+  });
+
+  // each element composed with its predecessor, like child = parent * local
+  const double matrixMul = nsPerOp(count - 1, REPEATS, [&] {
+    for (uint32_t i = 1; i < count; ++i) matrixOut[i] = matrices[i - 1] * matrices[i];
+  });
+  const double transformMul = nsPerOp(count - 1, REPEATS, [&] {
+    for (uint32_t i = 1; i < count; ++i) transformOut[i] = transforms[i - 1] * transforms[i];
+  });
+
+  const double matrixInv = nsPerOp(count, REPEATS, [&] {
+    for (uint32_t i = 0; i < count; ++i) matrixOut[i] = matrices[i].inverse();
+  });
+  const double transformInv = nsPerOp(count, REPEATS, [&] {
+    for (uint32_t i = 0; i < count; ++i) transformOut[i] = transforms[i].inverse();
+  });
+
+  volatile float sink = matrixOut[count / 2].m[5] + transformOut[count / 2].m[5];
+  (void)sink;
+
+  std::printf("%-10s %12s %12s %8s\n", "op", "Matrix4 ns", "Transform ns", "ratio");
+  std::printf("%-10s %12.2f %12.2f %7.2fx\n", "trs", matrixTrs, transformTrs, matrixTrs / transformTrs);
+  std::printf("%-10s %12.2f %12.2f %7.2fx\n", "multiply", matrixMul, transformMul, matrixMul / transformMul);
+  std::printf("%-10s %12.2f %12.2f %7.2fx\n", "inverse", matrixInv, transformInv, matrixInv / transformInv);
+  return 0;
+}
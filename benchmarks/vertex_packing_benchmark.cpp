@@ -0,0 +1,103 @@
+// Packing an interleaved 44 byte vertex array into the 20 byte quantised
+// layout (see QuantizedVertex in engine/geometry.h): the batch converters
+// against a per-vertex loop over the single-value functions.
+//
+// usage: vertex_packing_benchmark [vertexCount]
+#include "../engine/math/vertex_packing.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace mathplease;
+
+namespace {
+
+// Same layouts as Vertex and QuantizedVertex, without pulling in Vulkan
+struct SourceVertex {
+  Vector3 pos;
+  Vector3 colour;
+  Vector3 normal;
+  Vector2 uv;
+};
+
+struct PackedVertex {
+  Unorm16x4 pos;
+  uint32_t colour;
+  uint32_t normal;
+  Half2 uv;
+};
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Fn> double secondsPerCall(Fn &&fn, int repeats) {
+  fn(); // warm up
+  const auto start = Clock::now();
+  for (int r = 0; r < repeats; ++r) fn();
+  return std::chrono::duration<double>(Clock::now() - start).count() / repeats;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+  constexpr int REPEATS = 10;
+
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+  std::vector<SourceVertex> vertices(count);
+  AABB bounds{Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 1.0f, 1.0f)};
+  for (SourceVertex &v : vertices) {
+    v.pos = Vector3(unit(rng), unit(rng), unit(rng));
+    v.colour = Vector3(0.5f + 0.5f * unit(rng), 0.5f + 0.5f * unit(rng), 0.5f + 0.5f * unit(rng));
+    v.normal = Vector3(unit(rng), unit(rng), unit(rng) + 2.0f).normalized();
+    v.uv = Vector2(unit(rng), unit(rng));
+  }
+  const PositionQuantization quantization = PositionQuantization::fromBounds(bounds);
+  std::vector<PackedVertex> packed(count);
+
+  const double perVertex = secondsPerCall(
+      [&] {
+        for (size_t i = 0; i < count; ++i) {
+          const SourceVertex &v = vertices[i];
+          packed[i] = PackedVertex{quantizePosition(quantization, v.pos),
+                                   packUnorm4x8(Vector4(v.colour.x, v.colour.y, v.colour.z, 1.0f)),
+                                   encodeOctahedral(v.normal), Half2{floatToHalf(v.uv.x), floatToHalf(v.uv.y)}};
+        }
+      },
+      REPEATS);
+
+  const double batched = secondsPerCall(
+      [&] {
+        quantizePositions(quantization, {&vertices[0].pos, sizeof(SourceVertex)}, {&packed[0].pos, sizeof(PackedVertex)},
+                          count);
+        packColours({&vertices[0].colour, sizeof(SourceVertex)}, {&packed[0].colour, sizeof(PackedVertex)}, count);
+        encodeOctahedral({&vertices[0].normal, sizeof(SourceVertex)}, {&packed[0].normal, sizeof(PackedVertex)}, count);
+        encodeHalf2({&vertices[0].uv, sizeof(SourceVertex)}, {&packed[0].uv, sizeof(PackedVertex)}, count);
+      },
+      REPEATS);
+
+  std::vector<SourceVertex> unpacked(count);
+  const double unpack = secondsPerCall(
+      [&] {
+        dequantizePositions(quantization, {&packed[0].pos, sizeof(PackedVertex)}, {&unpacked[0].pos, sizeof(SourceVertex)},
+                            count);
+        unpackColours({&packed[0].colour, sizeof(PackedVertex)}, {&unpacked[0].colour, sizeof(SourceVertex)}, count);
+        decodeOctahedral({&packed[0].normal, sizeof(PackedVertex)}, {&unpacked[0].normal, sizeof(SourceVertex)}, count);
+        decodeHalf2({&packed[0].uv, sizeof(PackedVertex)}, {&unpacked[0].uv, sizeof(SourceVertex)}, count);
+      },
+      REPEATS);
+
+  volatile uint32_t sink = packed[count / 2].normal + static_cast<uint32_t>(unpacked[count / 2].uv.x);
+  (void)sink;
+
+  std::printf("%zu vertices, %zu -> %zu bytes each (%.0f%% smaller), matrix backend %s\n", count, sizeof(SourceVertex),
+              sizeof(PackedVertex), 100.0 * (1.0 - double(sizeof(PackedVertex)) / sizeof(SourceVertex)),
+              matrixBackendName());
+  std::printf("%-12s %10s %14s\n", "pass", "ms", "Mvertices/s");
+  std::printf("%-12s %10.3f %14.1f\n", "per vertex", perVertex * 1e3, count / perVertex / 1e6);
+  std::printf("%-12s %10.3f %14.1f\n", "batched", batched * 1e3, count / batched / 1e6);
+  std::printf("%-12s %10.3f %14.1f\n", "unpack", unpack * 1e3, count / unpack / 1e6);
+  return 0;
+}
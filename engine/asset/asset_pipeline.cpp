@@ -1,6 +1,7 @@
 #include "asset_pipeline.h"
 
 #include "../logger.h"
+#include "../memory/memory_tracker.h"
 #include <algorithm>
 #include <cctype>
 #include <chrono>
@@ -125,9 +126,13 @@ MeshAssetData importObjMesh(const std::filesystem::path &sourcePath) {
     throw std::runtime_error("Failed to open mesh source: " + sourcePath.string());
   }
 
-  std::vector<std::array<float, 3>> positions;
-  std::vector<std::array<float, 3>> normals;
-  std::vector<std::array<float, 2>> uvs;
+  // parse-time arrays live in the job's scratch arena; only meshData
+  // outlives the import
+  JobSystem::ScratchScope scratch;
+  JobSystem::ScratchVector<std::array<float, 3>> positions;
+  JobSystem::ScratchVector<std::array<float, 3>> normals;
+  JobSystem::ScratchVector<std::array<float, 2>> uvs;
+  JobSystem::ScratchVector<std::uint32_t> faceVertexIndices;
   std::unordered_map<ObjVertexKey, std::uint32_t, ObjVertexKeyHash> uniqueVertices;
   MeshAssetData meshData;
 
@@ -163,7 +168,7 @@ MeshAssetData importObjMesh(const std::filesystem::path &sourcePath) {
       continue;
     }
 
-    std::vector<std::uint32_t> faceVertexIndices;
+    faceVertexIndices.clear();
     std::string vertexToken;
     while (lineStream >> vertexToken) {
       const ObjVertexKey key =
@@ -636,6 +641,7 @@ bool AssetPipeline::requestLoad(const AssetUUID &uuid) {
   impl->pendingLoads.fetch_add(1, std::memory_order_acq_rel);
   impl->jobSystem->kickJob(
       [this, snapshot]() mutable {
+        memory_tracker::TagScope tag(MemoryTag::Assets);
         LoadResult result{};
         try {
           result = loadAssetJob(snapshot);
@@ -145,6 +145,11 @@ mathplease::Matrix4 Camera::getProjectionMatrix(float nearPlane, float farPlane)
     return mathplease::Matrix4::perspective(fov * (M_PI / 180.0f), aspectRatio, nearPlane, farPlane);
 }
 
+mathplease::Frustum Camera::getFrustum(float nearPlane, float farPlane)
+{
+    return mathplease::Frustum::fromMatrix(getProjectionMatrix(nearPlane, farPlane) * getViewMatrix());
+}
+
 void Camera::update(float deltaTime)
 {
     // Calculate movement direction
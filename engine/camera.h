@@ -3,6 +3,7 @@
 #include <SDL_events.h>
 #include <vulkan/vulkan.h>
 #include "math/vector.hpp"
+#include "math/frustum.hpp"
 
 class Camera {
 public:
@@ -37,6 +38,8 @@ public:
     mathplease::Matrix4 getViewMatrix();
     mathplease::Matrix4 getRotationMatrix();
     mathplease::Matrix4 getProjectionMatrix(float nearPlane = 0.1f, float farPlane = 1000.0f);
+    // World-space frustum of getProjectionMatrix() * getViewMatrix(), for culling
+    mathplease::Frustum getFrustum(float nearPlane = 0.1f, float farPlane = 1000.0f);
 
     void update(float deltaTime);
 
@@ -26,3 +26,9 @@
 #else
 #  define LIGHTS_PLEASE_LOG_ENABLED 1
 #endif
+
+// Allocation tracking (engine/memory/memory_tracker.h). Set through the
+// LIGHTSPLEASE_MEMORY_TRACKING CMake option; off by default, and then free.
+#ifndef LIGHTS_PLEASE_MEMORY_TRACKING
+#  define LIGHTS_PLEASE_MEMORY_TRACKING 0
+#endif
@@ -21,9 +21,11 @@ Mesh::MeshData loadObjMeshData(const char *modelPath) {
 }
 
 void spawnRenderable(RenderSystem &renderSystem, EntityManager &entityManager,
-                     Mesh &mesh, Material &material,
+                     SceneGraph &sceneGraph, Mesh &mesh, Material &material,
                      const mathplease::Vector4 &position) {
-  renderSystem.createRenderableEntity(entityManager, &mesh, &material, position);
+  const Entity_id entity =
+      renderSystem.createRenderableEntity(entityManager, &mesh, &material, position);
+  sceneGraph.attachEntity(entity);
 }
 
 } // namespace
@@ -33,8 +35,10 @@ void DemoScene::load(Engine &engine) {
   RenderSystem *renderSystem = engine.getRenderSystem();
   EntityManager *entityManager = engine.getEntityManager();
   RuntimeAssetRegistry *assetRegistry = engine.getAssetRegistry();
+  SceneGraph *sceneGraph = engine.getSceneGraph();
 
-  if (!renderer || !renderSystem || !entityManager || !assetRegistry) {
+  if (!renderer || !renderSystem || !entityManager || !assetRegistry ||
+      !sceneGraph) {
     throw std::runtime_error("Engine subsystems are not initialized");
   }
 
@@ -50,7 +54,7 @@ void DemoScene::load(Engine &engine) {
     axisMesh = std::shared_ptr<Mesh>(renderer->createAxisMesh());
     assetRegistry->addMesh(kAxisMeshAssetId, axisMesh);
   }
-  spawnRenderable(*renderSystem, *entityManager, *axisMesh, *sharedMaterial,
+  spawnRenderable(*renderSystem, *entityManager, *sceneGraph, *axisMesh, *sharedMaterial,
                   mathplease::Vector4(0.0f, 0.0f, 0.0f, 1.0f));
 
   auto minionMesh = assetRegistry->getMesh(kMinionMeshAssetId);
@@ -59,7 +63,7 @@ void DemoScene::load(Engine &engine) {
     minionMesh = std::shared_ptr<Mesh>(renderer->createMesh(minionMeshData));
     assetRegistry->addMesh(kMinionMeshAssetId, minionMesh);
   }
-  spawnRenderable(*renderSystem, *entityManager, *minionMesh, *sharedMaterial,
+  spawnRenderable(*renderSystem, *entityManager, *sceneGraph, *minionMesh, *sharedMaterial,
                   mathplease::Vector4(0.0f, 0.0f, 0.0f, 1.0f));
 
   LOG_INFO("MAIN", "Loaded demo scene from asset registry: {}, {}",
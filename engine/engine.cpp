@@ -1,5 +1,6 @@
 #include "engine.h"
 #include "logger.h"
+#include "memory/memory_tracker.h"
 #include "platform.h"
 #include <memory>
 
@@ -9,18 +10,32 @@ void Engine::initialize() {
     platform::init(1280, 720);
 
     // create job system
-    job_system = std::make_unique<JobSystem>();
-    job_system->initialize(0);
+    {
+        memory_tracker::TagScope tag(MemoryTag::Jobs);
+        job_system = std::make_unique<JobSystem>();
+        job_system->initialize(0);
+    }
     
     // create camera
     camera = std::make_shared<Camera>();
 
     // create entity manager
-    entity_manager_ptr = std::make_unique<EntityManager>();
+    {
+        memory_tracker::TagScope tag(MemoryTag::ECS);
+        entity_manager_ptr = std::make_unique<EntityManager>();
+        scene_graph = std::make_unique<SceneGraph>(*entity_manager_ptr);
+    }
+
+    // register ECS systems; the scheduler derives parallel phases from their
+    // declared component access
+    systemScheduler.registerSystem("GravitySystem", gravitySystem);
 
     // create renderer from platform window
-    renderer = std::make_unique<Renderer>(platform::get_window_ptr());
-    renderer->setCamera(camera);
+    {
+        memory_tracker::TagScope tag(MemoryTag::Renderer);
+        renderer = std::make_unique<Renderer>(platform::get_window_ptr());
+        renderer->setCamera(camera);
+    }
 
     LOG_INFO("ENGINE", "Engine initialized");
 
@@ -74,7 +89,20 @@ void Engine::update(float fixed_dt) {
     // Update game logic, physics, AI, etc. here
     
     // Run systems
-    gravitySystem.update(*entity_manager_ptr, job_system.get(), fixed_dt);
+    systemScheduler.run(*entity_manager_ptr, job_system.get(), fixed_dt);
+    // publish this step's component events to consumers (rendering, hooks)
+    entity_manager_ptr->getEvents().sync();
+    // pick up moved/removed transforms, then recompute only the dirty ones
+    scene_graph->syncEntities();
+    scene_graph->updateWorldTransforms(job_system.get());
+
+    if (memoryReportInterval > 0.0f) {
+        memoryReportTimer += fixed_dt;
+        if (memoryReportTimer >= memoryReportInterval) {
+            memoryReportTimer = 0.0f;
+            entity_manager_ptr->logMemoryStats();
+        }
+    }
 
     // camera->update(fixed_dt);
     std::vector<Key> pressed_keys = platform::get_pressed_keys();
@@ -117,7 +145,9 @@ void Engine::render(float alpha) {
     // Render the current frame here
     // Use 'alpha' for interpolating between physics states if needed
     if (renderer) {
-        renderSystem.update(*entity_manager_ptr, *renderer);
+        memory_tracker::TagScope tag(MemoryTag::Renderer);
+        renderer->beginFrame();
+        renderSystem.update(*entity_manager_ptr, *renderer, scene_graph.get());
         renderer->drawFrame();
     } else{
         LOG_ERR("ENGINE", "Renderer doesnt exist??");
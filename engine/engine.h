@@ -6,6 +6,8 @@
 #include "camera.h"
 #include "entity/entity.h"
 #include "entity/renderSystem.h"
+#include "entity/sceneGraph.h"
+#include "entity/scheduler.h"
 #include "entity/systems.h"
 #include <functional>
 #include <memory>
@@ -22,11 +24,18 @@ public:
   Renderer *getRenderer() const { return renderer.get(); }
   EntityManager *getEntityManager() { return entity_manager_ptr.get(); }
   RenderSystem *getRenderSystem() { return &renderSystem; }
+  SceneGraph *getSceneGraph() { return scene_graph.get(); }
   RuntimeAssetRegistry *getAssetRegistry() { return &assetRegistry; }
   JobSystem *getJobSystem() const { return job_system.get(); }
+  SystemScheduler *getSystemScheduler() { return &systemScheduler; }
   void setFrameUpdateHook(FrameUpdateHook hook) {
     frameUpdateHook = std::move(hook);
   }
+  // Seconds of simulated time between ECS memory reports; 0 disables them
+  void setMemoryReportInterval(float seconds) {
+    memoryReportInterval = seconds;
+    memoryReportTimer = 0.0f;
+  }
 
 private:
   void process_input();
@@ -34,7 +43,9 @@ private:
   void render(float alpha);    // Variable rendering (Graphics)
   mathplease::Vector2 last_mouse_pos;
   std::unique_ptr<EntityManager> entity_manager_ptr;
+  std::unique_ptr<SceneGraph> scene_graph;
   GravitySystem gravitySystem;
+  SystemScheduler systemScheduler;
   RenderSystem renderSystem;
 
   bool is_running = false;
@@ -44,4 +55,6 @@ private:
   std::unique_ptr<Renderer> renderer;
   RuntimeAssetRegistry assetRegistry;
   FrameUpdateHook frameUpdateHook;
+  float memoryReportInterval = 10.0f;
+  float memoryReportTimer = 0.0f;
 };
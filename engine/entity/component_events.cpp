@@ -0,0 +1,62 @@
+#include "component_events.h"
+#include <algorithm>
+#include <bit>
+
+void ComponentEventStream::push(ComponentEvent event, ComponentMask components, Entity_id entity) {
+    const uint32_t slot = currentThreadSlot();
+    if (slot == THREAD_SLOT_OVERFLOW) {
+        std::lock_guard<std::mutex> lock(overflowMutex);
+        overflow.push_back({entity, components, event});
+        return;
+    }
+    buffers[slot].events.push_back({entity, components, event});
+}
+
+/*
+ * Counting sort: one pass to size every (event, component) stream, a prefix
+ * sum for their offsets, and one pass to scatter ids into place.
+ */
+void ComponentEventStream::sync() {
+    std::uint32_t counts[STREAM_COUNT] = {};
+    auto countEvents = [&counts](const std::vector<RawEvent>& events) {
+        for (const RawEvent& raw : events) {
+            for (ComponentMask bits = raw.components; bits; bits &= bits - 1) {
+                counts[streamIndex(raw.event, std::countr_zero(bits))]++;
+            }
+        }
+    };
+    for (const ThreadBuffer& buffer : buffers) countEvents(buffer.events);
+    countEvents(overflow);
+
+    streamStart[0] = 0;
+    for (std::size_t i = 0; i < STREAM_COUNT; ++i) {
+        streamStart[i + 1] = streamStart[i] + counts[i];
+    }
+    merged.resize(streamStart[STREAM_COUNT]);
+
+    std::uint32_t cursor[STREAM_COUNT];
+    std::copy(streamStart, streamStart + STREAM_COUNT, cursor);
+    auto scatter = [this, &cursor](std::vector<RawEvent>& events) {
+        for (const RawEvent& raw : events) {
+            for (ComponentMask bits = raw.components; bits; bits &= bits - 1) {
+                merged[cursor[streamIndex(raw.event, std::countr_zero(bits))]++] = raw.entity;
+            }
+        }
+        events.clear(); // keeps capacity for the next frame
+    };
+    for (ThreadBuffer& buffer : buffers) scatter(buffer.events);
+    scatter(overflow);
+}
+
+std::span<const Entity_id> ComponentEventStream::get(ComponentEvent event, ComponentMask component) const {
+    if (component == 0) return {};
+    const std::size_t stream = streamIndex(event, std::countr_zero(component));
+    return {merged.data() + streamStart[stream], streamStart[stream + 1] - streamStart[stream]};
+}
+
+void ComponentEventStream::clear() {
+    for (ThreadBuffer& buffer : buffers) buffer.events.clear();
+    overflow.clear();
+    merged.clear();
+    std::fill(std::begin(streamStart), std::end(streamStart), 0u);
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "../thread_slot.h"
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <vector>
+
+using Entity_id = std::uint32_t;
+using ComponentMask = uint16_t;
+
+enum class ComponentEvent : std::uint8_t { OnAdd, OnRemove, OnSet, Count };
+
+/*
+ * Per-component change streams. Producers on any thread append to their own
+ * thread-slot buffer without locking; sync() merges every buffer into one
+ * flat array grouped by (event, component) so consumers read each stream as a
+ * contiguous span of entity ids.
+ *
+ * Only components passed to observe() are recorded; everything else costs a
+ * mask test. Streams hold the events of the last sync() until the next one,
+ * are ordered per producing thread, and are not deduplicated (an entity set
+ * twice appears twice).
+ *
+ * sync() and observe() must not run concurrently with producers.
+ */
+class ComponentEventStream {
+public:
+    void observe(ComponentMask components) { observed |= components; }
+    void unobserve(ComponentMask components) { observed &= ~components; }
+    ComponentMask getObserved() const { return observed; }
+
+    /** Records the event for every observed component in the mask. Thread safe */
+    void record(ComponentEvent event, ComponentMask components, Entity_id entity) {
+        components &= observed;
+        if (components == 0) return;
+        push(event, components, entity);
+    }
+
+    /** Merges the per-thread buffers into the readable streams */
+    void sync();
+
+    /** Entities that got `event` on one component since the previous sync */
+    std::span<const Entity_id> get(ComponentEvent event, ComponentMask component) const;
+
+    /** Drops pending and merged events */
+    void clear();
+
+private:
+    static constexpr std::size_t COMPONENT_COUNT = sizeof(ComponentMask) * 8;
+    static constexpr std::size_t STREAM_COUNT =
+        COMPONENT_COUNT * static_cast<std::size_t>(ComponentEvent::Count);
+
+    struct RawEvent {
+        Entity_id entity;
+        ComponentMask components;
+        ComponentEvent event;
+    };
+
+    // cache line per slot so producers never share lines
+    struct alignas(64) ThreadBuffer {
+        std::vector<RawEvent> events;
+    };
+
+    void push(ComponentEvent event, ComponentMask components, Entity_id entity);
+    static std::size_t streamIndex(ComponentEvent event, std::uint8_t component) {
+        return static_cast<std::size_t>(event) * COMPONENT_COUNT + component;
+    }
+
+    ComponentMask observed = 0;
+    ThreadBuffer buffers[MAX_THREAD_SLOTS];
+    std::mutex overflowMutex;
+    std::vector<RawEvent> overflow; // threads without a slot
+
+    std::vector<Entity_id> merged;
+    std::uint32_t streamStart[STREAM_COUNT + 1] = {};
+};
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+/*
+ * Two-level bitset sized to the live element count: one bit per element in
+ * 64-bit words, plus a summary bit per word that is set whenever the word may
+ * be non-zero. Walking the set bits and clearing them cost O(dirty words),
+ * not O(size), so a frame where a handful of elements changed stays cheap no
+ * matter how many exist.
+ *
+ * Summary bits are only cleared by clear(); a reset() leaves them set and
+ * findNext skips such empty words.
+ *
+ * setConcurrent may race with other setConcurrent calls and with
+ * test/findNext on the same words; every other call needs exclusive access.
+ */
+class DirtyBitset {
+public:
+    static constexpr uint32_t NONE = 0xFFFFFFFF;
+
+    uint32_t size() const { return count; }
+
+    /** New bits start clear; shrinking drops the bits past the new size */
+    void resize(uint32_t newCount) {
+        if (newCount < count && (newCount & 63)) {
+            words[newCount >> 6] &= (uint64_t{1} << (newCount & 63)) - 1;
+        }
+        count = newCount;
+        words.resize((newCount + 63) >> 6, 0);
+        summary.resize((words.size() + 63) >> 6, 0);
+    }
+
+    bool test(uint32_t index) const {
+        return (load(words[index >> 6]) >> (index & 63)) & 1;
+    }
+
+    void set(uint32_t index) {
+        words[index >> 6] |= uint64_t{1} << (index & 63);
+        summary[index >> 12] |= uint64_t{1} << ((index >> 6) & 63);
+    }
+
+    void setConcurrent(uint32_t index) {
+        std::atomic_ref<uint64_t>(words[index >> 6])
+            .fetch_or(uint64_t{1} << (index & 63), std::memory_order_relaxed);
+        std::atomic_ref<uint64_t>(summary[index >> 12])
+            .fetch_or(uint64_t{1} << ((index >> 6) & 63), std::memory_order_relaxed);
+    }
+
+    void reset(uint32_t index) {
+        words[index >> 6] &= ~(uint64_t{1} << (index & 63));
+    }
+
+    void assign(uint32_t index, bool value) {
+        if (value) {
+            set(index);
+        } else {
+            reset(index);
+        }
+    }
+
+    /** First set bit in [from, end), or NONE */
+    uint32_t findNext(uint32_t from, uint32_t end) const {
+        if (from >= end) return NONE;
+        uint32_t word = from >> 6;
+        uint64_t bits = load(words[word]) & (~uint64_t{0} << (from & 63));
+        for (;;) {
+            if (bits) {
+                const uint32_t index = (word << 6) + static_cast<uint32_t>(std::countr_zero(bits));
+                return index < end ? index : NONE;
+            }
+            // next word that may hold bits, found through the summary
+            ++word;
+            if ((word << 6) >= end) return NONE;
+            uint32_t group = word >> 6;
+            uint64_t candidates = load(summary[group]) & (~uint64_t{0} << (word & 63));
+            while (!candidates) {
+                ++group;
+                if ((group << 12) >= end) return NONE;
+                candidates = load(summary[group]);
+            }
+            word = (group << 6) + static_cast<uint32_t>(std::countr_zero(candidates));
+            if ((word << 6) >= end) return NONE;
+            bits = load(words[word]);
+        }
+    }
+
+    /** Clears every bit, touching only words flagged in the summary */
+    void clear() {
+        for (uint32_t group = 0; group < summary.size(); ++group) {
+            uint64_t candidates = summary[group];
+            while (candidates) {
+                words[(group << 6) + std::countr_zero(candidates)] = 0;
+                candidates &= candidates - 1;
+            }
+            summary[group] = 0;
+        }
+    }
+
+private:
+    // Relaxed atomic loads compile to plain loads but keep concurrent
+    // readers of words being setConcurrent'ed well defined
+    static uint64_t load(const uint64_t& word) {
+        return std::atomic_ref<uint64_t>(const_cast<uint64_t&>(word)).load(std::memory_order_relaxed);
+    }
+
+    std::vector<uint64_t> words;
+    std::vector<uint64_t> summary;
+    uint32_t count = 0;
+};
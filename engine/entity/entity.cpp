@@ -1,37 +1,45 @@
 
 #include "entity.h"
+#include "prefab.h"
+#include "../logger.h"
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 
 
 uint32_t alignUp(uint32_t offset, size_t alignment) {
     return (offset + (alignment - 1)) & ~(alignment - 1);
 }
 
-EntityManager::EntityManager() {
+EntityManager::EntityManager(ColumnLayout vectorLayout) : vectorLayout(vectorLayout) {
     entityCount = 0;
     entityCapacity = 4194304; // preallocate for 4 million entities 2^22
     nextEntityId = 0;
     entityRecords.reserve(4194304);
-
-    // instantiate registry
-    ComponentRegistry::registerType<Position>();
-    ComponentRegistry::registerType<Velocity>();
-    ComponentRegistry::registerType<Health>();
-    ComponentRegistry::registerType<Renderable>();
-    ComponentRegistry::registerType<AI>();
-    ComponentRegistry::registerType<Gravity>();
-    ComponentRegistry::registerType<Transformable>();
 }
 
 EntityManager::~EntityManager() {
+    clear();
+}
+
+void EntityManager::clear() {
     for (auto& arch : existingArchetypes) {
         for (auto& chunk : arch->chunks) {
             chunkAllocator.deallocate(chunk->data);
             delete chunk;
         }
     }
+    existingArchetypes.clear();
+    archetypeMap.clear();
+    events.clear();
+    for (RelationStore& store : relations) {
+        store.clear();
+    }
+    entityRecords.clear();
+    freeEntityIds.clear();
+    entityCount = 0;
+    nextEntityId = 0;
 }
 
 /*
@@ -58,28 +66,96 @@ Entity_id EntityManager::createEntity(ComponentMask components) {
 
     chunk->row++; // advance row for next entity
 
+    Entity_id finalId = allocateEntityId(entityData);
+
+    // record id in chunk
+    Entity_id* ids = (Entity_id*)chunk->data;
+    ids[row] = finalId;
+
+    events.record(ComponentEvent::OnAdd, components, finalId);
+
+
+    return finalId;
+
+}
+
+/*
+ * Hands out a new or recycled id and stores the entity's location under it.
+ */
+Entity_id EntityManager::allocateEntityId(const EntityData& entityData) {
     Entity_id finalId;
     if (freeEntityIds.empty()) {
-        entityData.row = row;
-        entityRecords.push_back(entityData);
-        entityCount++;
         finalId = nextEntityId++;
+        entityRecords.push_back(entityData);
     } else {
+        // free list holds the full id of the destroyed entity
         uint32_t reusedId = freeEntityIds.back();
         freeEntityIds.pop_back();
-        entityRecords[(reusedId & BITMASK_INDEX)] = entityData;
-        finalId = reusedId & BITMASK_INDEX | // get index
-            (((reusedId & BITMASK_GENERATION) + 1) // increment generation
+        finalId = (reusedId & BITMASK_INDEX) | // get index
+            (((reusedId & BITMASK_GENERATION) + (BITMASK_INDEX + 1)) // increment generation
              & BITMASK_GENERATION); // wrap around generation
+        entityRecords[(reusedId & BITMASK_INDEX)] = entityData;
     }
+    entityRecords[finalId & BITMASK_INDEX].id = finalId;
+    entityCount++;
+    return finalId;
+}
 
-    // record id in chunk
-    Entity_id* ids = (Entity_id*)chunk->data;
-    ids[row] = finalId;
+/*
+ * Spawns `count` copies of a prefab. Rows are appended chunk by chunk and
+ * each component column is filled with one doubling memcpy pass instead of
+ * writing every component of every entity separately.
+ */
+std::uint32_t EntityManager::instantiate(const Prefab& prefab, std::uint32_t count,
+                                         std::vector<Entity_id>* outIds) {
+    Archetype* archetype = getOrCreateArchetype(prefab.getMask());
+    if (outIds) outIds->reserve(outIds->size() + count);
 
+    std::uint32_t spawned = 0;
+    while (spawned < count) {
+        Chunk* chunk = getOrCreateChunk(archetype);
+        if (!chunk) break; // out of chunk memory
 
-    return finalId;
+        const std::uint32_t firstRow = chunk->row;
+        const std::uint32_t rows = std::min(count - spawned, chunk->capacity - firstRow);
 
+        Entity_id* ids = (Entity_id*)chunk->data;
+        for (std::uint32_t i = 0; i < rows; ++i) {
+            ensureEntityCapacity();
+            EntityData entityData;
+            entityData.archetype = archetype;
+            entityData.chunk = chunk;
+            entityData.row = firstRow + i;
+            ids[firstRow + i] = allocateEntityId(entityData);
+        }
+        if (outIds) outIds->insert(outIds->end(), ids + firstRow, ids + firstRow + rows);
+        if (events.getObserved() & archetype->componentMask) {
+            for (std::uint32_t i = 0; i < rows; ++i) {
+                events.record(ComponentEvent::OnAdd, archetype->componentMask, ids[firstRow + i]);
+            }
+        }
+
+        for (int c = 0; c < 16; ++c) {
+            const size_t size = archetype->sizes[c];
+            if (size == 0) continue;
+
+            // split columns take lane k of the prefab value into stream k
+            for (std::uint8_t lane = 0; lane < archetype->lanes[c]; ++lane) {
+                std::byte* column = archetype->column(*chunk, c, lane) + firstRow * size;
+                std::memcpy(column, prefab.getComponent(c) + lane * size, size);
+                for (std::uint32_t filled = 1; filled < rows;) {
+                    const std::uint32_t copy = std::min(filled, rows - filled);
+                    std::memcpy(column + filled * size, column, copy * size);
+                    filled += copy;
+                }
+            }
+        }
+
+        chunk->row += rows;
+        spawned += rows;
+    }
+
+    return spawned;
 }
 
 /*
@@ -108,18 +184,31 @@ Archetype* EntityManager::getOrCreateArchetype(ComponentMask mask) {
     // The ID array will always be at offset 0.
     size_t bytesPerEntity = sizeof(Entity_id); 
     
+    size_t columnCount = 0;
     for (int i = 0; i < 16; ++i) {
-        if ((mask >> i) & 1) {
-            ComponentInfo info = ComponentRegistry::getInfo(i);
-            newArch->sizes[i] = info.size;
-            bytesPerEntity += info.size;
+        ComponentInfo info = ComponentRegistry::getInfo(i);
+        if (((mask >> i) & 1) && info.size > 0) {
+            columnCount++;
+            if (vectorLayout == ColumnLayout::Split && info.floatLanes > 0) {
+                newArch->sizes[i] = sizeof(float);
+                newArch->lanes[i] = info.floatLanes;
+            } else {
+                newArch->sizes[i] = info.size;
+                newArch->lanes[i] = 1;
+            }
+            bytesPerEntity += newArch->sizes[i] * newArch->lanes[i];
         } else {
+            // absent, or a tag that lives only in componentMask
             newArch->sizes[i] = 0;
+            newArch->lanes[i] = 0;
         }
     }
 
     newArch->rowSize = bytesPerEntity;
-    newArch->chunkCapacity = CHUNK_SIZE / bytesPerEntity;
+    // Reserve room for the padding needed to start every column on a
+    // COLUMN_ALIGNMENT boundary
+    size_t paddingBudget = COLUMN_ALIGNMENT * (columnCount + 1);
+    newArch->chunkCapacity = (CHUNK_SIZE - paddingBudget) / bytesPerEntity;
 
     // Calculate offsets
     // Start offsets AFTER the EntityID array
@@ -127,14 +216,26 @@ Archetype* EntityManager::getOrCreateArchetype(ComponentMask mask) {
     uint32_t currentOffset = sizeof(Entity_id) * newArch->chunkCapacity;
 
     for (int i = 0; i < 16; ++i) {
-        if ((mask >> i) & 1) {
-            // Optional: You should strictly use alignUp(currentOffset, 16) here for SIMD
+        if (newArch->lanes[i] > 0) {
+            // aligned so alignas(16) components and SIMD loads stay valid
+            currentOffset = alignUp(currentOffset, COLUMN_ALIGNMENT);
             newArch->offsets[i] = currentOffset;
-            currentOffset += newArch->sizes[i] * newArch->chunkCapacity;
+            currentOffset += newArch->sizes[i] * newArch->lanes[i] * newArch->chunkCapacity;
         } else {
             newArch->offsets[i] = 0;
         }
     }
+    newArch->layoutSize = currentOffset;
+
+    // Keep cached queries in sync so systems see archetypes created after
+    // their first lookup.
+    for (auto& [key, cached] : archetypeMap) {
+        ComponentQuery query(static_cast<ComponentMask>(key & 0xFFFF),
+                             static_cast<ComponentMask>(key >> 16));
+        if (query.matches(mask)) {
+            cached.push_back(newArch.get());
+        }
+    }
 
     existingArchetypes.push_back(std::move(newArch));
     return existingArchetypes.back().get();
@@ -174,18 +275,18 @@ void EntityManager::moveEntity(Chunk* srcChunk, uint32_t srcRow, Chunk* dstChunk
     Archetype* dstArch = dstChunk->archetype;
     uint32_t dstRow = dstChunk->row;
 
-    // 1. Copy Components
+    // 1. Copy Components (both archetypes share this manager's column layout)
     for (int i = 0; i < 16; ++i) {
         if (srcArch->sizes[i] == 0 || dstArch->sizes[i] == 0) continue;
         size_t srcSize = srcArch->sizes[i];
         size_t dstSize = dstArch->sizes[i];
         size_t copySize = std::min(srcSize, dstSize);
-        size_t srcOffset = srcArch->offsets[i];
-        size_t dstOffset = dstArch->offsets[i];
 
-        std::byte* srcPtr = (std::byte*)srcChunk->data + srcOffset + (srcRow * srcSize);
-        std::byte* dstPtr = (std::byte*)dstChunk->data + dstOffset + (dstRow * dstSize);
-        std::memcpy(dstPtr, srcPtr, copySize);
+        for (std::uint8_t lane = 0; lane < srcArch->lanes[i]; ++lane) {
+            std::byte* srcPtr = srcArch->column(*srcChunk, i, lane) + (srcRow * srcSize);
+            std::byte* dstPtr = dstArch->column(*dstChunk, i, lane) + (dstRow * dstSize);
+            std::memcpy(dstPtr, srcPtr, copySize);
+        }
     }
 
     // 2. Copy ID
@@ -246,14 +347,15 @@ Entity_id EntityManager::swapAndPopChunkRow(uint16_t rowToDelete, Chunk* chunk)
         for (int i = 0; i < 16; ++i) {
             if (arch->sizes[i] == 0) continue;
             size_t size = arch->sizes[i];
-            size_t offset = arch->offsets[i];
-
-            std::byte* data = (std::byte*)chunk->data;
-            std::memcpy(
-                data + offset + (rowToDelete * size),  // Dest
-                data + offset + (lastRowIndex * size), // Src
-                size
-            );
+
+            for (std::uint8_t lane = 0; lane < arch->lanes[i]; ++lane) {
+                std::byte* data = arch->column(*chunk, i, lane);
+                std::memcpy(
+                    data + (rowToDelete * size),  // Dest
+                    data + (lastRowIndex * size), // Src
+                    size
+                );
+            }
         }
 
         Entity_id* ids = (Entity_id*)chunk->data;
@@ -265,16 +367,38 @@ Entity_id EntityManager::swapAndPopChunkRow(uint16_t rowToDelete, Chunk* chunk)
     return movedId;
 }
 /*
- * Destroys an entity, freeing its resources and updating records.
+ * Destroys an entity together with everything it holds through a relation
+ * (children, owned entities), breadth first over the contiguous member lists.
  */
 void EntityManager::destroyEntity(Entity_id entity) {
-    uint32_t index = entity & BITMASK_INDEX;
-    if (index >= entityRecords.size()) return;
+    if (!isAlive(entity)) return;
+
+    destroyQueue.clear();
+    destroyQueue.push_back(entity);
+    for (size_t i = 0; i < destroyQueue.size(); ++i) {
+        const Entity_id current = destroyQueue[i];
+        if (!isAlive(current)) continue; // queued twice through two relations
+
+        for (RelationStore& store : relations) {
+            if (store.getPairCount() == 0) continue;
+            std::span<const Entity_id> members = store.getMembers(current);
+            destroyQueue.insert(destroyQueue.end(), members.begin(), members.end());
+            store.releaseHolder(current);
+            store.remove(current);
+        }
+        destroySingleEntity(current);
+    }
+}
 
-    EntityData& data = entityRecords[index];
+/*
+ * Frees one entity's row and record; relations are handled by the caller.
+ */
+void EntityManager::destroySingleEntity(Entity_id entity) {
+    EntityData& data = entityRecords[entity & BITMASK_INDEX];
     Chunk* chunk = data.chunk;
 
-    freeEntityIds.push_back(index);
+    events.record(ComponentEvent::OnRemove, data.archetype->componentMask, data.id);
+    freeEntityIds.push_back(data.id);
 
     Entity_id movedEntity = swapAndPopChunkRow(data.row, chunk);
 
@@ -284,24 +408,83 @@ void EntityManager::destroyEntity(Entity_id entity) {
 
     tryMergeAndFreeChunk(chunk);
 
+    data.archetype = nullptr;
+    data.chunk = nullptr;
     entityCount--;
 }
+
+bool EntityManager::isAlive(Entity_id entityId) const {
+    uint32_t index = entityId & BITMASK_INDEX;
+    if (index >= entityRecords.size()) return false;
+    const EntityData& data = entityRecords[index];
+    return data.archetype && data.id == entityId;
+}
+
+/*
+ * Relations: both ends must be alive and ChildOf/Owns chains may not loop,
+ * otherwise cascading destroys would never terminate.
+ */
+bool EntityManager::addRelation(Relation relation, Entity_id holder, Entity_id member) {
+    if (!isAlive(holder) || !isAlive(member) || holder == member) return false;
+
+    RelationStore& store = relations[static_cast<size_t>(relation)];
+    for (Entity_id up = store.getHolder(holder); up != NULL_ENTITY; up = store.getHolder(up)) {
+        if (up == member) return false; // member is an ancestor of holder
+    }
+    store.add(holder, member);
+    return true;
+}
+
+void EntityManager::removeRelation(Relation relation, Entity_id member) {
+    if (!isAlive(member)) return;
+    relations[static_cast<size_t>(relation)].remove(member);
+}
+
+Entity_id EntityManager::getRelationHolder(Relation relation, Entity_id member) const {
+    if (!isAlive(member)) return NULL_ENTITY;
+    return relations[static_cast<size_t>(relation)].getHolder(member);
+}
+
+std::span<const Entity_id> EntityManager::getRelationMembers(Relation relation, Entity_id holder) const {
+    if (!isAlive(holder)) return {};
+    return relations[static_cast<size_t>(relation)].getMembers(holder);
+}
+
+/*
+ * Appends every transitive member of root, level by level: all children,
+ * then all grandchildren, and so on. Each level is a run of linear copies.
+ */
+void EntityManager::getDescendants(Relation relation, Entity_id root, std::vector<Entity_id>& out) const {
+    if (!isAlive(root)) return;
+    const RelationStore& store = relations[static_cast<size_t>(relation)];
+
+    size_t next = out.size();
+    std::span<const Entity_id> members = store.getMembers(root);
+    out.insert(out.end(), members.begin(), members.end());
+    for (; next < out.size(); ++next) {
+        members = store.getMembers(out[next]);
+        out.insert(out.end(), members.begin(), members.end());
+    }
+}
 /*
  * Returns pointer to component data for given entity and component type.
  * Returns nullptr if entity does not have the component
 */
 void* EntityManager::getComponentData(Entity_id entityId, ComponentMask component) {
     uint32_t index = entityId & BITMASK_INDEX;
-    if (index >= entityRecords.size()) return nullptr;
+    if (index >= entityRecords.size() || entityRecords[index].id != entityId) return nullptr;
 
     EntityData& data = entityRecords[index];
     Archetype* arch = data.archetype;
 
-    if ((arch->componentMask & component) == 0) {
+    if (!arch || (arch->componentMask & component) == 0) {
         return nullptr; // Component not present
     }
 
     uint8_t componentIndex = componentMaskToIndex(component);
+    if (arch->lanes[componentIndex] != 1) {
+        return nullptr; // Split into streams, no contiguous struct to point at
+    }
     size_t size = arch->sizes[componentIndex];
     size_t offset = arch->offsets[componentIndex];
 
@@ -309,36 +492,100 @@ void* EntityManager::getComponentData(Entity_id entityId, ComponentMask componen
     return basePtr + offset + (data.row * size);
 }
 
+bool EntityManager::hasComponent(Entity_id entityId, ComponentMask components) const {
+    uint32_t index = entityId & BITMASK_INDEX;
+    if (index >= entityRecords.size() || entityRecords[index].id != entityId) return false;
+
+    const Archetype* arch = entityRecords[index].archetype;
+    return arch && (arch->componentMask & components) == components;
+}
+
 /*
- * Adds a component to an entity, moving it to a new archetype if necessary.
+ * Copies a component into `out` (sizeof the component struct). Split columns
+ * are gathered lane by lane; lanes the layout drops are zeroed.
  */
-void EntityManager::addComponent(Entity_id entityId, ComponentMask component) {
+bool EntityManager::readComponent(Entity_id entityId, ComponentMask component, void* out) {
     uint32_t index = entityId & BITMASK_INDEX;
-    if (index >= entityRecords.size()) return;
+    if (index >= entityRecords.size() || entityRecords[index].id != entityId) return false;
 
     EntityData& data = entityRecords[index];
-    ComponentMask newMask = data.archetype->componentMask | component;
+    Archetype* arch = data.archetype;
+    if (!arch || (arch->componentMask & component) == 0) return false;
 
-    if (newMask == data.archetype->componentMask) {
-        return; // Already has component
+    uint8_t componentIndex = componentMaskToIndex(component);
+    size_t size = arch->sizes[componentIndex];
+    std::byte* dst = static_cast<std::byte*>(out);
+    std::memset(dst, 0, ComponentRegistry::getInfo(componentIndex).size);
+    for (std::uint8_t lane = 0; lane < arch->lanes[componentIndex]; ++lane) {
+        std::memcpy(dst + lane * size,
+                    arch->column(*data.chunk, componentIndex, lane) + data.row * size, size);
+    }
+    return true;
+}
+
+bool EntityManager::writeComponent(Entity_id entityId, ComponentMask component, const void* value) {
+    uint32_t index = entityId & BITMASK_INDEX;
+    if (index >= entityRecords.size() || entityRecords[index].id != entityId) return false;
+
+    EntityData& data = entityRecords[index];
+    Archetype* arch = data.archetype;
+    if (!arch || (arch->componentMask & component) == 0) return false;
+
+    uint8_t componentIndex = componentMaskToIndex(component);
+    size_t size = arch->sizes[componentIndex];
+    const std::byte* src = static_cast<const std::byte*>(value);
+    for (std::uint8_t lane = 0; lane < arch->lanes[componentIndex]; ++lane) {
+        std::memcpy(arch->column(*data.chunk, componentIndex, lane) + data.row * size,
+                    src + lane * size, size);
     }
+    events.record(ComponentEvent::OnSet, component, entityId);
+    return true;
+}
 
+/*
+ * Moves an entity into the archetype for newMask, closing the hole it leaves
+ * behind in its old chunk.
+ */
+void EntityManager::migrateEntity(EntityData& data, ComponentMask newMask) {
     Archetype* newArchetype = getOrCreateArchetype(newMask);
     Chunk* newChunk = getOrCreateChunk(newArchetype);
     if (!newChunk) return; // Allocation failed
 
-    moveEntity(data.chunk, data.row, newChunk);
+    const ComponentMask oldMask = data.archetype->componentMask;
+    events.record(ComponentEvent::OnAdd, newMask & ~oldMask, data.id);
+    events.record(ComponentEvent::OnRemove, oldMask & ~newMask, data.id);
+
+    // moveEntity rewrites the record, so remember where the entity came from
+    Chunk* srcChunk = data.chunk;
+    uint32_t srcRow = data.row;
 
-    Entity_id movedEntity = swapAndPopChunkRow(data.row, data.chunk);
+    moveEntity(srcChunk, srcRow, newChunk);
+    data.archetype = newArchetype;
+
+    Entity_id movedEntity = swapAndPopChunkRow(srcRow, srcChunk);
     if (movedEntity != NULL_ENTITY) {
-        entityRecords[movedEntity & BITMASK_INDEX].row = data.row;
+        entityRecords[movedEntity & BITMASK_INDEX].row = srcRow;
     }
 
-    tryMergeAndFreeChunk(data.chunk);
+    tryMergeAndFreeChunk(srcChunk);
+}
 
-    data.archetype = newArchetype;
-    data.chunk = newChunk;
-    data.row = newChunk->row - 1; // Last added row
+/*
+ * Adds a component to an entity, moving it to a new archetype if necessary.
+ */
+void EntityManager::addComponent(Entity_id entityId, ComponentMask component) {
+    uint32_t index = entityId & BITMASK_INDEX;
+    if (index >= entityRecords.size() || entityRecords[index].id != entityId) return;
+
+    EntityData& data = entityRecords[index];
+    if (!data.archetype) return;
+    ComponentMask newMask = data.archetype->componentMask | component;
+
+    if (newMask == data.archetype->componentMask) {
+        return; // Already has component
+    }
+
+    migrateEntity(data, newMask);
 }
 
 /*
@@ -346,41 +593,30 @@ void EntityManager::addComponent(Entity_id entityId, ComponentMask component) {
 */
 void EntityManager::removeComponent(Entity_id entityId, ComponentMask component) {
     uint32_t index = entityId & BITMASK_INDEX;
-    if (index >= entityRecords.size()) return;
+    if (index >= entityRecords.size() || entityRecords[index].id != entityId) return;
 
     EntityData& data = entityRecords[index];
+    if (!data.archetype) return;
     ComponentMask newMask = data.archetype->componentMask & ~component;
 
     if (newMask == data.archetype->componentMask) {
         return; // Component not present
     }
 
-    Archetype* newArchetype = getOrCreateArchetype(newMask);
-    Chunk* newChunk = getOrCreateChunk(newArchetype);
-    if (!newChunk) return; // Allocation failed
-
-    moveEntity(data.chunk, data.row, newChunk);
-
-    Entity_id movedEntity = swapAndPopChunkRow(data.row, data.chunk);
-    if (movedEntity != NULL_ENTITY) {
-        entityRecords[movedEntity & BITMASK_INDEX].row = data.row;
-    }
-
-    tryMergeAndFreeChunk(data.chunk);
-
-    data.archetype = newArchetype;
-    data.chunk = newChunk;
-    data.row = newChunk->row - 1; // Last added row
+    migrateEntity(data, newMask);
 }
 
-std::vector<Entity_id> EntityManager::getAllEntitiesWithComponents(ComponentMask components) {
+/*
+ * Collects the ids of every entity matching the query by walking the id
+ * columns of matching archetypes; non-matching archetypes are never touched.
+ */
+std::vector<Entity_id> EntityManager::getAllEntitiesWithComponents(ComponentQuery query) {
     std::vector<Entity_id> result;
 
-    for (const auto& entityData : entityRecords) {
-        if (entityData.archetype && 
-            (entityData.archetype->componentMask & components) == components) {
-            Entity_id* ids = (Entity_id*)entityData.chunk->data;
-            result.push_back(ids[entityData.row]);
+    for (const Archetype* arch : getArchetypes(query)) {
+        for (const Chunk* chunk : arch->chunks) {
+            const Entity_id* ids = (const Entity_id*)chunk->data;
+            result.insert(result.end(), ids, ids + chunk->row);
         }
     }
 
@@ -388,18 +624,74 @@ std::vector<Entity_id> EntityManager::getAllEntitiesWithComponents(ComponentMask
 }
 
 std::vector<Archetype*>& EntityManager::getAllArchetypesWithComponent(ComponentMask component) {
+    return getArchetypes(ComponentQuery(component));
+}
 
-    auto it = archetypeMap.find(component);
+std::vector<Archetype*>& EntityManager::getArchetypes(ComponentQuery query) {
+    auto it = archetypeMap.find(query.key());
     if (it != archetypeMap.end()) {
         return it->second;
     }
-    
+
     std::vector<Archetype*> result;
     for (const auto& archPtr : existingArchetypes) {
-        if ((archPtr->componentMask & component) == component) {
+        if (query.matches(archPtr->componentMask)) {
             result.push_back(archPtr.get());
         }
     }
 
-    return archetypeMap.emplace(component, result).first->second;
+    return archetypeMap.emplace(query.key(), result).first->second;
+}
+
+/*
+ * Walks every archetype's chunk list. Cheap enough to call every few seconds
+ * but not meant for per-frame use.
+ */
+EcsMemoryStats EntityManager::getMemoryStats() const {
+    EcsMemoryStats stats;
+    stats.entityCount = entityCount;
+    stats.entityRecordBytes = entityRecords.capacity() * sizeof(EntityData);
+
+    const PoolAllocator::Stats& pool = chunkAllocator.getStats();
+    stats.chunkBytesReserved = pool.totalBlocks * pool.blockSize;
+    stats.chunkBytesInUse = pool.usedBlocks * pool.blockSize;
+    stats.peakChunkBytesInUse = pool.peakUsedBlocks * pool.blockSize;
+
+    size_t totalRows = 0;
+    size_t totalEntities = 0;
+    for (const auto& arch : existingArchetypes) {
+        ArchetypeMemoryStats a;
+        a.componentMask = arch->componentMask;
+        a.chunkCount = static_cast<std::uint32_t>(arch->chunks.size());
+        a.chunkCapacity = arch->chunkCapacity;
+        a.bytesPerRow = arch->rowSize;
+        for (const Chunk* chunk : arch->chunks) {
+            a.entityCount += chunk->row;
+        }
+
+        const size_t rows = size_t(a.chunkCount) * a.chunkCapacity;
+        a.usedBytes = a.entityCount * a.bytesPerRow;
+        a.freeRowBytes = (rows - a.entityCount) * a.bytesPerRow;
+        a.wastedTailBytes = a.chunkCount * (CHUNK_SIZE - arch->layoutSize);
+        a.occupancy = rows ? float(a.entityCount) / float(rows) : 0.0f;
+
+        totalRows += rows;
+        totalEntities += a.entityCount;
+        stats.archetypes.push_back(a);
+    }
+    stats.occupancy = totalRows ? float(totalEntities) / float(totalRows) : 0.0f;
+    return stats;
+}
+
+void EntityManager::logMemoryStats() const {
+    const EcsMemoryStats stats = getMemoryStats();
+    LOG_INFO("ECS", "{} entities, chunks {} KB in use / {} KB reserved (peak {} KB), occupancy {:.1f}%",
+             stats.entityCount, stats.chunkBytesInUse / 1024, stats.chunkBytesReserved / 1024,
+             stats.peakChunkBytesInUse / 1024, stats.occupancy * 100.0f);
+    for ([[maybe_unused]] const ArchetypeMemoryStats& a : stats.archetypes) {
+        LOG_INFO("ECS", "  mask {:#06x}: {} entities in {} chunks ({:.1f}%), {} B/row, "
+                 "{} B free rows, {} B wasted tail",
+                 a.componentMask, a.entityCount, a.chunkCount, a.occupancy * 100.0f,
+                 a.bytesPerRow, a.freeRowBytes, a.wastedTailBytes);
+    }
 }
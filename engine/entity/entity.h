@@ -1,8 +1,13 @@
 #pragma once
 #include "../math/vector.hpp"
 #include "../memory/pool_allocator.h"
+#include "component_events.h"
+#include "relations.h"
 #include <cstdint>
+#include <memory>
+#include <span>
 #include <sys/types.h>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
@@ -41,12 +46,41 @@ struct Entity {
   Entity_id id;
 };
 
+/*
+ * Archetype filter: entities that have every component in `with` and none in
+ * `without`. Matching is decided per archetype, so excluded entities cost
+ * nothing to skip. Converts implicitly from a plain ComponentMask.
+ */
+struct ComponentQuery {
+  ComponentMask with = 0;
+  ComponentMask without = 0;
+
+  ComponentQuery(ComponentMask with = 0, ComponentMask without = 0)
+      : with(with), without(without) {}
+
+  bool matches(ComponentMask mask) const {
+    return (mask & with) == with && (mask & without) == 0;
+  }
+  std::uint32_t key() const { return (std::uint32_t(without) << 16) | with; }
+};
+
 struct ComponentInfo {
-  std::size_t size;
+  std::size_t size; // 0 for tag components, which only exist in the mask
   std::size_t offset;
+  std::uint8_t floatLanes = 0; // >0: may be stored as this many float streams
 };
 
+/*
+ * How float-vector components (those with ComponentInfo::floatLanes) are laid
+ * out in chunks. Interleaved keeps the AoS struct per row; Split stores one
+ * float stream per lane (x[], y[], z[]) and drops the padding lane, so those
+ * components are reached through chunk views or read/writeComponent rather
+ * than getComponentData.
+ */
+enum class ColumnLayout : std::uint8_t { Interleaved, Split };
+
 struct Archetype;
+class Prefab;
 
 struct Chunk {
   void *data;
@@ -62,10 +96,35 @@ struct Archetype {
   std::uint32_t chunkCapacity;
   std::vector<Chunk *> chunks;
   std::size_t rowSize;
+  std::size_t layoutSize; // bytes of a chunk covered by its columns when full
   std::uint32_t offsets[sizeof(ComponentMask) * 8];
-  std::size_t sizes[sizeof(ComponentMask) * 8];
+  std::size_t sizes[sizeof(ComponentMask) * 8]; // bytes per row in one lane
+  std::uint8_t lanes[sizeof(ComponentMask) * 8]; // 1 interleaved, >1 split, 0 absent or tag
+
+  /** Start of one lane of a component column inside a chunk */
+  std::byte *column(const Chunk &chunk, std::uint8_t index,
+                    std::uint8_t lane = 0) const {
+    return static_cast<std::byte *>(chunk.data) + offsets[index] +
+           std::size_t(lane) * chunkCapacity * sizes[index];
+  }
+};
+
+/** SoA view over a split 3-lane component column of one chunk */
+struct Vector3Streams {
+  float *x;
+  float *y;
+  float *z;
 };
 
+inline Vector3Streams getVector3Streams(const Archetype &archetype,
+                                        const Chunk &chunk,
+                                        ComponentMask component) {
+  const uint8_t index = componentMaskToIndex(component);
+  return {reinterpret_cast<float *>(archetype.column(chunk, index, 0)),
+          reinterpret_cast<float *>(archetype.column(chunk, index, 1)),
+          reinterpret_cast<float *>(archetype.column(chunk, index, 2))};
+}
+
 struct EntityData {
   Archetype *archetype = nullptr;
   std::uint32_t row;
@@ -100,24 +159,110 @@ struct alignas(4) Transformable {
   Transform_id handle;
 };
 
+/** Memory use of one archetype's chunks */
+struct ArchetypeMemoryStats {
+  ComponentMask componentMask = 0;
+  std::uint32_t chunkCount = 0;
+  std::uint32_t entityCount = 0;
+  std::uint32_t chunkCapacity = 0; // rows per chunk
+  std::size_t bytesPerRow = 0;     // id plus every component column
+  std::size_t usedBytes = 0;       // entityCount * bytesPerRow
+  std::size_t freeRowBytes = 0;    // empty rows in partially filled chunks
+  std::size_t wastedTailBytes = 0; // chunk bytes past the last column
+  float occupancy = 0.0f;          // entityCount / (chunkCount * chunkCapacity)
+};
+
+struct EcsMemoryStats {
+  std::vector<ArchetypeMemoryStats> archetypes;
+  std::uint32_t entityCount = 0;
+  std::size_t chunkBytesReserved = 0; // chunk pool slabs, used or not
+  std::size_t chunkBytesInUse = 0;    // chunks owned by archetypes
+  std::size_t peakChunkBytesInUse = 0;
+  std::size_t entityRecordBytes = 0;
+  float occupancy = 0.0f; // over all chunks in use
+};
+
 class EntityManager {
 public:
-  EntityManager();
+  explicit EntityManager(ColumnLayout vectorLayout = ColumnLayout::Interleaved);
   ~EntityManager();
   Entity_id createEntity(ComponentMask components);
+  /** Spawns `count` copies of a prefab, filling chunk columns in bulk.
+   * Returns how many were created; ids are appended to outIds if given */
+  std::uint32_t instantiate(const Prefab &prefab, std::uint32_t count,
+                            std::vector<Entity_id> *outIds = nullptr);
+  /** Destroys the entity and, recursively, everything it holds through a
+   * relation (children, owned entities) */
   void destroyEntity(Entity_id entityId);
+  /** False for destroyed ids, including stale ids whose index was reused */
+  bool isAlive(Entity_id entityId) const;
+  /** Pointer to the component in its chunk; nullptr if absent, a tag or stored split */
   void *getComponentData(Entity_id entityId, ComponentMask component);
+  /** True if the entity has every component in the mask (works for tags) */
+  bool hasComponent(Entity_id entityId, ComponentMask components) const;
+  /** Copy a component out of / into its chunk; works for every column layout */
+  bool readComponent(Entity_id entityId, ComponentMask component, void *out);
+  bool writeComponent(Entity_id entityId, ComponentMask component,
+                      const void *value);
+  ColumnLayout getVectorLayout() const { return vectorLayout; }
+  /** Add/remove/set streams for observed components; writeComponent and
+   * structural changes feed it, direct pointer writes use markComponentSet */
+  ComponentEventStream &getEvents() { return events; }
+  /** Records OnSet for components modified through getComponentData or
+   * chunk columns. Safe to call from jobs */
+  void markComponentSet(Entity_id entityId, ComponentMask components) {
+    events.record(ComponentEvent::OnSet, components, entityId);
+  }
+  /** Chunk usage per archetype and for the whole world */
+  EcsMemoryStats getMemoryStats() const;
+  /** Logs getMemoryStats(), one line per archetype */
+  void logMemoryStats() const;
   void addComponent(Entity_id entityId, ComponentMask component);
   void removeComponent(Entity_id entityId, ComponentMask component);
-  std::vector<Entity_id> getAllEntitiesWithComponents(ComponentMask components);
+  std::vector<Entity_id> getAllEntitiesWithComponents(ComponentQuery query);
+
+  /** Makes member belong to holder (child to parent, item to owner),
+   * replacing its previous holder. Fails on dead ids and on cycles */
+  bool addRelation(Relation relation, Entity_id holder, Entity_id member);
+  void removeRelation(Relation relation, Entity_id member);
+  /** NULL_ENTITY if member has no holder */
+  Entity_id getRelationHolder(Relation relation, Entity_id member) const;
+  /** Contiguous member list; invalidated by relation changes and destroys */
+  std::span<const Entity_id> getRelationMembers(Relation relation,
+                                                Entity_id holder) const;
+  /** Appends all transitive members of root to out, level by level */
+  void getDescendants(Relation relation, Entity_id root,
+                      std::vector<Entity_id> &out) const;
+  bool setParent(Entity_id child, Entity_id parent) {
+    return addRelation(Relation::ChildOf, parent, child);
+  }
+  Entity_id getParent(Entity_id child) const {
+    return getRelationHolder(Relation::ChildOf, child);
+  }
+  std::span<const Entity_id> getChildren(Entity_id parent) const {
+    return getRelationMembers(Relation::ChildOf, parent);
+  }
   std::vector<Archetype *> &
   getAllArchetypesWithComponent(ComponentMask component);
+  /** Cached list of archetypes matching the query, kept up to date as
+   * archetypes are created */
+  std::vector<Archetype *> &getArchetypes(ComponentQuery query);
+  /** Destroys every entity and releases all chunks and archetypes */
+  void clear();
 
 private:
-  std::unordered_map<ComponentMask, std::vector<Archetype *>> archetypeMap;
+  friend class WorldSnapshot;
+
+  std::unordered_map<std::uint32_t, std::vector<Archetype *>>
+      archetypeMap; // keyed by ComponentQuery::key()
+  ColumnLayout vectorLayout;
   static constexpr std::size_t CHUNK_SIZE = 16 * 1024; // 16 KB
+  static constexpr std::size_t COLUMN_ALIGNMENT = 16;   // start of each column
   std::vector<EntityData> entityRecords;
-  std::vector<uint32_t> freeEntityIds;
+  std::vector<uint32_t> freeEntityIds; // full ids, generation bumped on reuse
+  RelationStore relations[static_cast<std::size_t>(Relation::Count)];
+  std::vector<Entity_id> destroyQueue; // cascade scratch, kept to avoid reallocating
+  ComponentEventStream events;
   std::uint32_t entityCount;
   std::uint32_t entityCapacity;
   std::vector<std::unique_ptr<Archetype>>
@@ -126,26 +271,44 @@ private:
   std::vector<Chunk> chunks; // pointer to array of chunks
   Entity_id nextEntityId;
   void ensureEntityCapacity();
+  void destroySingleEntity(Entity_id entityId);
+  Entity_id allocateEntityId(const EntityData &entityData);
   Archetype *getOrCreateArchetype(ComponentMask components);
   Entity_id swapAndPopChunkRow(uint16_t row, Chunk *chunk);
   void tryMergeAndFreeChunk(Chunk *chunk);
   void moveEntity(Chunk *srcChunk, uint32_t srcRow, Chunk *dstChunk);
+  void migrateEntity(EntityData &data, ComponentMask newMask);
   Chunk *getOrCreateChunk(Archetype *archetype);
-  PoolAllocator chunkMetadata{sizeof(Chunk), 256};
-  PoolAllocator chunkAllocator{CHUNK_SIZE, 1024};
+  PoolAllocator chunkMetadata{sizeof(Chunk), 256, PoolAllocator::Fixed, MemoryTag::ECS};
+  // grows one 1 MB slab at a time; chunks are never moved once handed out
+  PoolAllocator chunkAllocator{CHUNK_SIZE, 64, PoolAllocator::Growable, MemoryTag::ECS};
 };
 
 class ComponentRegistry {
 public:
   static std::vector<ComponentInfo> &getRegistry() {
-    static std::vector<ComponentInfo> registry;
+    static std::vector<ComponentInfo> registry = builtinTypes();
     return registry;
   }
 
+  // Built-in components, indexed by their bit in Components::
+  static std::vector<ComponentInfo> builtinTypes() {
+    return {
+        {sizeof(Position), alignof(Position), 3}, // w is padding
+        {sizeof(Velocity), alignof(Velocity), 3},
+        {sizeof(Health), alignof(Health)},
+        {sizeof(Renderable), alignof(Renderable)},
+        {sizeof(AI), alignof(AI)},
+        {0, alignof(Gravity)}, // tag
+        {sizeof(Transformable), alignof(Transformable)},
+    };
+  }
+
   template <typename T> static uint8_t registerType() {
     auto &registry = getRegistry();
     uint8_t id = static_cast<uint8_t>(registry.size());
-    registry.push_back({sizeof(T), alignof(T)});
+    // empty structs are tags: they get a mask bit but no column
+    registry.push_back({std::is_empty_v<T> ? 0 : sizeof(T), alignof(T), 0});
     return id;
   }
 
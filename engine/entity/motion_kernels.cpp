@@ -0,0 +1,176 @@
+#include "motion_kernels.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define MOTION_KERNELS_X86 1
+#include <immintrin.h>
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+// Contraction into FMA would make the backends disagree in the last bit.
+// GCC ignores the pragma, so CMake also passes -ffp-contract=off for this file.
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#endif
+
+constexpr float GRAVITY_ACCELERATION = 9.81f;
+
+namespace {
+
+void gravityInterleavedScalar(Position* positions, Velocity* velocities,
+                              uint32_t count, float deltaTime) {
+    const float dv = GRAVITY_ACCELERATION * deltaTime;
+    for (uint32_t i = 0; i < count; ++i) {
+        mathplease::Vector4& pos = positions[i].value;
+        mathplease::Vector4& vel = velocities[i].value;
+
+        vel.y -= dv;
+
+        pos.x += vel.x * deltaTime;
+        pos.y += vel.y * deltaTime;
+        pos.z += vel.z * deltaTime;
+    }
+}
+
+void gravitySplitScalar(Vector3Streams pos, Vector3Streams vel, uint32_t count, float deltaTime) {
+    const float dv = GRAVITY_ACCELERATION * deltaTime;
+    for (uint32_t i = 0; i < count; ++i) {
+        vel.y[i] -= dv;
+        pos.x[i] += vel.x[i] * deltaTime;
+        pos.y[i] += vel.y[i] * deltaTime;
+        pos.z[i] += vel.z[i] * deltaTime;
+    }
+}
+
+#if MOTION_KERNELS_X86
+
+/*
+ * AoS: one Vector4 per SSE register. Only y gets the velocity change
+ * (x - 0.0f is exact) and the w lane of the position is masked back in,
+ * because w + 0*w is not an identity for -0, inf or NaN.
+ */
+void gravityInterleavedSSE(Position* positions, Velocity* velocities,
+                           uint32_t count, float deltaTime) {
+    const float dv = GRAVITY_ACCELERATION * deltaTime;
+    const __m128 dvv = _mm_setr_ps(0.0f, dv, 0.0f, 0.0f);
+    const __m128 dtv = _mm_set1_ps(deltaTime);
+    const __m128 xyzMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+    float* p = reinterpret_cast<float*>(positions);
+    float* v = reinterpret_cast<float*>(velocities);
+
+    for (uint32_t i = 0; i < count; ++i, p += 4, v += 4) {
+        const __m128 vel = _mm_sub_ps(_mm_load_ps(v), dvv);
+        const __m128 pos = _mm_load_ps(p);
+        const __m128 moved = _mm_add_ps(pos, _mm_mul_ps(vel, dtv));
+        _mm_store_ps(v, vel);
+        _mm_store_ps(p, _mm_or_ps(_mm_and_ps(xyzMask, moved), _mm_andnot_ps(xyzMask, pos)));
+    }
+}
+
+void gravitySplitSSE(Vector3Streams pos, Vector3Streams vel, uint32_t count, float deltaTime) {
+    const float dv = GRAVITY_ACCELERATION * deltaTime;
+    const __m128 dtv = _mm_set1_ps(deltaTime);
+    const __m128 dvv = _mm_set1_ps(dv);
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 vy = _mm_sub_ps(_mm_loadu_ps(vel.y + i), dvv);
+        _mm_storeu_ps(vel.y + i, vy);
+        _mm_storeu_ps(pos.x + i, _mm_add_ps(_mm_loadu_ps(pos.x + i), _mm_mul_ps(_mm_loadu_ps(vel.x + i), dtv)));
+        _mm_storeu_ps(pos.y + i, _mm_add_ps(_mm_loadu_ps(pos.y + i), _mm_mul_ps(vy, dtv)));
+        _mm_storeu_ps(pos.z + i, _mm_add_ps(_mm_loadu_ps(pos.z + i), _mm_mul_ps(_mm_loadu_ps(vel.z + i), dtv)));
+    }
+    gravitySplitScalar({pos.x + i, pos.y + i, pos.z + i}, {vel.x + i, vel.y + i, vel.z + i},
+                       count - i, deltaTime);
+}
+
+// AoS with two entities per 256-bit register
+TARGET_AVX2 void gravityInterleavedAVX2(Position* positions, Velocity* velocities,
+                                        uint32_t count, float deltaTime) {
+    const float dv = GRAVITY_ACCELERATION * deltaTime;
+    const __m256 dvv = _mm256_setr_ps(0.0f, dv, 0.0f, 0.0f, 0.0f, dv, 0.0f, 0.0f);
+    const __m256 dtv = _mm256_set1_ps(deltaTime);
+    float* p = reinterpret_cast<float*>(positions);
+    float* v = reinterpret_cast<float*>(velocities);
+
+    uint32_t i = 0;
+    for (; i + 2 <= count; i += 2, p += 8, v += 8) {
+        const __m256 vel = _mm256_sub_ps(_mm256_loadu_ps(v), dvv);
+        const __m256 pos = _mm256_loadu_ps(p);
+        const __m256 moved = _mm256_add_ps(pos, _mm256_mul_ps(vel, dtv));
+        _mm256_storeu_ps(v, vel);
+        _mm256_storeu_ps(p, _mm256_blend_ps(moved, pos, 0x88));
+    }
+    gravityInterleavedSSE(positions + i, velocities + i, count - i, deltaTime);
+}
+
+TARGET_AVX2 void gravitySplitAVX2(Vector3Streams pos, Vector3Streams vel, uint32_t count, float deltaTime) {
+    const float dv = GRAVITY_ACCELERATION * deltaTime;
+    const __m256 dtv = _mm256_set1_ps(deltaTime);
+    const __m256 dvv = _mm256_set1_ps(dv);
+    uint32_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 vy = _mm256_sub_ps(_mm256_loadu_ps(vel.y + i), dvv);
+        _mm256_storeu_ps(vel.y + i, vy);
+        _mm256_storeu_ps(pos.x + i, _mm256_add_ps(_mm256_loadu_ps(pos.x + i),
+                                                  _mm256_mul_ps(_mm256_loadu_ps(vel.x + i), dtv)));
+        _mm256_storeu_ps(pos.y + i, _mm256_add_ps(_mm256_loadu_ps(pos.y + i), _mm256_mul_ps(vy, dtv)));
+        _mm256_storeu_ps(pos.z + i, _mm256_add_ps(_mm256_loadu_ps(pos.z + i),
+                                                  _mm256_mul_ps(_mm256_loadu_ps(vel.z + i), dtv)));
+    }
+    gravitySplitSSE({pos.x + i, pos.y + i, pos.z + i}, {vel.x + i, vel.y + i, vel.z + i},
+                    count - i, deltaTime);
+}
+
+#endif // MOTION_KERNELS_X86
+
+const GravityKernels SCALAR_KERNELS = {gravityInterleavedScalar, gravitySplitScalar};
+#if MOTION_KERNELS_X86
+const GravityKernels SSE_KERNELS = {gravityInterleavedSSE, gravitySplitSSE};
+const GravityKernels AVX2_KERNELS = {gravityInterleavedAVX2, gravitySplitAVX2};
+#endif
+
+} // namespace
+
+const char* kernelBackendName(KernelBackend backend) {
+    switch (backend) {
+        case KernelBackend::Scalar: return "scalar";
+        case KernelBackend::SSE: return "sse";
+        case KernelBackend::AVX2: return "avx2";
+    }
+    return "unknown";
+}
+
+bool isKernelBackendSupported(KernelBackend backend) {
+    switch (backend) {
+        case KernelBackend::Scalar: return true;
+#if MOTION_KERNELS_X86
+        case KernelBackend::SSE: return __builtin_cpu_supports("sse2");
+        case KernelBackend::AVX2: return __builtin_cpu_supports("avx2");
+#endif
+        default: return false;
+    }
+}
+
+KernelBackend detectKernelBackend() {
+    static const KernelBackend detected = [] {
+        if (isKernelBackendSupported(KernelBackend::AVX2)) return KernelBackend::AVX2;
+        if (isKernelBackendSupported(KernelBackend::SSE)) return KernelBackend::SSE;
+        return KernelBackend::Scalar;
+    }();
+    return detected;
+}
+
+const GravityKernels& getGravityKernels(KernelBackend backend) {
+    if (!isKernelBackendSupported(backend)) return SCALAR_KERNELS;
+    switch (backend) {
+#if MOTION_KERNELS_X86
+        case KernelBackend::SSE: return SSE_KERNELS;
+        case KernelBackend::AVX2: return AVX2_KERNELS;
+#endif
+        default: return SCALAR_KERNELS;
+    }
+}
+
+const GravityKernels& getGravityKernels() {
+    static const GravityKernels& active = getGravityKernels(detectKernelBackend());
+    return active;
+}
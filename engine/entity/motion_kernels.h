@@ -0,0 +1,29 @@
+#pragma once
+
+#include "entity.h"
+#include <cstdint>
+
+/*
+ * Integration kernels for the built-in motion systems. Each backend is an
+ * explicitly vectorised version of the scalar loop and produces bit-identical
+ * results (same operation order, no fused multiply-add), so the backend can
+ * be chosen at runtime from the CPU without changing simulation output.
+ */
+enum class KernelBackend : uint8_t { Scalar, SSE, AVX2 };
+
+struct GravityKernels {
+    /** AoS Vector4 columns; w lanes are left untouched */
+    void (*interleaved)(Position* positions, Velocity* velocities, uint32_t count, float deltaTime);
+    /** SoA x/y/z float streams */
+    void (*split)(Vector3Streams positions, Vector3Streams velocities, uint32_t count, float deltaTime);
+};
+
+const char* kernelBackendName(KernelBackend backend);
+bool isKernelBackendSupported(KernelBackend backend);
+/** Widest backend the running CPU supports (detected once) */
+KernelBackend detectKernelBackend();
+
+/** Kernels for a specific backend; unsupported backends fall back to scalar */
+const GravityKernels& getGravityKernels(KernelBackend backend);
+/** Kernels for detectKernelBackend(), what GravitySystem uses */
+const GravityKernels& getGravityKernels();
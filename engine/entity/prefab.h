@@ -0,0 +1,43 @@
+#pragma once
+
+#include "entity.h"
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+/*
+ * Template entity for bulk spawning: one pre-laid-out value per component in
+ * the mask, zero-initialised until set. EntityManager::instantiate copies it
+ * into chunk columns without going through per-entity getComponentData.
+ */
+class Prefab {
+public:
+    explicit Prefab(ComponentMask mask) : mask(mask) {
+        std::size_t rowSize = 0;
+        for (int i = 0; i < 16; ++i) {
+            offsets[i] = rowSize;
+            if ((mask >> i) & 1) {
+                rowSize += ComponentRegistry::getInfo(i).size;
+            }
+        }
+        row.resize(rowSize);
+    }
+
+    // false, leaving the row unchanged, if the component is not in the mask
+    // or T is not the size registered for it
+    template <typename T>
+    bool set(ComponentMask component, const T& value) {
+        const std::uint8_t index = componentMaskToIndex(component);
+        if (!(mask & component) || sizeof(T) != ComponentRegistry::getInfo(index).size) return false;
+        std::memcpy(row.data() + offsets[index], &value, sizeof(T));
+        return true;
+    }
+
+    ComponentMask getMask() const { return mask; }
+    const std::byte* getComponent(std::uint8_t index) const { return row.data() + offsets[index]; }
+
+private:
+    ComponentMask mask;
+    std::size_t offsets[sizeof(ComponentMask) * 8];
+    std::vector<std::byte> row;
+};
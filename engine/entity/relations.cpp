@@ -0,0 +1,84 @@
+#include "relations.h"
+#include "entity.h"
+#include <algorithm>
+
+void RelationStore::growTo(std::uint32_t index) {
+    if (index >= links.size()) {
+        links.resize(index + 1, Link{NULL_ENTITY, 0});
+        listOf.resize(index + 1, NO_LIST);
+    }
+}
+
+void RelationStore::add(Entity_id holder, Entity_id member) {
+    const std::uint32_t holderIndex = holder & BITMASK_INDEX;
+    const std::uint32_t memberIndex = member & BITMASK_INDEX;
+    growTo(std::max(holderIndex, memberIndex));
+
+    remove(member);
+
+    std::uint32_t list = listOf[holderIndex];
+    if (list == NO_LIST) {
+        list = static_cast<std::uint32_t>(lists.size());
+        lists.push_back({holder, {}});
+        listOf[holderIndex] = list;
+    }
+    links[memberIndex] = {holder, static_cast<std::uint32_t>(lists[list].members.size())};
+    lists[list].members.push_back(member);
+    pairCount++;
+}
+
+bool RelationStore::remove(Entity_id member) {
+    const std::uint32_t memberIndex = member & BITMASK_INDEX;
+    if (memberIndex >= links.size() || links[memberIndex].holder == NULL_ENTITY) return false;
+
+    Link& link = links[memberIndex];
+    const std::uint32_t list = listOf[link.holder & BITMASK_INDEX];
+    std::vector<Entity_id>& members = lists[list].members;
+
+    // swap and pop, keeping the moved member's back reference valid
+    const Entity_id last = members.back();
+    members[link.position] = last;
+    links[last & BITMASK_INDEX].position = link.position;
+    members.pop_back();
+    link = Link{NULL_ENTITY, 0};
+    pairCount--;
+
+    if (members.empty()) {
+        // keep lists packed: move the last list into the freed slot
+        const std::uint32_t lastList = static_cast<std::uint32_t>(lists.size() - 1);
+        listOf[lists[list].holder & BITMASK_INDEX] = NO_LIST;
+        if (list != lastList) {
+            lists[list] = std::move(lists[lastList]);
+            listOf[lists[list].holder & BITMASK_INDEX] = list;
+        }
+        lists.pop_back();
+    }
+    return true;
+}
+
+Entity_id RelationStore::getHolder(Entity_id member) const {
+    const std::uint32_t memberIndex = member & BITMASK_INDEX;
+    if (memberIndex >= links.size()) return NULL_ENTITY;
+    return links[memberIndex].holder;
+}
+
+std::span<const Entity_id> RelationStore::getMembers(Entity_id holder) const {
+    const std::uint32_t holderIndex = holder & BITMASK_INDEX;
+    if (holderIndex >= listOf.size() || listOf[holderIndex] == NO_LIST) return {};
+    return lists[listOf[holderIndex]].members;
+}
+
+void RelationStore::releaseHolder(Entity_id holder) {
+    const std::uint32_t holderIndex = holder & BITMASK_INDEX;
+    if (holderIndex >= listOf.size()) return;
+    while (listOf[holderIndex] != NO_LIST) {
+        remove(lists[listOf[holderIndex]].members.back());
+    }
+}
+
+void RelationStore::clear() {
+    links.clear();
+    listOf.clear();
+    lists.clear();
+    pairCount = 0;
+}
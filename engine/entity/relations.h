@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+using Entity_id = std::uint32_t;
+
+/*
+ * Built-in one-to-many relationships between entities. Every member has at
+ * most one holder per relation; destroying a holder destroys its members.
+ *   ChildOf: holder is the parent, members are its children
+ *   Owns:    holder is the owner, members are the entities it owns
+ */
+enum class Relation : std::uint8_t { ChildOf, Owns, Count };
+
+/*
+ * Storage for one relation. Members of a holder are kept in one contiguous
+ * array so walking children (or a whole hierarchy, level by level) is a
+ * linear scan instead of chasing sibling links. Removal swaps the last member
+ * into the hole, so member order is not stable.
+ *
+ * Indexed by entity index; the store does not check generations, that is
+ * EntityManager's job.
+ */
+class RelationStore {
+public:
+    /** Makes member belong to holder, detaching it from any previous holder */
+    void add(Entity_id holder, Entity_id member);
+    /** Detaches member from its holder; false if it had none */
+    bool remove(Entity_id member);
+    /** Holder of member, or NULL_ENTITY */
+    Entity_id getHolder(Entity_id member) const;
+    /** Members of holder; invalidated by any add/remove on this store */
+    std::span<const Entity_id> getMembers(Entity_id holder) const;
+    /** Drops every member list held by holder, detaching the members */
+    void releaseHolder(Entity_id holder);
+    /** Calls fn(holder, member) for every pair */
+    template <typename Fn> void forEachPair(Fn&& fn) const {
+        for (std::uint32_t list = 0; list < lists.size(); ++list) {
+            for (Entity_id member : lists[list].members) fn(lists[list].holder, member);
+        }
+    }
+    std::uint32_t getPairCount() const { return pairCount; }
+    void clear();
+
+private:
+    static constexpr std::uint32_t NO_LIST = 0xFFFFFFFF;
+
+    struct MemberList {
+        Entity_id holder;
+        std::vector<Entity_id> members;
+    };
+
+    struct Link {
+        Entity_id holder;
+        std::uint32_t position; // index in the holder's member list
+    };
+
+    void growTo(std::uint32_t index);
+
+    std::vector<Link> links;            // per member index
+    std::vector<std::uint32_t> listOf;  // per holder index, NO_LIST if none
+    std::vector<MemberList> lists;      // packed; holders own at most one list
+    std::uint32_t pairCount = 0;
+};
@@ -1,4 +1,5 @@
 #include "renderSystem.h"
+#include "prefab.h"
 #include <algorithm>
 #include <cstddef>
 #include <string>
@@ -67,50 +68,88 @@ Entity_id RenderSystem::createRenderableEntity(EntityManager &em, Mesh *mesh,
   constexpr ComponentMask renderMask = Components::Position | Components::Renderable;
   Entity_id entityId = em.createEntity(renderMask);
 
-  auto *entityPosition =
-      static_cast<Position *>(em.getComponentData(entityId, Components::Position));
-  auto *renderable =
-      static_cast<Renderable *>(em.getComponentData(entityId, Components::Renderable));
+  const Position entityPosition{position};
+  const Renderable renderable{meshId, materialId};
+  em.writeComponent(entityId, Components::Position, &entityPosition);
+  em.writeComponent(entityId, Components::Renderable, &renderable);
+  return entityId;
+}
 
-  if (!entityPosition || !renderable) {
-    return entityId;
+std::vector<Entity_id> RenderSystem::createRenderableEntities(
+    EntityManager &em, Mesh *mesh, Material *material,
+    const std::vector<mathplease::Vector4> &positions) {
+  const uint32_t meshId = registerMesh(mesh);
+  const uint32_t materialId = registerMaterial(material);
+  if (meshId == 0 || materialId == 0) {
+    return {};
   }
 
-  entityPosition->value = position;
-  renderable->meshId = meshId;
-  renderable->materialId = materialId;
-  return entityId;
+  constexpr ComponentMask renderMask = Components::Position | Components::Renderable;
+  Prefab prefab(renderMask);
+  prefab.set(Components::Renderable, Renderable{meshId, materialId});
+
+  std::vector<Entity_id> entityIds;
+  em.instantiate(prefab, static_cast<uint32_t>(positions.size()), &entityIds);
+
+  // instantiated rows are contiguous per chunk, so this walks the column linearly
+  for (std::size_t i = 0; i < entityIds.size(); ++i) {
+    const Position entityPosition{positions[i]};
+    em.writeComponent(entityIds[i], Components::Position, &entityPosition);
+  }
+  return entityIds;
 }
 
-std::vector<Renderer::Drawable>
-RenderSystem::collectDrawables(EntityManager &em) const {
-  std::vector<Renderer::Drawable> drawables;
-  constexpr ComponentMask requiredComponents =
-      Components::Renderable | Components::Position;
+namespace {
+// grouped by material, then mesh, to minimise pipeline and buffer rebinds
+bool drawOrder(const Renderer::Drawable &a, const Renderer::Drawable &b) {
+  if (a.material != b.material) {
+    return a.material < b.material;
+  }
+  return a.mesh < b.mesh;
+}
+} // namespace
 
-  const std::vector<Archetype *> archetypes =
-      em.getAllArchetypesWithComponent(requiredComponents);
+template <typename Emit>
+void RenderSystem::forEachDrawable(EntityManager &em, const SceneGraph *sceneGraph,
+                                   Emit &&emit) const {
+  const std::vector<Archetype *> &archetypes =
+      em.getArchetypes(ComponentQuery(Components::Renderable));
 
   const uint8_t renderableIndex = componentMaskToIndex(Components::Renderable);
   const uint8_t positionIndex = componentMaskToIndex(Components::Position);
+  const uint8_t transformableIndex = componentMaskToIndex(Components::Transformable);
 
   for (Archetype *archetype : archetypes) {
     if (!archetype) {
       continue;
     }
-
-    const uint32_t renderableOffset = archetype->offsets[renderableIndex];
-    const uint32_t positionOffset = archetype->offsets[positionIndex];
+    const bool hasPosition = archetype->componentMask & Components::Position;
+    const bool hasTransform =
+        sceneGraph && (archetype->componentMask & Components::Transformable);
+    if (!hasPosition && !hasTransform) {
+      continue;
+    }
 
     for (Chunk *chunk : archetype->chunks) {
       if (!chunk || chunk->row == 0) {
         continue;
       }
 
-      auto *chunkData = static_cast<std::byte *>(chunk->data);
-      auto *renderables =
-          reinterpret_cast<Renderable *>(chunkData + renderableOffset);
-      auto *positions = reinterpret_cast<Position *>(chunkData + positionOffset);
+      auto *renderables = reinterpret_cast<Renderable *>(
+          archetype->column(*chunk, renderableIndex));
+      auto *positions = hasPosition ? reinterpret_cast<Position *>(
+                                          archetype->column(*chunk, positionIndex))
+                                    : nullptr;
+      auto *transformables =
+          hasTransform ? reinterpret_cast<Transformable *>(
+                             archetype->column(*chunk, transformableIndex))
+                       : nullptr;
+      const bool splitPositions =
+          hasPosition && archetype->lanes[positionIndex] > 1;
+      const Vector3Streams positionStreams =
+          splitPositions
+              ? getVector3Streams(*archetype, *chunk, Components::Position)
+              : Vector3Streams{};
 
       for (uint32_t i = 0; i < chunk->row; ++i) {
         Mesh *mesh = getMesh(renderables[i].meshId);
@@ -119,28 +158,85 @@ RenderSystem::collectDrawables(EntityManager &em) const {
           continue;
         }
 
+        // cached world transform, recomputed by the graph only when dirty
+        const mathplease::Transform *world =
+            transformables ? sceneGraph->getWorldTransformPtr(transformables[i].handle)
+                           : nullptr;
+        if (!world && !hasPosition) {
+          continue;
+        }
+
         Renderer::Drawable drawable{mesh, material};
-        drawable.transform =
-            mathplease::Matrix4::translate(positions[i].value.xyz());
-        drawables.push_back(drawable);
+        if (world) {
+          drawable.transform = world->toMatrix4();
+        } else {
+          drawable.transform = mathplease::Matrix4::translate(
+              splitPositions
+                  ? mathplease::Vector3(positionStreams.x[i], positionStreams.y[i],
+                                        positionStreams.z[i])
+                  : positions[i].value.xyz());
+        }
+        emit(drawable);
       }
     }
   }
+}
 
-  std::sort(drawables.begin(), drawables.end(),
-            [](const Renderer::Drawable &a, const Renderer::Drawable &b) {
-              if (a.material != b.material) {
-                return a.material < b.material;
-              }
-              return a.mesh < b.mesh;
-            });
-
+std::vector<Renderer::Drawable>
+RenderSystem::collectDrawables(EntityManager &em, const SceneGraph *sceneGraph) const {
+  std::vector<Renderer::Drawable> drawables;
+  forEachDrawable(em, sceneGraph, [&](const Renderer::Drawable &drawable) {
+    drawables.push_back(drawable);
+  });
+  std::sort(drawables.begin(), drawables.end(), drawOrder);
   return drawables;
 }
 
-void RenderSystem::update(EntityManager &em, Renderer &renderer) {
+std::span<Renderer::Drawable>
+RenderSystem::collectDrawables(EntityManager &em, LinearAllocator &scratch,
+                               const SceneGraph *sceneGraph) const {
+  // every Renderable row is an upper bound on the drawable count
+  size_t capacity = 0;
+  for (Archetype *archetype :
+       em.getArchetypes(ComponentQuery(Components::Renderable))) {
+    if (!archetype) {
+      continue;
+    }
+    for (Chunk *chunk : archetype->chunks) {
+      capacity += chunk ? chunk->row : 0;
+    }
+  }
+  if (capacity == 0) {
+    return {};
+  }
+
+  Renderer::Drawable *drawables = scratch.allocateArray<Renderer::Drawable>(capacity);
+  if (!drawables) {
+    return {};
+  }
+  size_t count = 0;
+  forEachDrawable(em, sceneGraph, [&](const Renderer::Drawable &drawable) {
+    drawables[count++] = drawable;
+  });
+  std::sort(drawables, drawables + count, drawOrder);
+
+  // give back the rows that were skipped off the end of the array
+  scratch.freeToMarker(scratch.getMarker() - (capacity - count) * sizeof(Renderer::Drawable));
+  return {drawables, count};
+}
+
+void RenderSystem::update(EntityManager &em, Renderer &renderer,
+                          const SceneGraph *sceneGraph) {
   renderer.clearDrawables();
-  const auto drawables = collectDrawables(em);
+  std::span<Renderer::Drawable> drawables =
+      collectDrawables(em, renderer.frameScratch(), sceneGraph);
+  if (!drawables.data()) {
+    // did not fit in this frame's scratch memory: fall back to the heap
+    for (const auto &drawable : collectDrawables(em, sceneGraph)) {
+      renderer.addDrawable(drawable);
+    }
+    return;
+  }
   for (const auto &drawable : drawables) {
     renderer.addDrawable(drawable);
   }
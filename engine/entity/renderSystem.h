@@ -3,7 +3,9 @@
 #include "../renderer/renderer.h"
 #include "AssetManager.h"
 #include "entity.h"
+#include "sceneGraph.h"
 #include <cstdint>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -21,12 +23,29 @@ public:
   Entity_id createRenderableEntity(EntityManager &em, Mesh *mesh,
                                    Material *material,
                                    const mathplease::Vector4 &position);
+  // Bulk variant: spawns one renderable per position from a shared prefab
+  std::vector<Entity_id>
+  createRenderableEntities(EntityManager &em, Mesh *mesh, Material *material,
+                           const std::vector<mathplease::Vector4> &positions);
 
-  std::vector<Renderer::Drawable> collectDrawables(EntityManager &em) const;
-  void update(EntityManager &em, Renderer &renderer);
+  // Transformable entities use their cached world matrix from sceneGraph;
+  // everything else (or no graph) is placed at its Position
+  std::vector<Renderer::Drawable>
+  collectDrawables(EntityManager &em, const SceneGraph *sceneGraph = nullptr) const;
+  // Same list in scratch memory, for per-frame use without vector growth.
+  // Returns an empty span with a null data() if it does not fit
+  std::span<Renderer::Drawable>
+  collectDrawables(EntityManager &em, LinearAllocator &scratch,
+                   const SceneGraph *sceneGraph = nullptr) const;
+  void update(EntityManager &em, Renderer &renderer,
+              const SceneGraph *sceneGraph = nullptr);
 
 private:
   static std::string toAssetKey(uint32_t id);
+  // Calls emit(drawable) for each drawable entity, unsorted
+  template <typename Emit>
+  void forEachDrawable(EntityManager &em, const SceneGraph *sceneGraph,
+                       Emit &&emit) const;
 
   mutable AssetManager<Mesh *> meshManager;
   mutable AssetManager<Material *> materialManager;
@@ -1,96 +1,516 @@
 #include "sceneGraph.h"
 #include "entity.h"
+#include <algorithm>
 #include <cstdint>
 
 #define START_CAPACITY MAX_TRANSFORMS / 12 // 2^20 / 12 ~= 87381
 
+namespace {
+const std::vector<Transform_id> NO_CHILDREN;
+} // namespace
+
 SceneGraph::SceneGraph(EntityManager &entityManager)
     : entityManager(entityManager) {
-  localMatrices.reserve(START_CAPACITY);
-  worldMatrices.reserve(START_CAPACITY);
-  parentIndices.reserve(START_CAPACITY);
-  firstChildIndices.reserve(START_CAPACITY);
-  nextSiblingIndices.reserve(START_CAPACITY);
-  dirtyFlags.fill(0);
+    entityManager.getEvents().observe(Components::Position | Components::Transformable);
+    localPositions.reserve(START_CAPACITY);
+    localRotations.reserve(START_CAPACITY);
+    localScales.reserve(START_CAPACITY);
+    localTransforms.reserve(START_CAPACITY);
+    worldTransforms.reserve(START_CAPACITY);
+    parentDense.reserve(START_CAPACITY);
+    denseToHandle.reserve(START_CAPACITY);
 }
 
+Transform_id SceneGraph::attachEntity(Entity_id entityId, Transform_id parentId) {
+    if (!entityManager.isAlive(entityId)) return NULL_TRANSFORM;
+
+    const Transform_id existing = getEntityTransform(entityId);
+    if (existing != NULL_TRANSFORM) {
+        return setParent(existing, parentId) ? existing : NULL_TRANSFORM;
+    }
 
+    const Transform_id transformId = createTransform(parentId);
+    if (transformId == NULL_TRANSFORM) return NULL_TRANSFORM;
 
-void SceneGraph::setDirty(Transform_id transformId) {
-    dirtyFlags[transformId & BITMASK_INDEX] = true;
+    Position position;
+    if (entityManager.readComponent(entityId, Components::Position, &position)) {
+        setLocalPosition(transformId, position.value);
+    }
+    entityManager.addComponent(entityId, Components::Transformable);
+    const Transformable transformable{transformId};
+    entityManager.writeComponent(entityId, Components::Transformable, &transformable);
+    entityTransforms[entityId] = transformId;
+    return transformId;
 }
-/*
-*           head
-*           /
-*          /
-*        /  (firstChild)
-*      /
-* child1 (nextSiblingIndex)-> child2 (nextSiblingIndex)-> child3 (nextSiblingIndex)-> -1
-*    | (firstChild)            /                             | (firstChild)
-*   -1                       /                              -1
-*                          /  (firstChild)
-*                        /
-*                    child4 -> -1
-*                      | (firstChild)
-*                     -1
-* TODO: remove recursion. or improve it somehow
-* improve: use depth to sort transforms to update for cache coherence
-*/
-void SceneGraph::setSubtreeDirty(Transform_id transformId) {
-    uint32_t index = transformIndex(transformId);
-    if (index == -1) return;
-    dirtyFlags[index] = true;
 
-    setSubtreeDirty(nextSiblingIndices[index]);
-    setSubtreeDirty(firstChildIndices[index]);
+Transform_id SceneGraph::getEntityTransform(Entity_id entityId) {
+    Transformable transformable;
+    if (!entityManager.readComponent(entityId, Components::Transformable, &transformable) ||
+        !alive(transformable.handle)) {
+        return NULL_TRANSFORM;
+    }
+    return transformable.handle;
+}
 
+void SceneGraph::syncEntities() {
+    const ComponentEventStream& events = entityManager.getEvents();
 
+    for (Entity_id entityId : events.get(ComponentEvent::OnRemove, Components::Transformable)) {
+        auto it = entityTransforms.find(entityId);
+        if (it == entityTransforms.end()) continue;
+        deleteTransform(it->second);
+        entityTransforms.erase(it);
+    }
+
+    // only the changed positions; untouched transforms stay clean
+    for (Entity_id entityId : events.get(ComponentEvent::OnSet, Components::Position)) {
+        const Transform_id transformId = getEntityTransform(entityId);
+        if (transformId == NULL_TRANSFORM) continue;
+        Position position;
+        if (entityManager.readComponent(entityId, Components::Position, &position)) {
+            setLocalPosition(transformId, position.value);
+        }
+    }
 }
 
 uint32_t inline SceneGraph::transformIndex(Transform_id transformId) const {
     return transformId & BITMASK_INDEX;
 }
 
-uint32_t inline SceneGraph::transformGeneration(Transform_id transformId) const {
-    return transformId & BITMASK_GENERATION;
+uint32_t SceneGraph::denseIndex(Transform_id transformId) const {
+    uint32_t index = transformIndex(transformId);
+    if (transformId == NULL_TRANSFORM || index >= handleToDense.size() ||
+        generations[index] != (transformId & BITMASK_GENERATION)) {
+        return INVALID_DENSE;
+    }
+    return handleToDense[index];
 }
 
-Transform_id SceneGraph::getParent(Transform_id childId) {
-    uint32_t index = transformIndex(childId);
-    if (index >= parentIndices.size()) return -1;
-    uint32_t parentIndex = parentIndices[index];
-    if (parentIndex == -1) return -1;
-    return (transformGeneration(childId)) | parentIndex;
+bool SceneGraph::alive(Transform_id transformId) const {
+    return denseIndex(transformId) != INVALID_DENSE;
 }
-// TODO: fix waht ai did here tmr
-Transform_id SceneGraph::createTransform(Transform_id transformId, Transform_id parentId) {
-    uint32_t index;
-    if (transformId == NULL_ENTITY) {
-        if (!freeIndices.empty()) {
-            index = freeIndices.back();
-            freeIndices.pop_back();
-        } else {
-            index = static_cast<uint32_t>(localPositions.size());
-            localPositions.emplace_back(0.0f, 0.0f, 0.0f, 1.0f);
-            localRotations.emplace_back(0.0f, 0.0f, 0.0f, 1.0f);
-            localScales.emplace_back(1.0f, 1.0f, 1.0f, 1.0f);
-            localMatrices.emplace_back(mathplease::Matrix4::identity());
-            worldMatrices.emplace_back(mathplease::Matrix4::identity());
-            parentIndices.push_back(-1);
-            firstChildIndices.push_back(-1);
-            nextSiblingIndices.push_back(-1);
-            dirtyFlags[index] = true;
+
+uint32_t SceneGraph::levelOf(uint32_t dense) const {
+    // first level whose end lies past dense
+    return static_cast<uint32_t>(
+        std::upper_bound(levelStart.begin() + 1, levelStart.end(), dense) - levelStart.begin() - 1);
+}
+
+uint32_t SceneGraph::getDepth(Transform_id transformId) const {
+    uint32_t dense = denseIndex(transformId);
+    return dense == INVALID_DENSE ? 0 : levelOf(dense);
+}
+
+/*
+ * Moves a slot's data and fixes everything that refers to its position: the
+ * handle table and the parent index of its children.
+ */
+void SceneGraph::moveSlot(uint32_t from, uint32_t to) {
+    localPositions[to] = localPositions[from];
+    localRotations[to] = localRotations[from];
+    localScales[to] = localScales[from];
+    localTransforms[to] = localTransforms[from];
+    worldTransforms[to] = worldTransforms[from];
+    parentDense[to] = parentDense[from];
+    localDirty.assign(to, localDirty.test(from));
+    worldDirty.assign(to, worldDirty.test(from));
+    denseToHandle[to] = denseToHandle[from];
+
+    const uint32_t handle = denseToHandle[to];
+    handleToDense[handle] = to;
+    for (Transform_id child : childLists[handle]) {
+        uint32_t childDense = handleToDense[transformIndex(child)];
+        if (childDense != INVALID_DENSE) {
+            parentDense[childDense] = static_cast<int32_t>(to);
         }
-        transformId = (0 | index); // generation 0
-    } else {
-        index = transformIndex(transformId);
     }
+}
+
+/*
+ * Opens a slot at the end of level `depth`: the first element of every
+ * deeper level rotates to the end of its level, walking the gap upwards.
+ */
+uint32_t SceneGraph::insertAtLevel(uint32_t depth) {
+    if (depth == getLevelCount()) {
+        levelStart.push_back(levelStart.back());
+    }
+
+    localPositions.emplace_back();
+    localRotations.emplace_back();
+    localScales.emplace_back();
+    localTransforms.emplace_back();
+    worldTransforms.emplace_back();
+    parentDense.push_back(-1);
+    denseToHandle.push_back(0);
+    localDirty.resize(getTransformCount());
+    worldDirty.resize(getTransformCount());
+    levelStart.back()++;
 
-    if (parentId != NULL_ENTITY) {
-        linkToParent(transformId, parentId);
+    uint32_t hole = static_cast<uint32_t>(denseToHandle.size() - 1);
+    for (uint32_t level = getLevelCount() - 1; level > depth; --level) {
+        const uint32_t first = levelStart[level];
+        if (first != hole) {
+            moveSlot(first, hole);
+        }
+        hole = first;
+        levelStart[level] = first + 1;
     }
+    return hole;
+}
 
-    setDirty(transformId);
+/*
+ * Closes the gap left by `dense`: the last element of its level fills it,
+ * then the last element of every deeper level moves down into the gap that
+ * opens at the end of the level above.
+ */
+void SceneGraph::removeAt(uint32_t dense) {
+    const uint32_t depth = levelOf(dense);
+    const uint32_t levelCount = getLevelCount();
 
+    uint32_t hole = levelStart[depth + 1] - 1;
+    if (dense != hole) {
+        moveSlot(hole, dense);
+    }
+    for (uint32_t level = depth + 1; level < levelCount; ++level) {
+        const uint32_t last = levelStart[level + 1] - 1;
+        if (last != hole) {
+            moveSlot(last, hole);
+        }
+        levelStart[level]--;
+        hole = last;
+    }
+    levelStart.back()--;
+
+    localPositions.pop_back();
+    localRotations.pop_back();
+    localScales.pop_back();
+    localTransforms.pop_back();
+    worldTransforms.pop_back();
+    parentDense.pop_back();
+    denseToHandle.pop_back();
+    localDirty.resize(getTransformCount());
+    worldDirty.resize(getTransformCount());
+
+    while (getLevelCount() > 0 && levelStart[levelStart.size() - 2] == levelStart.back()) {
+        levelStart.pop_back();
+    }
+}
+
+SceneGraph::Slot SceneGraph::saveSlot(uint32_t dense) const {
+    return {localPositions[dense], localRotations[dense], localScales[dense],
+            localTransforms[dense], localDirty.test(dense)};
+}
+
+// Breadth first, so parents always come before their children
+void SceneGraph::collectSubtree(Transform_id root, std::vector<Transform_id>& out) const {
+    out.push_back(root);
+    for (size_t i = out.size() - 1; i < out.size(); ++i) {
+        const auto& children = childLists[transformIndex(out[i])];
+        out.insert(out.end(), children.begin(), children.end());
+    }
+}
+
+void SceneGraph::detachFromParent(Transform_id childId) {
+    const uint32_t index = transformIndex(childId);
+    const Transform_id parent = parentHandles[index];
+    if (parent == NULL_TRANSFORM) return;
+
+    auto& siblings = childLists[transformIndex(parent)];
+    auto it = std::find(siblings.begin(), siblings.end(), childId);
+    if (it != siblings.end()) {
+        *it = siblings.back();
+        siblings.pop_back();
+    }
+    parentHandles[index] = NULL_TRANSFORM;
+}
+
+Transform_id SceneGraph::createTransform(Transform_id parentId) {
+    uint32_t parentSlot = INVALID_DENSE;
+    if (parentId != NULL_TRANSFORM) {
+        parentSlot = denseIndex(parentId);
+        if (parentSlot == INVALID_DENSE) return NULL_TRANSFORM;
+    }
+
+    uint32_t index;
+    if (!freeIndices.empty()) {
+        index = freeIndices.back();
+        freeIndices.pop_back();
+    } else {
+        index = static_cast<uint32_t>(handleToDense.size());
+        if (index > BITMASK_INDEX) return NULL_TRANSFORM;
+        handleToDense.push_back(INVALID_DENSE);
+        generations.push_back(0);
+        parentHandles.push_back(NULL_TRANSFORM);
+        childLists.emplace_back();
+    }
+    const Transform_id transformId = generations[index] | index;
+
+    const uint32_t depth = parentSlot == INVALID_DENSE ? 0 : levelOf(parentSlot) + 1;
+    // parents are shallower than the insertion level, so parentSlot stays put
+    const uint32_t dense = insertAtLevel(depth);
+    localPositions[dense] = mathplease::Vector4(0.0f, 0.0f, 0.0f, 1.0f);
+    localRotations[dense] = mathplease::Quaternion::identity();
+    localScales[dense] = mathplease::Vector4(1.0f, 1.0f, 1.0f, 1.0f);
+    localTransforms[dense] = mathplease::Transform::identity();
+    worldTransforms[dense] = mathplease::Transform::identity();
+    parentDense[dense] = parentSlot == INVALID_DENSE ? -1 : static_cast<int32_t>(parentSlot);
+    localDirty.set(dense);
+    worldDirty.set(dense);
+    denseToHandle[dense] = index;
+    handleToDense[index] = dense;
+
+    if (parentId != NULL_TRANSFORM) {
+        parentHandles[index] = parentId;
+        childLists[transformIndex(parentId)].push_back(transformId);
+    }
     return transformId;
-}
\ No newline at end of file
+}
+
+void SceneGraph::deleteTransform(Transform_id transformId) {
+    if (!alive(transformId)) return;
+
+    std::vector<Transform_id> subtree;
+    collectSubtree(transformId, subtree);
+    detachFromParent(transformId);
+
+    // deepest first, so no removed slot still has live children
+    for (auto it = subtree.rbegin(); it != subtree.rend(); ++it) {
+        const uint32_t index = transformIndex(*it);
+        const uint32_t dense = handleToDense[index];
+        handleToDense[index] = INVALID_DENSE; // before the moves, so no slot is patched through it
+        removeAt(dense);
+        generations[index] = (generations[index] + (BITMASK_INDEX + 1)) & BITMASK_GENERATION;
+        parentHandles[index] = NULL_TRANSFORM;
+        childLists[index].clear();
+        freeIndices.push_back(index);
+    }
+}
+
+bool SceneGraph::setParent(Transform_id childId, Transform_id parentId) {
+    const uint32_t childSlot = denseIndex(childId);
+    if (childSlot == INVALID_DENSE || childId == parentId) return false;
+    if (parentId != NULL_TRANSFORM) {
+        if (!alive(parentId)) return false;
+        for (Transform_id up = parentId; up != NULL_TRANSFORM; up = parentHandles[transformIndex(up)]) {
+            if (up == childId) return false; // parent is inside the child's subtree
+        }
+    }
+
+    const uint32_t oldDepth = levelOf(childSlot);
+    const uint32_t newDepth = parentId == NULL_TRANSFORM ? 0 : getDepth(parentId) + 1;
+
+    detachFromParent(childId);
+    if (parentId != NULL_TRANSFORM) {
+        parentHandles[transformIndex(childId)] = parentId;
+        childLists[transformIndex(parentId)].push_back(childId);
+    }
+
+    if (newDepth == oldDepth) {
+        // same level: only the parent link changes, no re-sorting
+        parentDense[childSlot] = parentId == NULL_TRANSFORM ? -1 : static_cast<int32_t>(denseIndex(parentId));
+        worldDirty.set(childSlot);
+        return true;
+    }
+
+    // Depth changed: lift the subtree out (leaves first) and reinsert it
+    // breadth first at its new levels.
+    std::vector<Transform_id> subtree;
+    collectSubtree(childId, subtree);
+    std::vector<Slot> saved;
+    saved.reserve(subtree.size());
+    for (Transform_id id : subtree) {
+        saved.push_back(saveSlot(handleToDense[transformIndex(id)]));
+    }
+    for (auto it = subtree.rbegin(); it != subtree.rend(); ++it) {
+        const uint32_t index = transformIndex(*it);
+        const uint32_t dense = handleToDense[index];
+        handleToDense[index] = INVALID_DENSE;
+        removeAt(dense);
+    }
+
+    for (size_t i = 0; i < subtree.size(); ++i) {
+        const uint32_t index = transformIndex(subtree[i]);
+        const Transform_id parent = parentHandles[index];
+        const uint32_t parentSlot = parent == NULL_TRANSFORM ? INVALID_DENSE : handleToDense[transformIndex(parent)];
+        const uint32_t depth = parentSlot == INVALID_DENSE ? 0 : levelOf(parentSlot) + 1;
+
+        const uint32_t dense = insertAtLevel(depth);
+        const Slot& slot = saved[i];
+        localPositions[dense] = slot.position;
+        localRotations[dense] = slot.rotation;
+        localScales[dense] = slot.scale;
+        localTransforms[dense] = slot.localTransform;
+        parentDense[dense] = parentSlot == INVALID_DENSE ? -1 : static_cast<int32_t>(parentSlot);
+        localDirty.assign(dense, slot.localDirty);
+        worldDirty.set(dense);
+        denseToHandle[dense] = index;
+        handleToDense[index] = dense;
+    }
+    return true;
+}
+
+Transform_id SceneGraph::getParent(Transform_id childId) const {
+    if (!alive(childId)) return NULL_TRANSFORM;
+    return parentHandles[transformIndex(childId)];
+}
+
+const std::vector<Transform_id>& SceneGraph::getChildren(Transform_id parentId) const {
+    if (!alive(parentId)) return NO_CHILDREN;
+    return childLists[transformIndex(parentId)];
+}
+
+void SceneGraph::setDirty(uint32_t dense) {
+    localDirty.set(dense);
+    worldDirty.set(dense);
+}
+
+void SceneGraph::setLocalTRS(Transform_id transformId, const mathplease::Vector4& position,
+                             const mathplease::Quaternion& rotation,
+                             const mathplease::Vector4& scale) {
+    uint32_t dense = denseIndex(transformId);
+    if (dense == INVALID_DENSE) return;
+    localPositions[dense] = position;
+    localRotations[dense] = rotation;
+    localScales[dense] = scale;
+    setDirty(dense);
+}
+
+void SceneGraph::setLocalPosition(Transform_id transformId, const mathplease::Vector4& position) {
+    if (mathplease::Vector4* ptr = getLocalPositionPtr(transformId)) *ptr = position;
+}
+
+void SceneGraph::setLocalRotation(Transform_id transformId, const mathplease::Quaternion& rotation) {
+    if (mathplease::Quaternion* ptr = getLocalRotationPtr(transformId)) *ptr = rotation;
+}
+
+void SceneGraph::setLocalScale(Transform_id transformId, const mathplease::Vector4& scale) {
+    if (mathplease::Vector4* ptr = getLocalScalePtr(transformId)) *ptr = scale;
+}
+
+mathplease::Vector4 SceneGraph::getLocalPosition(Transform_id transformId) const {
+    uint32_t dense = denseIndex(transformId);
+    return dense == INVALID_DENSE ? mathplease::Vector4() : localPositions[dense];
+}
+
+mathplease::Quaternion SceneGraph::getLocalRotation(Transform_id transformId) const {
+    uint32_t dense = denseIndex(transformId);
+    return dense == INVALID_DENSE ? mathplease::Quaternion() : localRotations[dense];
+}
+
+mathplease::Vector4 SceneGraph::getLocalScale(Transform_id transformId) const {
+    uint32_t dense = denseIndex(transformId);
+    return dense == INVALID_DENSE ? mathplease::Vector4() : localScales[dense];
+}
+
+mathplease::Vector4* SceneGraph::getLocalPositionPtr(Transform_id transformId) {
+    uint32_t dense = denseIndex(transformId);
+    if (dense == INVALID_DENSE) return nullptr;
+    setDirty(dense);
+    return &localPositions[dense];
+}
+
+mathplease::Quaternion* SceneGraph::getLocalRotationPtr(Transform_id transformId) {
+    uint32_t dense = denseIndex(transformId);
+    if (dense == INVALID_DENSE) return nullptr;
+    setDirty(dense);
+    return &localRotations[dense];
+}
+
+mathplease::Vector4* SceneGraph::getLocalScalePtr(Transform_id transformId) {
+    uint32_t dense = denseIndex(transformId);
+    if (dense == INVALID_DENSE) return nullptr;
+    setDirty(dense);
+    return &localScales[dense];
+}
+
+mathplease::Transform SceneGraph::computeLocalTransform(uint32_t dense) const {
+    return mathplease::Transform::fromTRS(localPositions[dense].xyz(), localRotations[dense],
+                                          localScales[dense].xyz());
+}
+
+mathplease::Transform SceneGraph::getLocalTransform(Transform_id transformId) const {
+    uint32_t dense = denseIndex(transformId);
+    return dense == INVALID_DENSE ? mathplease::Transform::identity() : computeLocalTransform(dense);
+}
+
+mathplease::Transform SceneGraph::getWorldTransform(Transform_id transformId) const {
+    uint32_t dense = denseIndex(transformId);
+    return dense == INVALID_DENSE ? mathplease::Transform::identity() : worldTransforms[dense];
+}
+
+const mathplease::Transform* SceneGraph::getWorldTransformPtr(Transform_id transformId) const {
+    uint32_t dense = denseIndex(transformId);
+    return dense == INVALID_DENSE ? nullptr : &worldTransforms[dense];
+}
+
+mathplease::Matrix4 SceneGraph::getLocalMatrix(Transform_id transformId) const {
+    return getLocalTransform(transformId).toMatrix4();
+}
+
+mathplease::Matrix4 SceneGraph::getWorldMatrix(Transform_id transformId) const {
+    return getWorldTransform(transformId).toMatrix4();
+}
+
+/*
+ * Parents precede children in dense order, so walking the dirty bits of a
+ * range forward sees every parent's world transform already up to date. Each
+ * recomputed transform marks its children, which sit further along (or in a
+ * later level), so only changed subtrees are visited. `concurrent` when
+ * other batches of the same level run at the same time.
+ */
+void SceneGraph::updateRange(uint32_t begin, uint32_t end, bool concurrent) {
+    for (uint32_t i = worldDirty.findNext(begin, end); i != DirtyBitset::NONE;
+         i = worldDirty.findNext(i + 1, end)) {
+        if (localDirty.test(i)) {
+            localTransforms[i] = computeLocalTransform(i);
+        }
+        const int32_t parent = parentDense[i];
+        worldTransforms[i] = parent >= 0 ? worldTransforms[parent] * localTransforms[i] : localTransforms[i];
+
+        for (Transform_id child : childLists[denseToHandle[i]]) {
+            const uint32_t childDense = handleToDense[transformIndex(child)];
+            if (concurrent) {
+                worldDirty.setConcurrent(childDense);
+            } else {
+                worldDirty.set(childDense);
+            }
+        }
+    }
+}
+
+/*
+ * Serial: one pass over the dirty bits. With a job system each level is
+ * split into batches across the workers; a level only reads its parents'
+ * level, so the wait between levels is the only synchronisation. Clean
+ * levels are skipped and levels too small to be worth a job run inline on
+ * the calling thread.
+ */
+void SceneGraph::updateWorldTransforms(JobSystem* jobSystem) {
+    const uint32_t count = getTransformCount();
+    if (!jobSystem || jobSystem->getThreadCount() < 2 || count < MIN_TRANSFORMS_PER_JOB * 2) {
+        updateRange(0, count, false);
+    } else {
+        const uint32_t batchesPerLevel = jobSystem->getThreadCount() * 2;
+        for (uint32_t level = 0; level < getLevelCount(); ++level) {
+            const uint32_t begin = levelStart[level];
+            const uint32_t end = levelStart[level + 1];
+            const uint32_t firstDirty = worldDirty.findNext(begin, end);
+            if (firstDirty == DirtyBitset::NONE) continue;
+            if (end - firstDirty < MIN_TRANSFORMS_PER_JOB * 2) {
+                updateRange(firstDirty, end, false);
+                continue;
+            }
+
+            const uint32_t batchSize = std::max(MIN_TRANSFORMS_PER_JOB,
+                                                (end - firstDirty + batchesPerLevel - 1) / batchesPerLevel);
+            JobCounter counter;
+            for (uint32_t first = firstDirty; first < end; first += batchSize) {
+                const uint32_t last = std::min(end, first + batchSize);
+                jobSystem->kickJob([this, first, last]() { updateRange(first, last, true); }, &counter);
+            }
+            jobSystem->waitForCounter(&counter);
+        }
+    }
+    localDirty.clear();
+    worldDirty.clear();
+}
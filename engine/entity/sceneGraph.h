@@ -2,85 +2,154 @@
 #ifndef LIGHTSPLEASE_SCENEGRAPH_H
 #define LIGHTSPLEASE_SCENEGRAPH_H
 
+#include "dirty_bitset.h"
 #include "entity.h"
 #include "../job_system.h"
 #include <sys/types.h>
+#include <unordered_map>
 #include <vector>
 
 #define MAX_TRANSFORMS 1048576 // 2^20
-
+#define NULL_TRANSFORM 0xFFFFFFFF
+
+/*
+ * Transform hierarchy stored breadth first: all per-transform data lives in
+ * dense arrays sorted by depth, so every parent sits before its children and
+ * world transforms are one linear pass over the arrays. Local and world
+ * transforms are affine 3x4 (mathplease::Transform), built straight from
+ * TRS with quaternion rotations, so propagation never touches a full 4x4.
+ *
+ * Level d occupies [levelStart[d], levelStart[d + 1]). Inserting or removing
+ * a transform moves one element per deeper level (the first or last of each
+ * level rotates into the gap), so structural changes cost O(levels), not
+ * O(transforms). Changed transforms are tracked in a two-level bitset, and
+ * the update walks only those, pushing dirtiness to children through the
+ * child lists, so its cost follows the number of changed transforms and
+ * their descendants rather than the total.
+ *
+ * Transform_ids are stable handles (22 bit index, 10 bit generation like
+ * Entity_id); the dense position of a transform changes whenever the
+ * hierarchy does.
+ *
+ * Entities join the graph through attachEntity, which gives them a
+ * Transformable component holding their handle. syncEntities consumes the
+ * EntityManager's component events: Position sets become local position
+ * changes, and removing Transformable (or destroying the entity) deletes its
+ * transform together with the subtree below it.
+ */
 class SceneGraph {
 public:
     SceneGraph(EntityManager& entityManager);
-    /** Creates a transform component for the given entity */
-    Transform_id createTransform(Transform_id transformId, Transform_id parentId = -1);
-    /** Deletes the transform component associated with the given entity */
+
+    /** Gives the entity a transform (or reparents the one it has), seeded
+     * from its Position, and stores the handle in its Transformable */
+    Transform_id attachEntity(Entity_id entityId, Transform_id parentId = NULL_TRANSFORM);
+    /** NULL_TRANSFORM if the entity has no live transform */
+    Transform_id getEntityTransform(Entity_id entityId);
+    /** Applies the component events published by the last
+     * EntityManager::getEvents().sync(); call before updateWorldTransforms */
+    void syncEntities();
+
+    /** Creates a transform with identity TRS, optionally under a parent */
+    Transform_id createTransform(Transform_id parentId = NULL_TRANSFORM);
+    /** Deletes the transform and its whole subtree */
     void deleteTransform(Transform_id transformId);
-    /** Sets the parent of a given child entity and updates the scene graph accordingly */
-    void setParent(Transform_id childId, Transform_id parentId);
-    /** Retrieves the parent of a given child entity */
-    Transform_id getParent(Transform_id childId);
+    /** Reparents a transform (NULL_TRANSFORM makes it a root). The subtree is
+     * re-sorted only if its depth changes. Fails on dead ids and cycles */
+    bool setParent(Transform_id childId, Transform_id parentId);
+    /** Retrieves the parent of a given child, NULL_TRANSFORM for roots */
+    Transform_id getParent(Transform_id childId) const;
+    const std::vector<Transform_id>& getChildren(Transform_id parentId) const;
+    uint32_t getDepth(Transform_id transformId) const;
+    bool alive(Transform_id transformId) const;
+
+    uint32_t getTransformCount() const { return static_cast<uint32_t>(denseToHandle.size()); }
+    uint32_t getLevelCount() const { return static_cast<uint32_t>(levelStart.size() - 1); }
 
     void setLocalTRS(Transform_id transformId, const mathplease::Vector4& position,
-                         const mathplease::Vector4& rotation,
+                         const mathplease::Quaternion& rotation,
                          const mathplease::Vector4& scale);
 
     void setLocalPosition(Transform_id transformId, const mathplease::Vector4& position);
-    void setLocalRotation(Transform_id transformId, const mathplease::Vector4& rotation);
+    void setLocalRotation(Transform_id transformId, const mathplease::Quaternion& rotation);
     void setLocalScale(Transform_id transformId, const mathplease::Vector4& scale);
-    
-    mathplease::Vector4 getLocalPosition(Transform_id transformId);
-    mathplease::Vector4 getLocalRotation(Transform_id transformId);
-    mathplease::Vector4 getLocalScale(Transform_id transformId);
 
-    /** Jobsystem may update local transform components directly without synchronization
-     * e.g it might be deleted by a job while another job is reading it. but idk tho
+    mathplease::Vector4 getLocalPosition(Transform_id transformId) const;
+    mathplease::Quaternion getLocalRotation(Transform_id transformId) const;
+    mathplease::Vector4 getLocalScale(Transform_id transformId) const;
+
+    /** Direct access for jobs that write many transforms. Marks the transform
+     * dirty; the pointer is invalidated by any create/delete/reparent.
      */
     mathplease::Vector4* getLocalPositionPtr(Transform_id transformId);
-    mathplease::Vector4* getLocalRotationPtr(Transform_id transformId);
+    mathplease::Quaternion* getLocalRotationPtr(Transform_id transformId);
     mathplease::Vector4* getLocalScalePtr(Transform_id transformId);
 
+    /** Computed from the current local TRS */
+    mathplease::Transform getLocalTransform(Transform_id transformId) const;
+    /** As of the last updateWorldTransforms */
+    mathplease::Transform getWorldTransform(Transform_id transformId) const;
+    const mathplease::Transform* getWorldTransformPtr(Transform_id transformId) const;
 
+    // 4x4 expansions of the above, for code that feeds shaders
+    mathplease::Matrix4 getLocalMatrix(Transform_id transformId) const;
+    mathplease::Matrix4 getWorldMatrix(Transform_id transformId) const;
 
-    mathplease::Matrix4 getLocalMatrix(Transform_id transformId) ;
-    mathplease::Matrix4 getWorldMatrix(Transform_id transformId) ;
-    
-    mathplease::Matrix4* getWorldMatrixPtr(Transform_id transformId) ;
-    mathplease::Matrix4* getLocalMatrixPtr(Transform_id transformId) ;
-
-    /** updates for all dirty transforms */
+    /** Recomputes dirty transforms and everything below them, level by
+     * level across the job system's workers when one is given */
     void updateWorldTransforms(JobSystem* jobSystem);
 
-
 private:
+    static constexpr uint32_t INVALID_DENSE = 0xFFFFFFFF;
+    static constexpr uint32_t MIN_TRANSFORMS_PER_JOB = 1024;
+
+    // Everything stored per dense slot, used while re-sorting a subtree
+    struct Slot {
+        mathplease::Vector4 position;
+        mathplease::Quaternion rotation;
+        mathplease::Vector4 scale;
+        mathplease::Transform localTransform;
+        bool localDirty;
+    };
+
     EntityManager& entityManager;
 
-    bool alive(Transform_id transformId) const;
     uint32_t inline transformIndex(Transform_id transformId) const;
-    uint32_t inline transformGeneration(Transform_id transformId) const;
+    uint32_t denseIndex(Transform_id transformId) const; // INVALID_DENSE if dead
+    uint32_t levelOf(uint32_t dense) const;
 
-    void unlinkFromParent(Transform_id childId);
-    void linkToParent(Transform_id childId, Transform_id parentId);
+    uint32_t insertAtLevel(uint32_t depth);
+    void removeAt(uint32_t dense);
+    void moveSlot(uint32_t from, uint32_t to);
+    Slot saveSlot(uint32_t dense) const;
+    void collectSubtree(Transform_id root, std::vector<Transform_id>& out) const;
+    void detachFromParent(Transform_id childId);
 
-    void setDirty(Transform_id transformId);
-    void setSubtreeDirty(Transform_id transformId);
-
-    mathplease::Matrix4 computeLocalMatrix(Transform_id transformId) ;
-    void computeWorldMatrixRecursive(Transform_id transformId, const mathplease::Matrix4& parentWorldMatrix);
-
-    void updateSubtree(uint32_t topIndex);
+    void setDirty(uint32_t dense);
+    mathplease::Transform computeLocalTransform(uint32_t dense) const;
+    void updateRange(uint32_t begin, uint32_t end, bool concurrent);
 
+    // Dense, depth-sorted
     std::vector<mathplease::Vector4> localPositions;
-    std::vector<mathplease::Vector4> localRotations;
+    std::vector<mathplease::Quaternion> localRotations;
     std::vector<mathplease::Vector4> localScales;
-    std::vector<mathplease::Matrix4> localMatrices;
-    std::vector<mathplease::Matrix4> worldMatrices;
-    std::array<uint8_t, BITMASK_INDEX + 1> dirtyFlags; // pre-allocated for branchless access
+    std::vector<mathplease::Transform> localTransforms; // affine 3x4, see mathplease::Transform
+    std::vector<mathplease::Transform> worldTransforms;
+    std::vector<int32_t> parentDense; // -1 for roots; always below own index
+    DirtyBitset localDirty; // TRS changed, rebuild the local matrix
+    DirtyBitset worldDirty; // world matrix must be recomputed
+    std::vector<uint32_t> denseToHandle; // handle index of each slot
+    std::vector<uint32_t> levelStart{0};  // levels + 1 entries
+
+    // Per handle index, stable across re-sorting
+    std::vector<uint32_t> handleToDense;
+    std::vector<uint32_t> generations;
+    std::vector<Transform_id> parentHandles;
+    std::vector<std::vector<Transform_id>> childLists;
     std::vector<uint32_t> freeIndices;
-    std::vector<int32_t> parentIndices; // -1 if no parent
-    std::vector<int32_t> firstChildIndices; // -1 if no children
-    std::vector<int32_t> nextSiblingIndices; // -1 if no next sibling
-    uint32_t nextGeneration = 1;
+
+    // Transformable is gone by the time its OnRemove event is read
+    std::unordered_map<Entity_id, Transform_id> entityTransforms;
 };
 
-#endif //LIGHTSPLEASE_SCENEGRAPH_H
\ No newline at end of file
+#endif //LIGHTSPLEASE_SCENEGRAPH_H
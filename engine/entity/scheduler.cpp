@@ -0,0 +1,148 @@
+#include "scheduler.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+} // namespace
+
+bool SystemScheduler::conflicts(const SystemAccess& a, const SystemAccess& b) {
+    return (a.writes & (b.reads | b.writes)) != 0 || (b.writes & a.reads) != 0;
+}
+
+System_id SystemScheduler::registerSystem(std::string name, ComponentMask reads,
+                                          ComponentMask writes, UpdateFn update) {
+    SystemEntry entry;
+    entry.name = std::move(name);
+    entry.access = {reads, writes};
+    entry.update = std::move(update);
+    systems.push_back(std::move(entry));
+    planDirty = true;
+    return static_cast<System_id>(systems.size() - 1);
+}
+
+/*
+ * Greedy phase assignment in registration order: a system lands one phase
+ * after the latest earlier system it conflicts with, so every phase holds
+ * only mutually compatible systems.
+ */
+void SystemScheduler::buildPlan() {
+    phases.clear();
+    for (System_id id = 0; id < systems.size(); ++id) {
+        SystemEntry& entry = systems[id];
+        entry.dependencies.clear();
+        entry.phase = 0;
+        for (System_id earlier = 0; earlier < id; ++earlier) {
+            if (conflicts(entry.access, systems[earlier].access)) {
+                entry.dependencies.push_back(earlier);
+                entry.phase = std::max(entry.phase, systems[earlier].phase + 1);
+            }
+        }
+        if (entry.phase >= phases.size()) {
+            phases.resize(entry.phase + 1);
+        }
+        phases[entry.phase].push_back(id);
+    }
+    planDirty = false;
+}
+
+const std::vector<std::vector<System_id>>& SystemScheduler::getPhases() {
+    if (planDirty) buildPlan();
+    return phases;
+}
+
+void SystemScheduler::run(EntityManager& entityManager, JobSystem* jobSystem, float deltaTime) {
+    if (planDirty) buildPlan();
+
+    const auto frameStart = std::chrono::steady_clock::now();
+
+    // Populate the query cache up front so systems running in parallel only
+    // ever read it.
+    for (const SystemEntry& entry : systems) {
+        ComponentMask query = entry.access.reads | entry.access.writes;
+        if (query != 0) {
+            entityManager.getAllArchetypesWithComponent(query);
+        }
+    }
+
+    lastFrame.systems.resize(systems.size());
+    for (System_id id = 0; id < systems.size(); ++id) {
+        lastFrame.systems[id] = {id, systems[id].phase, 0.0};
+    }
+
+    for (const std::vector<System_id>& phase : phases) {
+        if (!jobSystem || phase.size() == 1) {
+            for (System_id id : phase) {
+                const auto start = std::chrono::steady_clock::now();
+                systems[id].update(entityManager, jobSystem, deltaTime);
+                lastFrame.systems[id].seconds = secondsSince(start);
+            }
+            continue;
+        }
+
+        JobCounter counter = {};
+        for (System_id id : phase) {
+            jobSystem->kickJob([this, id, &entityManager, jobSystem, deltaTime]() {
+                const auto start = std::chrono::steady_clock::now();
+                systems[id].update(entityManager, jobSystem, deltaTime);
+                lastFrame.systems[id].seconds = secondsSince(start);
+            }, &counter);
+        }
+        jobSystem->waitForCounter(&counter);
+    }
+
+    lastFrame.frameSeconds = secondsSince(frameStart);
+    computeCriticalPath();
+}
+
+// Longest path through the dependency DAG, weighted by measured system time.
+void SystemScheduler::computeCriticalPath() {
+    std::vector<double> finish(systems.size(), 0.0);
+    std::vector<int32_t> previous(systems.size(), -1);
+    int32_t last = -1;
+
+    for (System_id id = 0; id < systems.size(); ++id) {
+        double start = 0.0;
+        for (System_id dep : systems[id].dependencies) {
+            if (finish[dep] > start) {
+                start = finish[dep];
+                previous[id] = static_cast<int32_t>(dep);
+            }
+        }
+        finish[id] = start + lastFrame.systems[id].seconds;
+        if (last < 0 || finish[id] > finish[last]) {
+            last = static_cast<int32_t>(id);
+        }
+    }
+
+    lastFrame.criticalPath.clear();
+    lastFrame.criticalPathSeconds = last < 0 ? 0.0 : finish[last];
+    for (int32_t id = last; id >= 0; id = previous[id]) {
+        lastFrame.criticalPath.push_back(static_cast<System_id>(id));
+    }
+    std::reverse(lastFrame.criticalPath.begin(), lastFrame.criticalPath.end());
+}
+
+void forEachChunk(EntityManager& entityManager, JobSystem* jobSystem,
+                  ComponentQuery query,
+                  const std::function<void(Archetype&, Chunk&)>& fn) {
+    const std::vector<Archetype*>& archetypes = entityManager.getArchetypes(query);
+
+    JobCounter counter = {};
+    for (Archetype* archetype : archetypes) {
+        for (Chunk* chunk : archetype->chunks) {
+            if (chunk->row == 0) continue;
+            if (!jobSystem) {
+                fn(*archetype, *chunk);
+                continue;
+            }
+            jobSystem->kickJob([&fn, archetype, chunk]() { fn(*archetype, *chunk); }, &counter);
+        }
+    }
+
+    if (jobSystem) {
+        jobSystem->waitForCounter(&counter);
+    }
+}
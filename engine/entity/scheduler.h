@@ -0,0 +1,98 @@
+#pragma once
+
+#include "entity.h"
+#include "../job_system.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+using System_id = std::uint32_t;
+
+/*
+ * Component access declared by a system. Two systems conflict when one writes
+ * a component the other reads or writes; non-conflicting systems may run at
+ * the same time.
+ */
+struct SystemAccess {
+    ComponentMask reads = 0;
+    ComponentMask writes = 0;
+};
+
+/*
+ * Builds a phased execution plan from declared component access and runs it on
+ * the JobSystem. Systems inside a phase run concurrently, phases are separated
+ * by a barrier, and conflicting systems keep their registration order.
+ *
+ * Systems must not create/destroy entities or change archetypes while the
+ * plan is running, and should only query archetypes with their declared
+ * (reads | writes) mask, which the scheduler warms up before each frame.
+ */
+class SystemScheduler {
+public:
+    using UpdateFn = std::function<void(EntityManager&, JobSystem*, float)>;
+
+    struct SystemTiming {
+        System_id id;
+        std::uint32_t phase;
+        double seconds;
+    };
+
+    struct FrameStats {
+        std::vector<SystemTiming> systems; // registration order
+        double frameSeconds = 0.0;         // wall time of run()
+        double criticalPathSeconds = 0.0;  // longest chain of dependent systems
+        std::vector<System_id> criticalPath; // first to last system on that chain
+    };
+
+    System_id registerSystem(std::string name, ComponentMask reads,
+                             ComponentMask writes, UpdateFn update);
+
+    // Registers a system type exposing static `reads`/`writes` masks and an
+    // update(EntityManager&, JobSystem*, float) member. The scheduler keeps a
+    // reference, so the system must outlive it.
+    template <typename System>
+    System_id registerSystem(std::string name, System& system) {
+        return registerSystem(std::move(name), System::reads, System::writes,
+                              [&system](EntityManager& em, JobSystem* jobSystem, float dt) {
+                                  system.update(em, jobSystem, dt);
+                              });
+    }
+
+    void run(EntityManager& entityManager, JobSystem* jobSystem, float deltaTime);
+
+    const std::vector<std::vector<System_id>>& getPhases();
+    const std::string& getSystemName(System_id id) const { return systems[id].name; }
+    std::size_t getSystemCount() const { return systems.size(); }
+    const FrameStats& getLastFrameStats() const { return lastFrame; }
+
+    static bool conflicts(const SystemAccess& a, const SystemAccess& b);
+
+private:
+    struct SystemEntry {
+        std::string name;
+        SystemAccess access;
+        UpdateFn update;
+        std::vector<System_id> dependencies; // earlier systems this one conflicts with
+        std::uint32_t phase = 0;
+    };
+
+    void buildPlan();
+    void computeCriticalPath();
+
+    std::vector<SystemEntry> systems;
+    std::vector<std::vector<System_id>> phases;
+    bool planDirty = true;
+    FrameStats lastFrame;
+};
+
+/*
+ * Calls fn for every non-empty chunk of the archetypes matching `query`,
+ * one job per chunk, and waits for all of them. Runs inline without a
+ * JobSystem. The scheduler only pre-warms plain read|write queries, so a
+ * system filtering with `without` should not first run that query from a
+ * concurrent phase.
+ */
+void forEachChunk(EntityManager& entityManager, JobSystem* jobSystem,
+                  ComponentQuery query,
+                  const std::function<void(Archetype&, Chunk&)>& fn);
@@ -1,54 +1,35 @@
-
 #include "systems.h"
-#include "../math/vector.hpp"
-
-
-
-constexpr float GRAVITY_ACCELERATION = 9.81f;
+#include "scheduler.h"
+#include "motion_kernels.h"
 
 void GravitySystem::update(EntityManager& entityManager, JobSystem* jobSystem, float deltaTime) {
-    ComponentMask requiredComponents = Components::Position | Components::Velocity | Components::Gravity;
-
-    std::vector<Archetype*> archetypes = 
-        entityManager.getAllArchetypesWithComponent(requiredComponents);
-    if (archetypes.empty()) return;
-
-    JobCounter counter = {};
-    for (Archetype* archetype : archetypes) {
-        uint32_t posOffset = archetype->offsets[componentMaskToIndex(Components::Position)];
-        uint32_t velOffset = archetype->offsets[componentMaskToIndex(Components::Velocity)];
-
-        // Iterate through all chunks in the archetype
-        for (Chunk* chunk : archetype->chunks) {
-            char* chunkData = (char*)chunk->data;
-            char* posBase = chunkData + posOffset;
-            char* velBase = chunkData + velOffset;
-            
+    ComponentMask requiredComponents = reads | writes;
+    const GravityKernels& kernels = getGravityKernels();
+    ComponentEventStream& events = entityManager.getEvents();
+    const bool observed = (events.getObserved() & writes) != 0;
+
+    // One job per chunk; chunks are independent so workers never share rows
+    forEachChunk(entityManager, jobSystem, requiredComponents,
+                 [&kernels, &events, observed, deltaTime](Archetype& archetype, Chunk& chunk) {
+        uint8_t posIndex = componentMaskToIndex(Components::Position);
+
+        if (archetype.lanes[posIndex] > 1) {
+            kernels.split(getVector3Streams(archetype, chunk, Components::Position),
+                          getVector3Streams(archetype, chunk, Components::Velocity),
+                          chunk.row, deltaTime);
+        } else {
             // Component arrays
-            Position* positions = (Position*)posBase;
-            Velocity* velocities = (Velocity*)velBase;
-            uint32_t entityCount = chunk->row;
-            
-            // Capture logic for the job
-            auto job = [positions, velocities, deltaTime, entityCount]() {
-                
-                for (uint32_t i = 0; i < entityCount; ++i) {
-                    mathplease::Vector4& pos = positions[i].value;
-                    mathplease::Vector4& vel = velocities[i].value;
-                    
-                    vel.y -= GRAVITY_ACCELERATION * deltaTime;
-                    
-                    pos.x += vel.x * deltaTime;
-                    pos.y += vel.y * deltaTime;
-                    pos.z += vel.z * deltaTime;
-                }
-            };
-            
-            // Kick the job
-            jobSystem->kickJob(job, &counter);
+            Position* positions = (Position*)archetype.column(chunk, posIndex);
+            Velocity* velocities =
+                (Velocity*)archetype.column(chunk, componentMaskToIndex(Components::Velocity));
+            kernels.interleaved(positions, velocities, chunk.row, deltaTime);
+        }
+
+        if (observed) {
+            const Entity_id* ids = (const Entity_id*)chunk.data;
+            for (uint32_t row = 0; row < chunk.row; ++row) {
+                events.record(ComponentEvent::OnSet, writes, ids[row]);
+            }
         }
-    }
-    
-    // Wait for all chunks to be processed
-    jobSystem->waitForCounter(&counter);
+    });
 }
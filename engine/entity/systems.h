@@ -7,7 +7,10 @@
 #include "../job_system.h" 
 
 struct GravitySystem {
+    static constexpr ComponentMask reads = Components::Gravity;
+    static constexpr ComponentMask writes = Components::Position | Components::Velocity;
+
     void update(EntityManager& entityManager, JobSystem* jobSystem, float deltaTime);
 };
 
-#endif // ENTITY_SYSTEMS_H
\ No newline at end of file
+#endif // ENTITY_SYSTEMS_H
@@ -0,0 +1,340 @@
+#include "world_snapshot.h"
+#include "../logger.h"
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+constexpr std::uint32_t SNAPSHOT_MAGIC = 0x4C574C44; // LWLD
+constexpr std::uint32_t SNAPSHOT_VERSION = 3;
+constexpr std::uint64_t SNAPSHOT_DATA_ALIGNMENT = 4096;
+
+struct SnapshotHeader {
+    std::uint32_t magic = SNAPSHOT_MAGIC;
+    std::uint32_t version = SNAPSHOT_VERSION;
+    std::uint32_t chunkSize = 0;
+    std::uint32_t archetypeCount = 0;
+    std::uint32_t chunkCount = 0;
+    std::uint32_t entityRecordCount = 0;
+    std::uint32_t freeIdCount = 0;
+    std::uint32_t entityCount = 0;
+    std::uint32_t nextEntityId = 0;
+    std::uint32_t relationCount = 0;
+    std::uint64_t dataOffset = 0;
+};
+
+struct SnapshotArchetype {
+    std::uint32_t componentMask = 0;
+    std::uint32_t chunkCapacity = 0;
+    std::uint64_t rowSize = 0;
+    std::uint32_t offsets[sizeof(ComponentMask) * 8] = {};
+    std::uint32_t sizes[sizeof(ComponentMask) * 8] = {};
+    std::uint8_t lanes[sizeof(ComponentMask) * 8] = {};
+};
+
+struct SnapshotChunk {
+    std::uint32_t archetypeIndex = 0;
+    std::uint32_t rowCount = 0;
+};
+
+struct SnapshotRelation {
+    std::uint32_t relation = 0;
+    Entity_id holder = 0;
+    Entity_id member = 0;
+};
+
+std::uint64_t alignUp64(std::uint64_t value, std::uint64_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// Sinks/sources let the memory and file paths share one serialiser.
+struct MemorySink {
+    std::vector<std::byte>& bytes;
+    void write(const void* src, std::size_t size) {
+        const std::size_t at = bytes.size();
+        bytes.resize(at + size);
+        std::memcpy(bytes.data() + at, src, size);
+    }
+    void pad(std::size_t size) { bytes.resize(bytes.size() + size); }
+};
+
+struct FileSink {
+    std::ofstream& out;
+    void write(const void* src, std::size_t size) {
+        out.write(static_cast<const char*>(src), static_cast<std::streamsize>(size));
+    }
+    void pad(std::size_t size) {
+        static const char zeros[SNAPSHOT_DATA_ALIGNMENT] = {};
+        out.write(zeros, static_cast<std::streamsize>(size));
+    }
+};
+
+struct MemorySource {
+    const std::vector<std::byte>& bytes;
+    std::size_t cursor = 0;
+    bool read(void* dst, std::size_t size) {
+        if (cursor + size > bytes.size()) return false;
+        std::memcpy(dst, bytes.data() + cursor, size);
+        cursor += size;
+        return true;
+    }
+    bool seek(std::uint64_t position) {
+        if (position > bytes.size()) return false;
+        cursor = static_cast<std::size_t>(position);
+        return true;
+    }
+    std::uint64_t size() const { return bytes.size(); }
+};
+
+struct FileSource {
+    std::ifstream& in;
+    bool read(void* dst, std::size_t size) {
+        in.read(static_cast<char*>(dst), static_cast<std::streamsize>(size));
+        return static_cast<bool>(in);
+    }
+    bool seek(std::uint64_t position) {
+        in.seekg(static_cast<std::streamoff>(position));
+        return static_cast<bool>(in);
+    }
+    std::uint64_t size() {
+        const std::streampos at = in.tellg();
+        in.seekg(0, std::ios::end);
+        const std::streampos end = in.tellg();
+        in.seekg(at);
+        return end < 0 ? 0 : static_cast<std::uint64_t>(end);
+    }
+};
+
+} // namespace
+
+template <typename Sink>
+void WorldSnapshot::write(const EntityManager& em, Sink& sink) {
+    SnapshotHeader header;
+    header.chunkSize = static_cast<std::uint32_t>(EntityManager::CHUNK_SIZE);
+    header.archetypeCount = static_cast<std::uint32_t>(em.existingArchetypes.size());
+    header.entityRecordCount = static_cast<std::uint32_t>(em.entityRecords.size());
+    header.freeIdCount = static_cast<std::uint32_t>(em.freeEntityIds.size());
+    header.entityCount = em.entityCount;
+    header.nextEntityId = em.nextEntityId;
+    for (const auto& arch : em.existingArchetypes) {
+        header.chunkCount += static_cast<std::uint32_t>(arch->chunks.size());
+    }
+    for (const RelationStore& store : em.relations) {
+        header.relationCount += store.getPairCount();
+    }
+
+    const std::uint64_t metadataSize = sizeof(SnapshotHeader) +
+        sizeof(SnapshotArchetype) * header.archetypeCount +
+        sizeof(SnapshotChunk) * header.chunkCount +
+        sizeof(std::uint32_t) * header.freeIdCount +
+        sizeof(SnapshotRelation) * header.relationCount;
+    header.dataOffset = alignUp64(metadataSize, SNAPSHOT_DATA_ALIGNMENT);
+    sink.write(&header, sizeof(header));
+
+    for (const auto& arch : em.existingArchetypes) {
+        SnapshotArchetype desc;
+        desc.componentMask = arch->componentMask;
+        desc.chunkCapacity = arch->chunkCapacity;
+        desc.rowSize = arch->rowSize;
+        for (int i = 0; i < 16; ++i) {
+            desc.offsets[i] = arch->offsets[i];
+            desc.sizes[i] = static_cast<std::uint32_t>(arch->sizes[i]);
+            desc.lanes[i] = arch->lanes[i];
+        }
+        sink.write(&desc, sizeof(desc));
+    }
+
+    for (std::uint32_t a = 0; a < header.archetypeCount; ++a) {
+        for (const Chunk* chunk : em.existingArchetypes[a]->chunks) {
+            SnapshotChunk desc{a, chunk->row};
+            sink.write(&desc, sizeof(desc));
+        }
+    }
+
+    sink.write(em.freeEntityIds.data(), sizeof(std::uint32_t) * header.freeIdCount);
+    for (std::uint32_t r = 0; r < static_cast<std::uint32_t>(Relation::Count); ++r) {
+        em.relations[r].forEachPair([&sink, r](Entity_id holder, Entity_id member) {
+            SnapshotRelation desc{r, holder, member};
+            sink.write(&desc, sizeof(desc));
+        });
+    }
+    sink.pad(static_cast<std::size_t>(header.dataOffset - metadataSize));
+
+    for (const auto& arch : em.existingArchetypes) {
+        for (const Chunk* chunk : arch->chunks) {
+            sink.write(chunk->data, EntityManager::CHUNK_SIZE);
+        }
+    }
+}
+
+template <typename Source>
+bool WorldSnapshot::read(EntityManager& em, Source& source) {
+    SnapshotHeader header;
+    if (!source.read(&header, sizeof(header)) || header.magic != SNAPSHOT_MAGIC ||
+        header.version != SNAPSHOT_VERSION ||
+        header.chunkSize != EntityManager::CHUNK_SIZE ||
+        header.entityRecordCount > BITMASK_INDEX + 1) {
+        LOG_ERR("SNAPSHOT", "Invalid world snapshot header");
+        return false;
+    }
+
+    // The counts size the allocations below, so check them against the
+    // snapshot's length first; a corrupt header must not request gigabytes.
+    // Each count is 32-bit, so none of these sums can overflow 64 bits.
+    const std::uint64_t tableBytes = std::uint64_t(header.archetypeCount) * sizeof(SnapshotArchetype) +
+                                     std::uint64_t(header.chunkCount) * sizeof(SnapshotChunk) +
+                                     std::uint64_t(header.freeIdCount) * sizeof(std::uint32_t) +
+                                     std::uint64_t(header.relationCount) * sizeof(SnapshotRelation);
+    const std::uint64_t totalBytes = source.size();
+    if (header.dataOffset < sizeof(SnapshotHeader) + tableBytes || header.dataOffset > totalBytes ||
+        std::uint64_t(header.chunkCount) * EntityManager::CHUNK_SIZE > totalBytes - header.dataOffset ||
+        header.freeIdCount > header.entityRecordCount) {
+        LOG_ERR("SNAPSHOT", "World snapshot counts do not match its size");
+        return false;
+    }
+
+    std::vector<SnapshotArchetype> archetypeDescs(header.archetypeCount);
+    std::vector<SnapshotChunk> chunkDescs(header.chunkCount);
+    std::vector<std::uint32_t> freeIds(header.freeIdCount);
+    std::vector<SnapshotRelation> relationDescs(header.relationCount);
+    if (!source.read(archetypeDescs.data(), sizeof(SnapshotArchetype) * archetypeDescs.size()) ||
+        !source.read(chunkDescs.data(), sizeof(SnapshotChunk) * chunkDescs.size()) ||
+        !source.read(freeIds.data(), sizeof(std::uint32_t) * freeIds.size()) ||
+        !source.read(relationDescs.data(), sizeof(SnapshotRelation) * relationDescs.size()) ||
+        !source.seek(header.dataOffset)) {
+        LOG_ERR("SNAPSHOT", "Truncated world snapshot");
+        return false;
+    }
+
+    em.clear();
+
+    // Recreate archetypes through the normal path and verify the layouts
+    // match what was written; chunk bytes are only meaningful if they do.
+    std::vector<Archetype*> archetypes;
+    archetypes.reserve(archetypeDescs.size());
+    for (const SnapshotArchetype& desc : archetypeDescs) {
+        Archetype* arch = em.getOrCreateArchetype(static_cast<ComponentMask>(desc.componentMask));
+        bool compatible = arch->chunkCapacity == desc.chunkCapacity &&
+                          arch->rowSize == desc.rowSize;
+        for (int i = 0; i < 16 && compatible; ++i) {
+            compatible = arch->offsets[i] == desc.offsets[i] && arch->sizes[i] == desc.sizes[i] &&
+                         arch->lanes[i] == desc.lanes[i];
+        }
+        if (!compatible) {
+            LOG_ERR("SNAPSHOT", "Archetype layout mismatch for mask {}", desc.componentMask);
+            em.clear();
+            return false;
+        }
+        archetypes.push_back(arch);
+    }
+
+    for (const SnapshotChunk& desc : chunkDescs) {
+        if (desc.archetypeIndex >= archetypes.size()) {
+            em.clear();
+            return false;
+        }
+        Archetype* arch = archetypes[desc.archetypeIndex];
+        void* chunkData = em.chunkAllocator.allocate();
+        if (!chunkData) {
+            LOG_ERR("SNAPSHOT", "Out of chunk memory while loading snapshot");
+            em.clear();
+            return false;
+        }
+
+        Chunk* chunk = new Chunk();
+        chunk->data = chunkData;
+        chunk->row = desc.rowCount;
+        chunk->capacity = arch->chunkCapacity;
+        chunk->archetype = arch;
+        chunk->indexInArchetype = static_cast<std::uint32_t>(arch->chunks.size());
+        arch->chunks.push_back(chunk);
+
+        if (!source.read(chunkData, EntityManager::CHUNK_SIZE) || chunk->row > chunk->capacity) {
+            LOG_ERR("SNAPSHOT", "Truncated chunk data in world snapshot");
+            em.clear();
+            return false;
+        }
+    }
+
+    // Pointer fix-up: every live entity is listed in the id column of its
+    // chunk, exactly once
+    em.entityRecords.assign(header.entityRecordCount, EntityData{});
+    std::uint64_t restoredRows = 0;
+    for (Archetype* arch : archetypes) {
+        for (Chunk* chunk : arch->chunks) {
+            const Entity_id* ids = static_cast<const Entity_id*>(chunk->data);
+            for (std::uint32_t row = 0; row < chunk->row; ++row) {
+                const std::uint32_t index = ids[row] & BITMASK_INDEX;
+                if (index >= em.entityRecords.size()) {
+                    em.clear();
+                    return false;
+                }
+                EntityData& record = em.entityRecords[index];
+                if (record.archetype) {
+                    LOG_ERR("SNAPSHOT", "Entity index {} appears twice in world snapshot", index);
+                    em.clear();
+                    return false;
+                }
+                record.archetype = arch;
+                record.chunk = chunk;
+                record.row = row;
+                record.id = ids[row];
+            }
+            restoredRows += chunk->row;
+        }
+    }
+    if (restoredRows != header.entityCount) {
+        LOG_ERR("SNAPSHOT", "World snapshot lists {} entities but its chunks hold {}", header.entityCount,
+                restoredRows);
+        em.clear();
+        return false;
+    }
+
+    for (const SnapshotRelation& desc : relationDescs) {
+        if (desc.relation >= static_cast<std::uint32_t>(Relation::Count) ||
+            !em.isAlive(desc.holder) || !em.isAlive(desc.member)) {
+            LOG_ERR("SNAPSHOT", "Invalid relation in world snapshot");
+            em.clear();
+            return false;
+        }
+        em.relations[desc.relation].add(desc.holder, desc.member);
+    }
+
+    em.freeEntityIds = std::move(freeIds);
+    em.entityCount = header.entityCount;
+    em.nextEntityId = header.nextEntityId;
+    return true;
+}
+
+std::vector<std::byte> WorldSnapshot::capture(const EntityManager& entityManager) {
+    std::vector<std::byte> bytes;
+    MemorySink sink{bytes};
+    WorldSnapshot::write(entityManager, sink);
+    return bytes;
+}
+
+bool WorldSnapshot::restore(EntityManager& entityManager, const std::vector<std::byte>& snapshot) {
+    MemorySource source{snapshot};
+    return WorldSnapshot::read(entityManager, source);
+}
+
+bool WorldSnapshot::saveToFile(const EntityManager& entityManager, const std::filesystem::path& path) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        LOG_ERR("SNAPSHOT", "Failed to open {} for writing", path.string());
+        return false;
+    }
+    FileSink sink{out};
+    WorldSnapshot::write(entityManager, sink);
+    return static_cast<bool>(out);
+}
+
+bool WorldSnapshot::loadFromFile(EntityManager& entityManager, const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        LOG_ERR("SNAPSHOT", "Failed to open {} for reading", path.string());
+        return false;
+    }
+    FileSource source{in};
+    return WorldSnapshot::read(entityManager, source);
+}
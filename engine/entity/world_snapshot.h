@@ -0,0 +1,44 @@
+#pragma once
+
+#include "entity.h"
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+/*
+ * Binary snapshot of an EntityManager. The format is the archetype layout
+ * descriptors followed by the raw 16 KB chunk blocks, so saving and loading
+ * are a handful of bulk copies plus a linear pass that rebuilds entity
+ * records (pointer fix-up) from the id column of every chunk.
+ *
+ * File layout (little endian, native struct packing):
+ *   SnapshotHeader
+ *   SnapshotArchetype[archetypeCount]
+ *   SnapshotChunk[chunkCount]
+ *   uint32_t freeEntityIds[freeIdCount]
+ *   SnapshotRelation[relationCount]    (relation, holder, member)
+ *   padding up to dataOffset (page aligned so chunk data can be mapped)
+ *   chunk blocks, CHUNK_SIZE bytes each, in SnapshotChunk order
+ *
+ * Loading requires the component registry and ColumnLayout to produce the
+ * same layouts as the world that wrote the snapshot; mismatches fail the load instead of producing
+ * garbage. Restoring replaces the target world entirely, and any archetype
+ * vectors previously returned by getAllArchetypesWithComponent are invalid
+ * afterwards.
+ */
+class WorldSnapshot {
+public:
+    /** Serialises the whole world into memory (rollback, cloning) */
+    static std::vector<std::byte> capture(const EntityManager& entityManager);
+    /** Replaces the world with a captured snapshot. Returns false on a bad or incompatible snapshot */
+    static bool restore(EntityManager& entityManager, const std::vector<std::byte>& snapshot);
+
+    static bool saveToFile(const EntityManager& entityManager, const std::filesystem::path& path);
+    static bool loadFromFile(EntityManager& entityManager, const std::filesystem::path& path);
+
+private:
+    template <typename Sink>
+    static void write(const EntityManager& entityManager, Sink& sink);
+    template <typename Source>
+    static bool read(EntityManager& entityManager, Source& source);
+};
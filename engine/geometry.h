@@ -1,8 +1,11 @@
 #pragma once
 
 #include <vulkan/vulkan.h>
+#include <algorithm>
 #include <array>
+#include <span>
 #include "math/vector.hpp"
+#include "math/vertex_packing.hpp"
 
 struct Vertex {
     mathplease::Vector3 pos;     // Position
@@ -53,6 +56,152 @@ struct Vertex {
     }
 };
 
+/*
+ * Vertex with packed attributes: 24 bytes instead of 44. The vertex shader
+ * reads the colour and uv as vec4/vec2 directly and unfolds the octahedral
+ * normal (see mathplease::decodeOctahedral):
+ *     vec3 n = vec3(inNormal, 1.0 - abs(inNormal.x) - abs(inNormal.y));
+ *     float t = max(-n.z, 0.0);
+ *     n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0.0)));
+ *     n = normalize(n);
+ */
+struct PackedVertex {
+    mathplease::Vector3 pos;  // Position
+    uint32_t colour;          // RGBA8 unorm, alpha 1
+    uint32_t normal;          // Octahedral snorm16x2
+    mathplease::Half2 uv;     // Half float texture coordinates
+
+    static VkVertexInputBindingDescription getBindingDescription() {
+        VkVertexInputBindingDescription bindingDescription{};
+        bindingDescription.binding = 0;
+        bindingDescription.stride = sizeof(PackedVertex);
+        bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+        return bindingDescription;
+    }
+
+    static std::array<VkVertexInputAttributeDescription, 4> getAttributeDescriptions() {
+        std::array<VkVertexInputAttributeDescription, 4> attributeDescriptions{};
+
+        // Position: Location 0
+        attributeDescriptions[0].binding = 0;
+        attributeDescriptions[0].location = 0;
+        attributeDescriptions[0].format = VK_FORMAT_R32G32B32_SFLOAT;
+        attributeDescriptions[0].offset = offsetof(PackedVertex, pos);
+
+        // Colour: Location 1
+        attributeDescriptions[1].binding = 0;
+        attributeDescriptions[1].location = 1;
+        attributeDescriptions[1].format = VK_FORMAT_R8G8B8A8_UNORM;
+        attributeDescriptions[1].offset = offsetof(PackedVertex, colour);
+
+        // Normal: Location 2
+        attributeDescriptions[2].binding = 0;
+        attributeDescriptions[2].location = 2;
+        attributeDescriptions[2].format = VK_FORMAT_R16G16_SNORM;
+        attributeDescriptions[2].offset = offsetof(PackedVertex, normal);
+
+        // UVs: Location 3
+        attributeDescriptions[3].binding = 0;
+        attributeDescriptions[3].location = 3;
+        attributeDescriptions[3].format = VK_FORMAT_R16G16_SFLOAT;
+        attributeDescriptions[3].offset = offsetof(PackedVertex, uv);
+
+        return attributeDescriptions;
+    }
+};
+static_assert(sizeof(PackedVertex) == 24);
+
+/*
+ * PackedVertex with the position quantised to the mesh bounds as well: 20
+ * bytes. The shader gets the position as a fraction of the bounds and
+ * rebuilds it with the PositionQuantization the mesh was packed with:
+ *     vec3 position = offset + inPosition.xyz * extent;
+ */
+struct QuantizedVertex {
+    mathplease::Unorm16x4 pos;  // Position, unorm16 within the mesh bounds
+    uint32_t colour;            // RGBA8 unorm, alpha 1
+    uint32_t normal;            // Octahedral snorm16x2
+    mathplease::Half2 uv;       // Half float texture coordinates
+
+    static VkVertexInputBindingDescription getBindingDescription() {
+        VkVertexInputBindingDescription bindingDescription{};
+        bindingDescription.binding = 0;
+        bindingDescription.stride = sizeof(QuantizedVertex);
+        bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+        return bindingDescription;
+    }
+
+    static std::array<VkVertexInputAttributeDescription, 4> getAttributeDescriptions() {
+        std::array<VkVertexInputAttributeDescription, 4> attributeDescriptions{};
+
+        // Position: Location 0
+        attributeDescriptions[0].binding = 0;
+        attributeDescriptions[0].location = 0;
+        attributeDescriptions[0].format = VK_FORMAT_R16G16B16A16_UNORM;
+        attributeDescriptions[0].offset = offsetof(QuantizedVertex, pos);
+
+        // Colour: Location 1
+        attributeDescriptions[1].binding = 0;
+        attributeDescriptions[1].location = 1;
+        attributeDescriptions[1].format = VK_FORMAT_R8G8B8A8_UNORM;
+        attributeDescriptions[1].offset = offsetof(QuantizedVertex, colour);
+
+        // Normal: Location 2
+        attributeDescriptions[2].binding = 0;
+        attributeDescriptions[2].location = 2;
+        attributeDescriptions[2].format = VK_FORMAT_R16G16_SNORM;
+        attributeDescriptions[2].offset = offsetof(QuantizedVertex, normal);
+
+        // UVs: Location 3
+        attributeDescriptions[3].binding = 0;
+        attributeDescriptions[3].location = 3;
+        attributeDescriptions[3].format = VK_FORMAT_R16G16_SFLOAT;
+        attributeDescriptions[3].offset = offsetof(QuantizedVertex, uv);
+
+        return attributeDescriptions;
+    }
+};
+static_assert(sizeof(QuantizedVertex) == 20);
+
+/* Converts min(in.size(), out.size()) vertices; normals must be unit length */
+inline void packVertices(std::span<const Vertex> in, std::span<PackedVertex> out) {
+    const size_t count = std::min(in.size(), out.size());
+    if (count == 0) return;
+    for (size_t i = 0; i < count; ++i) out[i].pos = in[i].pos;
+    mathplease::packColours({&in[0].colour, sizeof(Vertex)}, {&out[0].colour, sizeof(PackedVertex)}, count);
+    mathplease::encodeOctahedral({&in[0].normal, sizeof(Vertex)}, {&out[0].normal, sizeof(PackedVertex)}, count);
+    mathplease::encodeHalf2({&in[0].uv, sizeof(Vertex)}, {&out[0].uv, sizeof(PackedVertex)}, count);
+}
+
+inline void packVertices(std::span<const Vertex> in, const mathplease::PositionQuantization& quantization,
+                         std::span<QuantizedVertex> out) {
+    const size_t count = std::min(in.size(), out.size());
+    if (count == 0) return;
+    mathplease::quantizePositions(quantization, {&in[0].pos, sizeof(Vertex)}, {&out[0].pos, sizeof(QuantizedVertex)}, count);
+    mathplease::packColours({&in[0].colour, sizeof(Vertex)}, {&out[0].colour, sizeof(QuantizedVertex)}, count);
+    mathplease::encodeOctahedral({&in[0].normal, sizeof(Vertex)}, {&out[0].normal, sizeof(QuantizedVertex)}, count);
+    mathplease::encodeHalf2({&in[0].uv, sizeof(Vertex)}, {&out[0].uv, sizeof(QuantizedVertex)}, count);
+}
+
+inline void unpackVertices(std::span<const PackedVertex> in, std::span<Vertex> out) {
+    const size_t count = std::min(in.size(), out.size());
+    if (count == 0) return;
+    for (size_t i = 0; i < count; ++i) out[i].pos = in[i].pos;
+    mathplease::unpackColours({&in[0].colour, sizeof(PackedVertex)}, {&out[0].colour, sizeof(Vertex)}, count);
+    mathplease::decodeOctahedral({&in[0].normal, sizeof(PackedVertex)}, {&out[0].normal, sizeof(Vertex)}, count);
+    mathplease::decodeHalf2({&in[0].uv, sizeof(PackedVertex)}, {&out[0].uv, sizeof(Vertex)}, count);
+}
+
+inline void unpackVertices(std::span<const QuantizedVertex> in, const mathplease::PositionQuantization& quantization,
+                           std::span<Vertex> out) {
+    const size_t count = std::min(in.size(), out.size());
+    if (count == 0) return;
+    mathplease::dequantizePositions(quantization, {&in[0].pos, sizeof(QuantizedVertex)}, {&out[0].pos, sizeof(Vertex)}, count);
+    mathplease::unpackColours({&in[0].colour, sizeof(QuantizedVertex)}, {&out[0].colour, sizeof(Vertex)}, count);
+    mathplease::decodeOctahedral({&in[0].normal, sizeof(QuantizedVertex)}, {&out[0].normal, sizeof(Vertex)}, count);
+    mathplease::decodeHalf2({&in[0].uv, sizeof(QuantizedVertex)}, {&out[0].uv, sizeof(Vertex)}, count);
+}
+
 namespace std {
     template<> struct hash<Vertex> {
         size_t operator()(Vertex const& vertex) const {
@@ -1,7 +1,55 @@
 #include "job_system.h"
 #include "logger.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <new>
 #include <thread>
 
+struct JobSystem::WorkerScratch {
+    explicit WorkerScratch(size_t bytes) : arena(bytes, MemoryTag::Jobs) {}
+
+    LinearAllocator arena;
+    // written by the owning worker, read by getScratchStats()
+    std::atomic<size_t> peakUsed{0};
+    std::atomic<size_t> overflowAllocations{0};
+    std::atomic<size_t> overflowBytes{0};
+};
+
+/*
+ * Per-thread scratch state. worker is the arena of the JobSystem worker
+ * running on this thread, null elsewhere. Heap fallbacks are kept in order
+ * so each scope frees exactly the ones it made.
+ */
+struct JobSystem::ScratchContext {
+    struct HeapBlock {
+        void* memory;
+        std::align_val_t alignment;
+    };
+
+    WorkerScratch* worker = nullptr;
+    std::vector<HeapBlock> overflow;
+    uint32_t depth = 0;
+};
+
+JobSystem::ScratchContext& JobSystem::threadScratch() {
+    thread_local ScratchContext context;
+    return context;
+}
+
+namespace {
+// Spin-wait hint; keeps the waiting core from hammering the queue lock.
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ volatile("yield");
+#endif
+}
+} // namespace
+
+JobSystem::JobSystem() = default;
+
 JobSystem::~JobSystem() {
     isRunning = false;
     activeCondition.notify_all();
@@ -12,7 +60,80 @@ JobSystem::~JobSystem() {
     }
 }
 
-void JobSystem::initialize(uint32_t threadCount) {
+JobSystem::ScratchScope::ScratchScope() {
+    ScratchContext& context = threadScratch();
+    marker = context.worker ? context.worker->arena.getMarker() : 0;
+    overflowCount = context.overflow.size();
+    context.depth++;
+}
+
+JobSystem::ScratchScope::~ScratchScope() {
+    ScratchContext& context = threadScratch();
+    while (context.overflow.size() > overflowCount) {
+        ::operator delete(context.overflow.back().memory, context.overflow.back().alignment);
+        context.overflow.pop_back();
+    }
+    if (context.worker) {
+        LinearAllocator& arena = context.worker->arena;
+        context.worker->peakUsed.store(arena.getPeakUsed(), std::memory_order_relaxed);
+        arena.freeToMarker(marker);
+    }
+    context.depth--;
+}
+
+void* JobSystem::scratchAllocate(size_t size, size_t alignment) {
+    ScratchContext& context = threadScratch();
+    assert(context.depth > 0 && "scratch memory needs an enclosing ScratchScope");
+    if (context.worker) {
+        if (void* memory = context.worker->arena.allocate(size, alignment)) {
+            return memory;
+        }
+        context.worker->overflowAllocations.fetch_add(1, std::memory_order_relaxed);
+        context.worker->overflowBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    const std::align_val_t heapAlignment{std::max(alignment, alignof(std::max_align_t))};
+    context.overflow.reserve(context.overflow.size() + 1); // so the push cannot throw and leak
+    void* memory = ::operator new(size, heapAlignment);
+    context.overflow.push_back({memory, heapAlignment});
+    return memory;
+}
+
+void JobSystem::scratchFree(void* memory) {
+    if (!memory) return;
+    ScratchContext& context = threadScratch();
+    if (context.worker && context.worker->arena.owns(memory)) {
+        return; // reclaimed with its scope
+    }
+    // recent heap blocks go straight back (containers free their old buffer
+    // right after growing); older ones wait for their scope, which keeps
+    // this cheap when many blocks are freed out of order
+    constexpr size_t RECENT_BLOCKS = 8;
+    const size_t oldest = context.overflow.size() > RECENT_BLOCKS ? context.overflow.size() - RECENT_BLOCKS : 0;
+    for (size_t i = context.overflow.size(); i-- > oldest;) {
+        if (context.overflow[i].memory == memory) {
+            ::operator delete(memory, context.overflow[i].alignment);
+            context.overflow.erase(context.overflow.begin() + static_cast<std::ptrdiff_t>(i));
+            return;
+        }
+    }
+}
+
+std::vector<JobSystem::ScratchStats> JobSystem::getScratchStats() const {
+    std::vector<ScratchStats> stats;
+    stats.reserve(scratch.size());
+    for (const auto& worker : scratch) {
+        ScratchStats entry;
+        entry.capacity = worker->arena.getCapacity();
+        entry.peakUsed = worker->peakUsed.load(std::memory_order_relaxed);
+        entry.overflowAllocations = worker->overflowAllocations.load(std::memory_order_relaxed);
+        entry.overflowBytes = worker->overflowBytes.load(std::memory_order_relaxed);
+        stats.push_back(entry);
+    }
+    return stats;
+}
+
+void JobSystem::initialize(uint32_t threadCount, size_t scratchBytes) {
     if (isRunning) return; // Already initialized
 
     if (threadCount == 0) {
@@ -25,6 +146,10 @@ void JobSystem::initialize(uint32_t threadCount) {
 
     isRunning = true;
     workers.reserve(threadCount);
+    scratch.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i) {
+        scratch.push_back(std::make_unique<WorkerScratch>(scratchBytes));
+    }
     
     LOG_INFO("JOB_SYSTEM", "Initializing with {} threads", threadCount);
 
@@ -46,14 +171,21 @@ void JobSystem::kickJob(const std::function<void()>& job, JobCounter* counter) {
 }
 
 void JobSystem::kickJobs(uint32_t count, const std::function<void(uint32_t)>& job, JobCounter* counter) {
+    if (count == 0) return;
 
-    uint32_t jobCount = count;
-    
-    // Batching heuristic
-    
-    for (uint32_t i = 0; i < count; ++i) {
+    // Batching heuristic: a few contiguous ranges per worker so the queue lock
+    // and std::function wrapping are paid per batch, not per item, while
+    // still leaving room to balance uneven items.
+    const uint32_t workerCount = std::max<uint32_t>(1, static_cast<uint32_t>(workers.size()));
+    const uint32_t jobCount = std::min(count, workerCount * JOBS_PER_WORKER);
+    const uint32_t batchSize = (count + jobCount - 1) / jobCount;
+
+    for (uint32_t begin = 0; begin < count; begin += batchSize) {
+        const uint32_t end = std::min(count, begin + batchSize);
         // Capture by value is important here
-        kickJob([job, i]() { job(i); }, counter);
+        kickJob([job, begin, end]() {
+            for (uint32_t i = begin; i < end; ++i) job(i);
+        }, counter);
     }
 }
 
@@ -70,7 +202,7 @@ void JobSystem::waitForCounter(JobCounter* counter) {
         }
 
         if (spin < SPIN_ITERS) {
-            __asm__ volatile("yield");
+            cpuRelax();
             ++spin;
         } else {
             std::this_thread::yield(); // fallback if truly starved
@@ -88,8 +220,11 @@ bool JobSystem::tryExecuteJob() {
         jobQueue.pop_front();
     }
 
-    // Execute
-    job.task();
+    // Execute; scratch memory the job took is released when it returns
+    {
+        ScratchScope jobScratch;
+        job.task();
+    }
 
     // Decrement counter
     if (job.counter) {
@@ -100,6 +235,7 @@ bool JobSystem::tryExecuteJob() {
 }
 
 void JobSystem::workerLoop(uint32_t threadIndex) {
+    threadScratch().worker = scratch[threadIndex].get();
     while (isRunning) {
         Job job;
         {
@@ -121,7 +257,10 @@ void JobSystem::workerLoop(uint32_t threadIndex) {
         }
 
         // Execute
-        job.task();
+        {
+            ScratchScope jobScratch;
+            job.task();
+        }
         
         // Decrement counter
         if (job.counter) {
@@ -6,7 +6,9 @@
 #include <thread>
 #include <condition_variable>
 #include <deque>
+#include <memory>
 #include <mutex>
+#include "memory/linear_allocator.h"
 
 struct JobCounter {
     std::atomic<int> counter{0};
@@ -14,10 +16,67 @@ struct JobCounter {
 
 class JobSystem {
 public:
-    JobSystem() = default;
+    static constexpr size_t DEFAULT_SCRATCH_BYTES = 1024 * 1024;
+
+    // Scratch usage of one worker since initialize()
+    struct ScratchStats {
+        size_t capacity = 0;
+        size_t peakUsed = 0;            // arena high-water mark
+        size_t overflowAllocations = 0; // requests the arena could not fit
+        size_t overflowBytes = 0;
+    };
+
+    /*
+     * Lifetime of scratch memory: everything the calling thread takes with
+     * scratchAllocate() after construction is released on destruction.
+     * Every job runs inside one, so jobs only need their own for memory
+     * they want back before returning, or when they may also run off the
+     * job system.
+     */
+    class ScratchScope {
+    public:
+        ScratchScope();
+        ~ScratchScope();
+        ScratchScope(const ScratchScope&) = delete;
+        ScratchScope& operator=(const ScratchScope&) = delete;
+    private:
+        LinearAllocator::Marker marker;
+        size_t overflowCount;
+    };
+
+    // std allocator over scratch memory, for containers local to a scope
+    template <typename T>
+    struct ScratchAllocator {
+        using value_type = T;
+        ScratchAllocator() = default;
+        template <typename U>
+        ScratchAllocator(const ScratchAllocator<U>&) {}
+        T* allocate(size_t count) {
+            return static_cast<T*>(scratchAllocate(sizeof(T) * count, alignof(T)));
+        }
+        void deallocate(T* items, size_t) { scratchFree(items); }
+        template <typename U>
+        bool operator==(const ScratchAllocator<U>&) const { return true; }
+    };
+    template <typename T>
+    using ScratchVector = std::vector<T, ScratchAllocator<T>>;
+
+    JobSystem();
     ~JobSystem();
 
-    void initialize(uint32_t threadCount = 0);
+    // Each worker gets a scratchBytes arena; 0 threads means one per core
+    void initialize(uint32_t threadCount = 0, size_t scratchBytes = DEFAULT_SCRATCH_BYTES);
+
+    /*
+     * Temporary memory for the calling thread, valid until the innermost
+     * ScratchScope (at the latest, the running job) ends. It comes from the
+     * worker's arena, or from the heap when the arena is full or the thread
+     * is not a worker of any JobSystem. Must be called inside a scope.
+     */
+    static void* scratchAllocate(size_t size, size_t alignment = alignof(std::max_align_t));
+    // Optional early release of recent heap fallbacks; everything else is
+    // reclaimed by its scope
+    static void scratchFree(void* memory);
     
     // Kick a job. 
     // If counter is provided, it must be initialized (usually to 0, or result of previous adds).
@@ -25,14 +84,22 @@ public:
     void kickJob(const std::function<void()>& job, JobCounter* counter = nullptr);
     
     // Kick a set of jobs (Parallel For)
-    // Divides 'count' items among threads.
+    // Divides 'count' items into contiguous batches, a few per worker thread.
+    // The counter is incremented once per batch, not per item.
     void kickJobs(uint32_t count, const std::function<void(uint32_t)>& job, JobCounter* counter = nullptr);
 
     // Wait for a counter to reach zero.
     // While waiting, the calling thread will help execute jobs to prevent deadlocks.
     void waitForCounter(JobCounter* counter);
 
+    uint32_t getThreadCount() const { return static_cast<uint32_t>(workers.size()); }
+
+    // One entry per worker, in thread index order
+    std::vector<ScratchStats> getScratchStats() const;
+
 private:
+    static constexpr uint32_t JOBS_PER_WORKER = 4;
+
     void workerLoop(uint32_t threadIndex);
 
     // Execute one job from queue. Returns true if job executed.
@@ -44,7 +111,12 @@ private:
         JobCounter* counter = nullptr;
     };
 
+    struct WorkerScratch;
+    struct ScratchContext;
+    static ScratchContext& threadScratch();
+
     std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<WorkerScratch>> scratch;
     std::deque<Job> jobQueue;
     std::mutex queueMutex;
     std::condition_variable activeCondition;
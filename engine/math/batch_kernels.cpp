@@ -0,0 +1,230 @@
+#include "batch_kernels.hpp"
+#include "../job_system.h"
+#include <algorithm>
+#include <cmath>
+
+namespace mathplease {
+
+static_assert(sizeof(Vector3) == 3 * sizeof(float), "kernels read Vector3 arrays as packed xyz floats");
+static_assert(sizeof(AABB) == 6 * sizeof(float), "kernels read AABB arrays as packed xyz floats");
+
+namespace {
+
+constexpr size_t MIN_ELEMENTS_PER_JOB = 16384;
+
+/*
+ * Runs kernel(begin, end) over [0, count), inline or split into a couple of
+ * contiguous batches per worker
+ */
+template <typename Kernel>
+void forEachBatch(size_t count, JobSystem* jobSystem, const Kernel& kernel) {
+    if (!jobSystem || jobSystem->getThreadCount() < 2 || count < MIN_ELEMENTS_PER_JOB * 2) {
+        kernel(size_t{0}, count);
+        return;
+    }
+    const size_t batches = jobSystem->getThreadCount() * 2;
+    // Multiples of four keep all but the last batch off the scalar tail
+    const size_t batchSize = (std::max(MIN_ELEMENTS_PER_JOB, (count + batches - 1) / batches) + 3) & ~size_t{3};
+    JobCounter counter;
+    for (size_t first = 0; first < count; first += batchSize) {
+        const size_t last = std::min(count, first + batchSize);
+        jobSystem->kickJob([&kernel, first, last]() { kernel(first, last); }, &counter);
+    }
+    jobSystem->waitForCounter(&counter);
+}
+
+// Four-wide helpers on the backend Matrix4 was compiled with. load3/store3
+// convert four packed xyz triples to one register per coordinate and back;
+// unzip/zip split alternating elements of two registers (min/max pairs).
+#if defined(MATHPLEASE_SIMD_SSE)
+#define MATHPLEASE_BATCH_SIMD 1
+using f32x4 = __m128;
+
+inline f32x4 splat(float value) { return _mm_set1_ps(value); }
+inline f32x4 add(f32x4 a, f32x4 b) { return _mm_add_ps(a, b); }
+inline f32x4 sub(f32x4 a, f32x4 b) { return _mm_sub_ps(a, b); }
+inline f32x4 mul(f32x4 a, f32x4 b) { return _mm_mul_ps(a, b); }
+inline f32x4 absolute(f32x4 a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+
+inline void load3(const float* p, f32x4& x, f32x4& y, f32x4& z) {
+    const __m128 v0 = _mm_loadu_ps(p);     // x0 y0 z0 x1
+    const __m128 v1 = _mm_loadu_ps(p + 4); // y1 z1 x2 y2
+    const __m128 v2 = _mm_loadu_ps(p + 8); // z2 x3 y3 z3
+    x = _mm_shuffle_ps(v0, _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+    y = _mm_shuffle_ps(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(0, 0, 1, 1)),
+                       _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+    z = _mm_shuffle_ps(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(1, 1, 2, 2)), v2, _MM_SHUFFLE(3, 0, 2, 0));
+}
+
+inline void store3(float* p, f32x4 x, f32x4 y, f32x4 z) {
+    _mm_storeu_ps(p, _mm_shuffle_ps(_mm_unpacklo_ps(x, y), _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)),
+                                    _MM_SHUFFLE(2, 0, 1, 0)));
+    _mm_storeu_ps(p + 4, _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)),
+                                        _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+    _mm_storeu_ps(p + 8, _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)),
+                                        _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+inline void unzip(f32x4 a, f32x4 b, f32x4& even, f32x4& odd) {
+    even = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+    odd = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+inline void zip(f32x4 even, f32x4 odd, f32x4& a, f32x4& b) {
+    a = _mm_unpacklo_ps(even, odd);
+    b = _mm_unpackhi_ps(even, odd);
+}
+#elif defined(MATHPLEASE_SIMD_NEON)
+#define MATHPLEASE_BATCH_SIMD 1
+using f32x4 = float32x4_t;
+
+inline f32x4 splat(float value) { return vdupq_n_f32(value); }
+inline f32x4 add(f32x4 a, f32x4 b) { return vaddq_f32(a, b); }
+inline f32x4 sub(f32x4 a, f32x4 b) { return vsubq_f32(a, b); }
+inline f32x4 mul(f32x4 a, f32x4 b) { return vmulq_f32(a, b); }
+inline f32x4 absolute(f32x4 a) { return vabsq_f32(a); }
+
+inline void load3(const float* p, f32x4& x, f32x4& y, f32x4& z) {
+    const float32x4x3_t v = vld3q_f32(p);
+    x = v.val[0];
+    y = v.val[1];
+    z = v.val[2];
+}
+
+inline void store3(float* p, f32x4 x, f32x4 y, f32x4 z) {
+    vst3q_f32(p, float32x4x3_t{{x, y, z}});
+}
+
+inline void unzip(f32x4 a, f32x4 b, f32x4& even, f32x4& odd) {
+    const float32x4x2_t v = vuzpq_f32(a, b);
+    even = v.val[0];
+    odd = v.val[1];
+}
+
+inline void zip(f32x4 even, f32x4 odd, f32x4& a, f32x4& b) {
+    const float32x4x2_t v = vzipq_f32(even, odd);
+    a = v.val[0];
+    b = v.val[1];
+}
+#endif
+
+// Same operation order in the SIMD and scalar paths, so a tail element
+// rounds like it would inside a group of four
+Vector3 affinePoint(const float* m, const Vector3& p) {
+    return Vector3(m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12],
+                   m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13],
+                   m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14]);
+}
+
+AABB affineBox(const float* m, const AABB& box) {
+    const Vector3 c = (box.min + box.max) * 0.5f;
+    const Vector3 e = (box.max - box.min) * 0.5f;
+    const Vector3 center = affinePoint(m, c);
+    const Vector3 extent(std::fabs(m[0]) * e.x + std::fabs(m[4]) * e.y + std::fabs(m[8]) * e.z,
+                         std::fabs(m[1]) * e.x + std::fabs(m[5]) * e.y + std::fabs(m[9]) * e.z,
+                         std::fabs(m[2]) * e.x + std::fabs(m[6]) * e.y + std::fabs(m[10]) * e.z);
+    return AABB{center - extent, center + extent};
+}
+
+void transformPointsRange(const Matrix4& matrix, const Vector3* in, Vector3* out, size_t begin, size_t end) {
+    const float* m = matrix.m;
+    size_t i = begin;
+#if defined(MATHPLEASE_BATCH_SIMD)
+    const f32x4 m0 = splat(m[0]), m1 = splat(m[1]), m2 = splat(m[2]);
+    const f32x4 m4 = splat(m[4]), m5 = splat(m[5]), m6 = splat(m[6]);
+    const f32x4 m8 = splat(m[8]), m9 = splat(m[9]), m10 = splat(m[10]);
+    const f32x4 m12 = splat(m[12]), m13 = splat(m[13]), m14 = splat(m[14]);
+    for (; i + 4 <= end; i += 4) {
+        f32x4 x, y, z;
+        load3(reinterpret_cast<const float*>(in + i), x, y, z);
+        store3(reinterpret_cast<float*>(out + i),
+               add(add(add(mul(m0, x), mul(m4, y)), mul(m8, z)), m12),
+               add(add(add(mul(m1, x), mul(m5, y)), mul(m9, z)), m13),
+               add(add(add(mul(m2, x), mul(m6, y)), mul(m10, z)), m14));
+    }
+#endif
+    for (; i < end; ++i) out[i] = affinePoint(m, in[i]);
+}
+
+void transformAABBsRange(const Matrix4& matrix, const AABB* in, AABB* out, size_t begin, size_t end) {
+    const float* m = matrix.m;
+    size_t i = begin;
+#if defined(MATHPLEASE_BATCH_SIMD)
+    const f32x4 m0 = splat(m[0]), m1 = splat(m[1]), m2 = splat(m[2]);
+    const f32x4 m4 = splat(m[4]), m5 = splat(m[5]), m6 = splat(m[6]);
+    const f32x4 m8 = splat(m[8]), m9 = splat(m[9]), m10 = splat(m[10]);
+    const f32x4 m12 = splat(m[12]), m13 = splat(m[13]), m14 = splat(m[14]);
+    const f32x4 a0 = absolute(m0), a1 = absolute(m1), a2 = absolute(m2);
+    const f32x4 a4 = absolute(m4), a5 = absolute(m5), a6 = absolute(m6);
+    const f32x4 a8 = absolute(m8), a9 = absolute(m9), a10 = absolute(m10);
+    const f32x4 half = splat(0.5f);
+    for (; i + 4 <= end; i += 4) {
+        // Boxes are min/max triple pairs: read as eight triples, then split
+        // the alternating corners apart
+        const float* src = reinterpret_cast<const float*>(in + i);
+        f32x4 x01, y01, z01, x23, y23, z23;
+        load3(src, x01, y01, z01);
+        load3(src + 12, x23, y23, z23);
+        f32x4 minX, maxX, minY, maxY, minZ, maxZ;
+        unzip(x01, x23, minX, maxX);
+        unzip(y01, y23, minY, maxY);
+        unzip(z01, z23, minZ, maxZ);
+
+        const f32x4 cx = mul(add(minX, maxX), half);
+        const f32x4 cy = mul(add(minY, maxY), half);
+        const f32x4 cz = mul(add(minZ, maxZ), half);
+        const f32x4 ex = mul(sub(maxX, minX), half);
+        const f32x4 ey = mul(sub(maxY, minY), half);
+        const f32x4 ez = mul(sub(maxZ, minZ), half);
+        const f32x4 centerX = add(add(add(mul(m0, cx), mul(m4, cy)), mul(m8, cz)), m12);
+        const f32x4 centerY = add(add(add(mul(m1, cx), mul(m5, cy)), mul(m9, cz)), m13);
+        const f32x4 centerZ = add(add(add(mul(m2, cx), mul(m6, cy)), mul(m10, cz)), m14);
+        const f32x4 extentX = add(add(mul(a0, ex), mul(a4, ey)), mul(a8, ez));
+        const f32x4 extentY = add(add(mul(a1, ex), mul(a5, ey)), mul(a9, ez));
+        const f32x4 extentZ = add(add(mul(a2, ex), mul(a6, ey)), mul(a10, ez));
+
+        zip(sub(centerX, extentX), add(centerX, extentX), x01, x23);
+        zip(sub(centerY, extentY), add(centerY, extentY), y01, y23);
+        zip(sub(centerZ, extentZ), add(centerZ, extentZ), z01, z23);
+        float* dst = reinterpret_cast<float*>(out + i);
+        store3(dst, x01, y01, z01);
+        store3(dst + 12, x23, y23, z23);
+    }
+#endif
+    for (; i < end; ++i) out[i] = affineBox(m, in[i]);
+}
+
+} // namespace
+
+void mulMatrices(std::span<const Matrix4> a, std::span<const Matrix4> b, std::span<Matrix4> out,
+                 JobSystem* jobSystem) {
+    const size_t count = std::min({a.size(), b.size(), out.size()});
+    forEachBatch(count, jobSystem, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) out[i] = a[i] * b[i];
+    });
+}
+
+void mulMatrices(const Matrix4& a, std::span<const Matrix4> b, std::span<Matrix4> out, JobSystem* jobSystem) {
+    const size_t count = std::min(b.size(), out.size());
+    forEachBatch(count, jobSystem, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) out[i] = a * b[i];
+    });
+}
+
+void transformPoints(const Matrix4& matrix, std::span<const Vector3> points, std::span<Vector3> out,
+                     JobSystem* jobSystem) {
+    const size_t count = std::min(points.size(), out.size());
+    forEachBatch(count, jobSystem, [&](size_t begin, size_t end) {
+        transformPointsRange(matrix, points.data(), out.data(), begin, end);
+    });
+}
+
+void transformAABBs(const Matrix4& matrix, std::span<const AABB> boxes, std::span<AABB> out,
+                    JobSystem* jobSystem) {
+    const size_t count = std::min(boxes.size(), out.size());
+    forEachBatch(count, jobSystem, [&](size_t begin, size_t end) {
+        transformAABBsRange(matrix, boxes.data(), out.data(), begin, end);
+    });
+}
+
+} // namespace mathplease
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "vector.hpp"
+#include <span>
+
+class JobSystem;
+
+namespace mathplease {
+
+/** Axis-aligned bounding box */
+struct AABB {
+    mathplease::Vector3 min;
+    mathplease::Vector3 max;
+};
+
+/*
+ * Batched transform kernels over contiguous arrays. Each processes
+ * min(input size, output size) elements; outputs must not overlap inputs
+ * unless they are the same array. Points and boxes are handled four at a
+ * time, deinterleaved to one register per coordinate, on the backend that
+ * Matrix4 uses (see matrix_simd.hpp).
+ *
+ * With a JobSystem of two or more threads, inputs large enough to be worth it
+ * are split into contiguous batches across the workers and the call returns
+ * once all of them are done.
+ */
+
+/** out[i] = a[i] * b[i] */
+void mulMatrices(std::span<const Matrix4> a, std::span<const Matrix4> b, std::span<Matrix4> out,
+                 JobSystem* jobSystem = nullptr);
+/** out[i] = a * b[i], e.g. one parent over many locals */
+void mulMatrices(const Matrix4& a, std::span<const Matrix4> b, std::span<Matrix4> out,
+                 JobSystem* jobSystem = nullptr);
+
+/** out[i] = matrix * (points[i], 1). The matrix is taken as affine: unlike
+ * Matrix4::transformPoint there is no perspective divide */
+void transformPoints(const Matrix4& matrix, std::span<const Vector3> points, std::span<Vector3> out,
+                     JobSystem* jobSystem = nullptr);
+
+/** Tightest AABB around each transformed box (center and absolute-extent
+ * form). Affine matrices only */
+void transformAABBs(const Matrix4& matrix, std::span<const AABB> boxes, std::span<AABB> out,
+                    JobSystem* jobSystem = nullptr);
+
+} // namespace mathplease
@@ -0,0 +1,232 @@
+#include "frustum.hpp"
+#include "../job_system.h"
+#include <algorithm>
+#include <cmath>
+
+namespace mathplease {
+
+namespace {
+
+constexpr size_t MIN_OBJECTS_PER_JOB = 16384;
+
+// Same operation order in the SIMD and scalar tests, so the batched masks
+// agree with Frustum::intersects bit for bit
+bool boxVisible(const Frustum& frustum, float cx, float cy, float cz, float ex, float ey, float ez) {
+    for (const Vector4& p : frustum.planes) {
+        const float distance = p.x * cx + p.y * cy + p.z * cz + p.w;
+        const float radius = std::fabs(p.x) * ex + std::fabs(p.y) * ey + std::fabs(p.z) * ez;
+        if (!(distance + radius >= 0.0f)) return false;
+    }
+    return true;
+}
+
+bool sphereVisible(const Frustum& frustum, float cx, float cy, float cz, float radius) {
+    for (const Vector4& p : frustum.planes) {
+        const float distance = p.x * cx + p.y * cy + p.z * cz + p.w;
+        if (!(distance + radius >= 0.0f)) return false;
+    }
+    return true;
+}
+
+Vector4 normalizedPlane(const Vector4& plane) {
+    const float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+    return length > 0.0f ? plane * (1.0f / length) : plane;
+}
+
+// Widest register the build allows. mask() packs one bit per lane that
+// passed every plane, lane 0 in bit 0.
+#if defined(MATHPLEASE_SIMD_AVX)
+#define MATHPLEASE_CULL_SIMD 1
+using fvec = __m256;
+constexpr size_t LANES = 8;
+
+inline fvec load(const float* p) { return _mm256_loadu_ps(p); }
+inline fvec splat(float value) { return _mm256_set1_ps(value); }
+inline fvec add(fvec a, fvec b) { return _mm256_add_ps(a, b); }
+inline fvec mul(fvec a, fvec b) { return _mm256_mul_ps(a, b); }
+inline fvec passes(fvec value) { return _mm256_cmp_ps(value, _mm256_setzero_ps(), _CMP_GE_OQ); }
+inline fvec both(fvec a, fvec b) { return _mm256_and_ps(a, b); }
+inline fvec allLanes() { return _mm256_castsi256_ps(_mm256_set1_epi32(-1)); }
+inline uint32_t mask(fvec lanes) { return static_cast<uint32_t>(_mm256_movemask_ps(lanes)); }
+#elif defined(MATHPLEASE_SIMD_SSE)
+#define MATHPLEASE_CULL_SIMD 1
+using fvec = __m128;
+constexpr size_t LANES = 4;
+
+inline fvec load(const float* p) { return _mm_loadu_ps(p); }
+inline fvec splat(float value) { return _mm_set1_ps(value); }
+inline fvec add(fvec a, fvec b) { return _mm_add_ps(a, b); }
+inline fvec mul(fvec a, fvec b) { return _mm_mul_ps(a, b); }
+inline fvec passes(fvec value) { return _mm_cmpge_ps(value, _mm_setzero_ps()); }
+inline fvec both(fvec a, fvec b) { return _mm_and_ps(a, b); }
+inline fvec allLanes() { return _mm_castsi128_ps(_mm_set1_epi32(-1)); }
+inline uint32_t mask(fvec lanes) { return static_cast<uint32_t>(_mm_movemask_ps(lanes)); }
+#elif defined(MATHPLEASE_SIMD_NEON)
+#define MATHPLEASE_CULL_SIMD 1
+using fvec = float32x4_t;
+constexpr size_t LANES = 4;
+
+inline fvec load(const float* p) { return vld1q_f32(p); }
+inline fvec splat(float value) { return vdupq_n_f32(value); }
+inline fvec add(fvec a, fvec b) { return vaddq_f32(a, b); }
+inline fvec mul(fvec a, fvec b) { return vmulq_f32(a, b); }
+inline fvec passes(fvec value) { return vreinterpretq_f32_u32(vcgeq_f32(value, vdupq_n_f32(0.0f))); }
+inline fvec both(fvec a, fvec b) {
+    return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+}
+inline fvec allLanes() { return vreinterpretq_f32_u32(vdupq_n_u32(0xffffffffu)); }
+inline uint32_t mask(fvec lanes) {
+    static const uint32_t laneBits[4] = {1, 2, 4, 8};
+    const uint32x4_t bits = vandq_u32(vreinterpretq_u32_f32(lanes), vld1q_u32(laneBits));
+    return vgetq_lane_u32(bits, 0) | vgetq_lane_u32(bits, 1) | vgetq_lane_u32(bits, 2) | vgetq_lane_u32(bits, 3);
+}
+#endif
+
+/** Plane coefficients and their absolute values, splatted once per call */
+struct SplatPlanes {
+#if defined(MATHPLEASE_CULL_SIMD)
+    fvec a[Frustum::PlaneCount], b[Frustum::PlaneCount], c[Frustum::PlaneCount], d[Frustum::PlaneCount];
+    fvec absA[Frustum::PlaneCount], absB[Frustum::PlaneCount], absC[Frustum::PlaneCount];
+
+    explicit SplatPlanes(const Frustum& frustum) {
+        for (int p = 0; p < Frustum::PlaneCount; ++p) {
+            const Vector4& plane = frustum.planes[p];
+            a[p] = splat(plane.x);
+            b[p] = splat(plane.y);
+            c[p] = splat(plane.z);
+            d[p] = splat(plane.w);
+            absA[p] = splat(std::fabs(plane.x));
+            absB[p] = splat(std::fabs(plane.y));
+            absC[p] = splat(std::fabs(plane.z));
+        }
+    }
+#else
+    explicit SplatPlanes(const Frustum&) {}
+#endif
+};
+
+/*
+ * Fills whole visibility words for objects [begin, end), begin a multiple
+ * of 64. visible(i) tests one object, visibleLanes(i) LANES objects from i
+ */
+template <typename Visible, typename VisibleLanes>
+void cullRange(size_t begin, size_t end, uint64_t* visibility, const Visible& visible,
+               [[maybe_unused]] const VisibleLanes& visibleLanes) {
+    for (size_t first = begin; first < end; first += 64) {
+        const size_t last = std::min(end, first + 64);
+        uint64_t bits = 0;
+        size_t i = first;
+#if defined(MATHPLEASE_CULL_SIMD)
+        for (; i + LANES <= last; i += LANES) bits |= static_cast<uint64_t>(visibleLanes(i)) << (i - first);
+#endif
+        for (; i < last; ++i) bits |= static_cast<uint64_t>(visible(i)) << (i - first);
+        visibility[first / 64] = bits;
+    }
+}
+
+/** Runs kernel(begin, end) inline or in batches of whole visibility words */
+template <typename Kernel>
+void forEachBatch(size_t count, JobSystem* jobSystem, const Kernel& kernel) {
+    if (!jobSystem || jobSystem->getThreadCount() < 2 || count < MIN_OBJECTS_PER_JOB * 2) {
+        kernel(size_t{0}, count);
+        return;
+    }
+    const size_t batches = jobSystem->getThreadCount() * 2;
+    const size_t batchSize = (std::max(MIN_OBJECTS_PER_JOB, (count + batches - 1) / batches) + 63) & ~size_t{63};
+    JobCounter counter;
+    for (size_t first = 0; first < count; first += batchSize) {
+        const size_t last = std::min(count, first + batchSize);
+        jobSystem->kickJob([&kernel, first, last]() { kernel(first, last); }, &counter);
+    }
+    jobSystem->waitForCounter(&counter);
+}
+
+} // namespace
+
+Frustum Frustum::fromMatrix(const Matrix4& viewProjection, ClipDepth depth) {
+    const Matrix4& m = viewProjection;
+    const Vector4 row0(m(0, 0), m(0, 1), m(0, 2), m(0, 3));
+    const Vector4 row1(m(1, 0), m(1, 1), m(1, 2), m(1, 3));
+    const Vector4 row2(m(2, 0), m(2, 1), m(2, 2), m(2, 3));
+    const Vector4 row3(m(3, 0), m(3, 1), m(3, 2), m(3, 3));
+
+    // -w <= x, y <= w and (0 or -w) <= z <= w in clip space
+    Frustum frustum;
+    frustum.planes[Left] = normalizedPlane(row3 + row0);
+    frustum.planes[Right] = normalizedPlane(row3 - row0);
+    frustum.planes[Bottom] = normalizedPlane(row3 + row1);
+    frustum.planes[Top] = normalizedPlane(row3 - row1);
+    frustum.planes[Near] = normalizedPlane(depth == ClipDepth::ZeroToOne ? row2 : row3 + row2);
+    frustum.planes[Far] = normalizedPlane(row3 - row2);
+    return frustum;
+}
+
+bool Frustum::contains(const Vector3& point) const {
+    return sphereVisible(*this, point.x, point.y, point.z, 0.0f);
+}
+
+bool Frustum::intersects(const AABB& box) const {
+    const Vector3 center = (box.min + box.max) * 0.5f;
+    const Vector3 extent = (box.max - box.min) * 0.5f;
+    return boxVisible(*this, center.x, center.y, center.z, extent.x, extent.y, extent.z);
+}
+
+bool Frustum::intersects(const Sphere& sphere) const {
+    return sphereVisible(*this, sphere.center.x, sphere.center.y, sphere.center.z, sphere.radius);
+}
+
+void cullBoxes(const Frustum& frustum, const BoxStreams& boxes, size_t count, uint64_t* visibility,
+               JobSystem* jobSystem) {
+    const SplatPlanes planes(frustum);
+    const auto visible = [&](size_t i) {
+        return boxVisible(frustum, boxes.centerX[i], boxes.centerY[i], boxes.centerZ[i], boxes.extentX[i],
+                          boxes.extentY[i], boxes.extentZ[i]);
+    };
+    const auto visibleLanes = [&]([[maybe_unused]] size_t i) -> uint32_t {
+#if defined(MATHPLEASE_CULL_SIMD)
+        const fvec cx = load(boxes.centerX + i), cy = load(boxes.centerY + i), cz = load(boxes.centerZ + i);
+        const fvec ex = load(boxes.extentX + i), ey = load(boxes.extentY + i), ez = load(boxes.extentZ + i);
+        fvec inside = allLanes();
+        for (int p = 0; p < Frustum::PlaneCount; ++p) {
+            const fvec distance = add(add(add(mul(planes.a[p], cx), mul(planes.b[p], cy)), mul(planes.c[p], cz)),
+                                      planes.d[p]);
+            const fvec radius = add(add(mul(planes.absA[p], ex), mul(planes.absB[p], ey)), mul(planes.absC[p], ez));
+            inside = both(inside, passes(add(distance, radius)));
+        }
+        return mask(inside);
+#else
+        return 0;
+#endif
+    };
+    forEachBatch(count, jobSystem, [&](size_t begin, size_t end) {
+        cullRange(begin, end, visibility, visible, visibleLanes);
+    });
+}
+
+void cullSpheres(const Frustum& frustum, const SphereStreams& spheres, size_t count, uint64_t* visibility,
+                 JobSystem* jobSystem) {
+    const SplatPlanes planes(frustum);
+    const auto visible = [&](size_t i) {
+        return sphereVisible(frustum, spheres.centerX[i], spheres.centerY[i], spheres.centerZ[i], spheres.radius[i]);
+    };
+    const auto visibleLanes = [&]([[maybe_unused]] size_t i) -> uint32_t {
+#if defined(MATHPLEASE_CULL_SIMD)
+        const fvec cx = load(spheres.centerX + i), cy = load(spheres.centerY + i), cz = load(spheres.centerZ + i);
+        const fvec r = load(spheres.radius + i);
+        fvec inside = allLanes();
+        for (int p = 0; p < Frustum::PlaneCount; ++p) {
+            const fvec distance = add(add(add(mul(planes.a[p], cx), mul(planes.b[p], cy)), mul(planes.c[p], cz)),
+                                      planes.d[p]);
+            inside = both(inside, passes(add(distance, r)));
+        }
+        return mask(inside);
+#else
+        return 0;
+#endif
+    };
+    forEachBatch(count, jobSystem, [&](size_t begin, size_t end) {
+        cullRange(begin, end, visibility, visible, visibleLanes);
+    });
+}
+
+} // namespace mathplease
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "batch_kernels.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+class JobSystem;
+
+namespace mathplease {
+
+/** Bounding sphere */
+struct Sphere {
+    Vector3 center;
+    float radius = 0.0f;
+};
+
+/** Depth range of clip space, Vulkan/D3D [0, w] or OpenGL [-w, w] */
+enum class ClipDepth : uint8_t { ZeroToOne, MinusOneToOne };
+
+/*
+ * View frustum as six inward-facing planes (a, b, c, d) with unit normals:
+ * a point p is inside a plane when a*p.x + b*p.y + c*p.z + d >= 0, so the
+ * plane value is a signed distance. The intersection tests are conservative
+ * in the usual way: a volume is rejected only when it lies entirely behind
+ * one plane, so a few boxes near the frustum corners pass without being
+ * visible.
+ */
+struct Frustum {
+    enum PlaneIndex { Left, Right, Bottom, Top, Near, Far, PlaneCount };
+
+    std::array<Vector4, PlaneCount> planes;
+
+    /** Planes of projection * view (the order the shaders apply them in),
+     * in world space. With projection alone the planes are in view space */
+    static Frustum fromMatrix(const Matrix4& viewProjection, ClipDepth depth = ClipDepth::ZeroToOne);
+
+    bool contains(const Vector3& point) const;
+    bool intersects(const AABB& box) const;
+    bool intersects(const Sphere& sphere) const;
+};
+
+/** Boxes as centre and half-extent streams (structure of arrays) */
+struct BoxStreams {
+    const float* centerX;
+    const float* centerY;
+    const float* centerZ;
+    const float* extentX;
+    const float* extentY;
+    const float* extentZ;
+};
+
+/** Spheres as centre and radius streams (structure of arrays) */
+struct SphereStreams {
+    const float* centerX;
+    const float* centerY;
+    const float* centerZ;
+    const float* radius;
+};
+
+/** Number of uint64_t words in a visibility mask for count objects */
+constexpr size_t visibilityWords(size_t count) {
+    return (count + 63) / 64;
+}
+
+/*
+ * Batched frustum tests. Bit i % 64 of visibility[i / 64] is set when object
+ * i intersects the frustum, with the same result as Frustum::intersects;
+ * bits past count in the last word are cleared. visibility needs
+ * visibilityWords(count) entries.
+ *
+ * Eight objects are tested at a time with AVX, four with SSE2 or NEON. With
+ * a JobSystem of two or more threads, large inputs are split across the
+ * workers in whole mask words.
+ */
+void cullBoxes(const Frustum& frustum, const BoxStreams& boxes, size_t count, uint64_t* visibility,
+               JobSystem* jobSystem = nullptr);
+void cullSpheres(const Frustum& frustum, const SphereStreams& spheres, size_t count, uint64_t* visibility,
+                 JobSystem* jobSystem = nullptr);
+
+} // namespace mathplease
@@ -0,0 +1,305 @@
+#pragma once
+
+// Inline Matrix4 hot paths (multiply, matrix * vector, transpose, inverse).
+// The backend is picked at compile time from the target flags: AVX when the
+// build enables it, SSE2 on any x86-64, NEON on ARM, and the out-of-line
+// mathplease::scalar versions otherwise. Define MATHPLEASE_FORCE_SCALAR to
+// use the scalar code regardless.
+//
+// Multiply and matrix * vector add the products in the same order as the
+// scalar loops, so without FMA they round identically. The constexpr ones
+// evaluate the scalar code at compile time. Only included from vector.hpp.
+//
+// Normal builds fuse multiply-adds when the target has FMA. Defining
+// MATHPLEASE_DETERMINISTIC (the LIGHTSPLEASE_DETERMINISTIC_MATH CMake option)
+// gives strict IEEE single precision instead: no fused operations, and the
+// inverse uses the scalar code, so every backend and every conforming build
+// produces the same bits from + - * / and sqrt. The option also compiles with
+// -ffp-contract=off and, on GCC, -fno-tree-slp-vectorize, which otherwise
+// turns alternating add/sub lanes into fmaddsub regardless of contraction.
+// libm functions (sin, cos, ...) are not covered and can differ between
+// platforms.
+
+#if defined(MATHPLEASE_FORCE_SCALAR)
+#define MATHPLEASE_SIMD_SCALAR 1
+#elif defined(__AVX__)
+#define MATHPLEASE_SIMD_AVX 1
+#define MATHPLEASE_SIMD_SSE 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MATHPLEASE_SIMD_SSE 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#define MATHPLEASE_SIMD_NEON 1
+#include <arm_neon.h>
+#else
+#define MATHPLEASE_SIMD_SCALAR 1
+#endif
+
+#if defined(MATHPLEASE_DETERMINISTIC)
+#include <cfloat>
+#if defined(__FAST_MATH__)
+#error "MATHPLEASE_DETERMINISTIC cannot be combined with -ffast-math"
+#endif
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD != 0
+#error "MATHPLEASE_DETERMINISTIC needs float arithmetic at float precision (SSE2, not x87)"
+#endif
+#elif (defined(MATHPLEASE_SIMD_SSE) && defined(__FMA__)) || \
+      (defined(MATHPLEASE_SIMD_NEON) && defined(__ARM_FEATURE_FMA))
+#define MATHPLEASE_SIMD_FMA 1
+#endif
+
+namespace mathplease {
+
+/** Which Matrix4 backend this translation unit was compiled with */
+constexpr const char* matrixBackendName() {
+#if defined(MATHPLEASE_SIMD_AVX) && defined(MATHPLEASE_SIMD_FMA)
+    return "avx+fma";
+#elif defined(MATHPLEASE_SIMD_AVX)
+    return "avx";
+#elif defined(MATHPLEASE_SIMD_SSE)
+    return "sse2";
+#elif defined(MATHPLEASE_SIMD_NEON) && defined(MATHPLEASE_SIMD_FMA)
+    return "neon+fma";
+#elif defined(MATHPLEASE_SIMD_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+/** True when built with MATHPLEASE_DETERMINISTIC */
+constexpr bool isDeterministicMath() {
+#if defined(MATHPLEASE_DETERMINISTIC)
+    return true;
+#else
+    return false;
+#endif
+}
+
+#if defined(MATHPLEASE_SIMD_SSE)
+namespace simd {
+
+// a * b + c, fused when allowed
+inline __m128 madd(__m128 a, __m128 b, __m128 c) {
+#if defined(MATHPLEASE_SIMD_FMA)
+    return _mm_fmadd_ps(a, b, c);
+#else
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+}
+
+#if defined(MATHPLEASE_SIMD_AVX)
+inline __m256 madd(__m256 a, __m256 b, __m256 c) {
+#if defined(MATHPLEASE_SIMD_FMA)
+    return _mm256_fmadd_ps(a, b, c);
+#else
+    return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+}
+#endif
+
+// a0 * b.x + a1 * b.y + a2 * b.z + a3 * b.w
+inline __m128 combineColumns(__m128 a0, __m128 a1, __m128 a2, __m128 a3, __m128 b) {
+    __m128 r = _mm_mul_ps(a0, _mm_shuffle_ps(b, b, 0x00));
+    r = madd(a1, _mm_shuffle_ps(b, b, 0x55), r);
+    r = madd(a2, _mm_shuffle_ps(b, b, 0xAA), r);
+    return madd(a3, _mm_shuffle_ps(b, b, 0xFF), r);
+}
+
+// 2x2 blocks packed (m00 m01 m10 m11). Products of blocks and of their
+// adjugates, for the block-wise inverse below
+inline __m128 mat2Mul(__m128 a, __m128 b) {
+    return _mm_add_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))),
+                      _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)),
+                                 _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+}
+
+// adj(a) * b
+inline __m128 mat2AdjMul(__m128 a, __m128 b) {
+    return _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b),
+                      _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)),
+                                 _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+}
+
+// a * adj(b)
+inline __m128 mat2MulAdj(__m128 a, __m128 b) {
+    return _mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))),
+                      _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)),
+                                 _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+}
+
+} // namespace simd
+#elif defined(MATHPLEASE_SIMD_NEON)
+namespace simd {
+
+// a * b + c, fused when allowed
+inline float32x4_t madd(float32x4_t a, float32x4_t b, float32x4_t c) {
+#if defined(MATHPLEASE_SIMD_FMA)
+    return vfmaq_f32(c, a, b);
+#else
+    return vaddq_f32(vmulq_f32(a, b), c);
+#endif
+}
+
+} // namespace simd
+#endif
+
+constexpr Matrix4 Matrix4::operator*(const Matrix4& other) const {
+    if (std::is_constant_evaluated()) return scalar::multiply(*this, other);
+#if defined(MATHPLEASE_SIMD_AVX)
+    // Two result columns per iteration; in-lane shuffles broadcast each
+    // column's own coefficients
+    Matrix4 result;
+    const __m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m + 0));
+    const __m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m + 4));
+    const __m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m + 8));
+    const __m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m + 12));
+    for (int j = 0; j < 16; j += 8) {
+        const __m256 b = _mm256_loadu_ps(other.m + j);
+        __m256 r = _mm256_mul_ps(a0, _mm256_shuffle_ps(b, b, 0x00));
+        r = simd::madd(a1, _mm256_shuffle_ps(b, b, 0x55), r);
+        r = simd::madd(a2, _mm256_shuffle_ps(b, b, 0xAA), r);
+        r = simd::madd(a3, _mm256_shuffle_ps(b, b, 0xFF), r);
+        _mm256_storeu_ps(result.m + j, r);
+    }
+    return result;
+#elif defined(MATHPLEASE_SIMD_SSE)
+    Matrix4 result;
+    const __m128 a0 = _mm_loadu_ps(m + 0);
+    const __m128 a1 = _mm_loadu_ps(m + 4);
+    const __m128 a2 = _mm_loadu_ps(m + 8);
+    const __m128 a3 = _mm_loadu_ps(m + 12);
+    for (int j = 0; j < 16; j += 4) {
+        _mm_storeu_ps(result.m + j, simd::combineColumns(a0, a1, a2, a3, _mm_loadu_ps(other.m + j)));
+    }
+    return result;
+#elif defined(MATHPLEASE_SIMD_NEON)
+    Matrix4 result;
+    const float32x4_t a0 = vld1q_f32(m + 0);
+    const float32x4_t a1 = vld1q_f32(m + 4);
+    const float32x4_t a2 = vld1q_f32(m + 8);
+    const float32x4_t a3 = vld1q_f32(m + 12);
+    for (int j = 0; j < 16; j += 4) {
+        const float32x4_t b = vld1q_f32(other.m + j);
+        float32x4_t r = vmulq_n_f32(a0, vgetq_lane_f32(b, 0));
+        r = simd::madd(a1, vdupq_n_f32(vgetq_lane_f32(b, 1)), r);
+        r = simd::madd(a2, vdupq_n_f32(vgetq_lane_f32(b, 2)), r);
+        r = simd::madd(a3, vdupq_n_f32(vgetq_lane_f32(b, 3)), r);
+        vst1q_f32(result.m + j, r);
+    }
+    return result;
+#else
+    return scalar::multiply(*this, other);
+#endif
+}
+
+constexpr Vector4 Matrix4::operator*(const Vector4& vec) const {
+    if (std::is_constant_evaluated()) return scalar::transform(*this, vec);
+#if defined(MATHPLEASE_SIMD_SSE)
+    alignas(16) float r[4];
+    const __m128 v = _mm_setr_ps(vec.x, vec.y, vec.z, vec.w);
+    _mm_store_ps(r, simd::combineColumns(_mm_loadu_ps(m), _mm_loadu_ps(m + 4), _mm_loadu_ps(m + 8),
+                                         _mm_loadu_ps(m + 12), v));
+    return Vector4(r[0], r[1], r[2], r[3]);
+#elif defined(MATHPLEASE_SIMD_NEON)
+    float32x4_t r = vmulq_n_f32(vld1q_f32(m + 0), vec.x);
+    r = simd::madd(vld1q_f32(m + 4), vdupq_n_f32(vec.y), r);
+    r = simd::madd(vld1q_f32(m + 8), vdupq_n_f32(vec.z), r);
+    r = simd::madd(vld1q_f32(m + 12), vdupq_n_f32(vec.w), r);
+    return Vector4(vgetq_lane_f32(r, 0), vgetq_lane_f32(r, 1), vgetq_lane_f32(r, 2), vgetq_lane_f32(r, 3));
+#else
+    return scalar::transform(*this, vec);
+#endif
+}
+
+constexpr Matrix4 Matrix4::transposed() const {
+    if (std::is_constant_evaluated()) return scalar::transpose(*this);
+#if defined(MATHPLEASE_SIMD_SSE)
+    Matrix4 result;
+    __m128 c0 = _mm_loadu_ps(m + 0);
+    __m128 c1 = _mm_loadu_ps(m + 4);
+    __m128 c2 = _mm_loadu_ps(m + 8);
+    __m128 c3 = _mm_loadu_ps(m + 12);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+    _mm_storeu_ps(result.m + 0, c0);
+    _mm_storeu_ps(result.m + 4, c1);
+    _mm_storeu_ps(result.m + 8, c2);
+    _mm_storeu_ps(result.m + 12, c3);
+    return result;
+#elif defined(MATHPLEASE_SIMD_NEON)
+    // The de-interleaving load reads the rows, which are the result's columns
+    Matrix4 result;
+    const float32x4x4_t rows = vld4q_f32(m);
+    vst1q_f32(result.m + 0, rows.val[0]);
+    vst1q_f32(result.m + 4, rows.val[1]);
+    vst1q_f32(result.m + 8, rows.val[2]);
+    vst1q_f32(result.m + 12, rows.val[3]);
+    return result;
+#else
+    return scalar::transpose(*this);
+#endif
+}
+
+inline Matrix4 Matrix4::inverse() const {
+    // A different algorithm from the scalar one, so deterministic builds
+    // always take the scalar path
+#if defined(MATHPLEASE_SIMD_SSE) && !defined(MATHPLEASE_DETERMINISTIC)
+    // Block-wise inverse over 2x2 sub-matrices A B / C D using adjugates.
+    // The math is written for rows; fed columns it yields the inverse of the
+    // transpose laid out by rows, i.e. our inverse laid out by columns.
+    const __m128 c0 = _mm_loadu_ps(m + 0);
+    const __m128 c1 = _mm_loadu_ps(m + 4);
+    const __m128 c2 = _mm_loadu_ps(m + 8);
+    const __m128 c3 = _mm_loadu_ps(m + 12);
+    const __m128 A = _mm_movelh_ps(c0, c1);
+    const __m128 B = _mm_movehl_ps(c1, c0);
+    const __m128 C = _mm_movelh_ps(c2, c3);
+    const __m128 D = _mm_movehl_ps(c3, c2);
+
+    // (|A| |B| |C| |D|)
+    const __m128 detSub = _mm_sub_ps(
+        _mm_mul_ps(_mm_shuffle_ps(c0, c2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(c1, c3, _MM_SHUFFLE(3, 1, 3, 1))),
+        _mm_mul_ps(_mm_shuffle_ps(c0, c2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(c1, c3, _MM_SHUFFLE(2, 0, 2, 0))));
+    const __m128 detA = _mm_shuffle_ps(detSub, detSub, 0x00);
+    const __m128 detB = _mm_shuffle_ps(detSub, detSub, 0x55);
+    const __m128 detC = _mm_shuffle_ps(detSub, detSub, 0xAA);
+    const __m128 detD = _mm_shuffle_ps(detSub, detSub, 0xFF);
+
+    const __m128 DC = simd::mat2AdjMul(D, C);
+    const __m128 AB = simd::mat2AdjMul(A, B);
+    __m128 X = _mm_sub_ps(_mm_mul_ps(detD, A), simd::mat2Mul(B, DC));
+    __m128 W = _mm_sub_ps(_mm_mul_ps(detA, D), simd::mat2Mul(C, AB));
+    __m128 Y = _mm_sub_ps(_mm_mul_ps(detB, C), simd::mat2MulAdj(D, AB));
+    __m128 Z = _mm_sub_ps(_mm_mul_ps(detC, B), simd::mat2MulAdj(A, DC));
+
+    // |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C), trace summed without hadd
+    __m128 tr = _mm_mul_ps(AB, _mm_shuffle_ps(DC, DC, _MM_SHUFFLE(3, 1, 2, 0)));
+    tr = _mm_add_ps(tr, _mm_movehl_ps(tr, tr));
+    tr = _mm_add_ps(tr, _mm_shuffle_ps(tr, tr, _MM_SHUFFLE(1, 1, 1, 1)));
+    tr = _mm_shuffle_ps(tr, tr, 0x00);
+    const __m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), tr);
+    if (std::fabs(_mm_cvtss_f32(det)) < kEpsilon) {
+        // Non-invertible matrix, return identity as a fallback
+        return identity();
+    }
+
+    const __m128 invDet = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det);
+    X = _mm_mul_ps(X, invDet);
+    Y = _mm_mul_ps(Y, invDet);
+    Z = _mm_mul_ps(Z, invDet);
+    W = _mm_mul_ps(W, invDet);
+
+    // Adjugate of each block and the un-blocking in one shuffle per column
+    Matrix4 result;
+    _mm_storeu_ps(result.m + 0, _mm_shuffle_ps(X, Y, _MM_SHUFFLE(1, 3, 1, 3)));
+    _mm_storeu_ps(result.m + 4, _mm_shuffle_ps(X, Y, _MM_SHUFFLE(0, 2, 0, 2)));
+    _mm_storeu_ps(result.m + 8, _mm_shuffle_ps(Z, W, _MM_SHUFFLE(1, 3, 1, 3)));
+    _mm_storeu_ps(result.m + 12, _mm_shuffle_ps(Z, W, _MM_SHUFFLE(0, 2, 0, 2)));
+    return result;
+#else
+    return scalar::inverse(*this);
+#endif
+}
+
+} // namespace mathplease
@@ -4,171 +4,7 @@
 
 namespace mathplease {
 
-// Small epsilon for normalization safety
-static constexpr float kEpsilon = 1e-8f;
-
-// Vector2 implementations
-float Vector2::length() const {
-	return std::sqrt(x * x + y * y);
-}
-
-float Vector2::lengthSquared() const {
-	return x * x + y * y;
-}
-
-Vector2 Vector2::normalized() const {
-	float len = length();
-	if (len <= kEpsilon) return Vector2(0.0f, 0.0f);
-	return Vector2(x / len, y / len);
-}
-
-void Vector2::normalize() {
-	float len = length();
-	if (len <= kEpsilon) {
-		x = 0.0f; y = 0.0f; return;
-	}
-	x /= len; y /= len;
-}
-
-float Vector2::dot(const Vector2& other) const {
-	return x * other.x + y * other.y;
-}
-
-float Vector2::dot(const Vector2& a, const Vector2& b) {
-	return a.x * b.x + a.y * b.y;
-}
-
-float Vector2::distance(const Vector2& other) const {
-	float dx = x - other.x;
-	float dy = y - other.y;
-	return std::sqrt(dx * dx + dy * dy);
-}
-
-// Vector3 implementations
-float Vector3::length() const {
-	return std::sqrt(x * x + y * y + z * z);
-}
-
-float Vector3::lengthSquared() const {
-	return x * x + y * y + z * z;
-}
-
-Vector3 Vector3::normalized() const {
-	float len = length();
-	if (len <= kEpsilon) return Vector3(0.0f, 0.0f, 0.0f);
-	return Vector3(x / len, y / len, z / len);
-}
-
-void Vector3::normalize() {
-	float len = length();
-	if (len <= kEpsilon) {
-		x = 0.0f; y = 0.0f; z = 0.0f; return;
-	}
-	x /= len; y /= len; z /= len;
-}
-
-float Vector3::dot(const Vector3& other) const {
-	return x * other.x + y * other.y + z * other.z;
-}
-
-float Vector3::dot(const Vector3& a, const Vector3& b) {
-	return a.x * b.x + a.y * b.y + a.z * b.z;
-}
-
-Vector3 Vector3::cross(const Vector3& other) const {
-	return Vector3(
-		y * other.z - z * other.y,
-		z * other.x - x * other.z,
-		x * other.y - y * other.x
-	);
-}
-
-Vector3 Vector3::cross(const Vector3& a, const Vector3& b) {
-	return Vector3(
-		a.y * b.z - a.z * b.y,
-		a.z * b.x - a.x * b.z,
-		a.x * b.y - a.y * b.x
-	);
-}
-
-float Vector3::distance(const Vector3& other) const {
-	float dx = x - other.x;
-	float dy = y - other.y;
-	float dz = z - other.z;
-	return std::sqrt(dx * dx + dy * dy + dz * dz);
-}
-
-// Vector4 implementations
-float Vector4::length() const {
-    return std::sqrt(x * x + y * y + z * z + w * w);
-}
-
-float Vector4::lengthSquared() const {
-    return x * x + y * y + z * z + w * w;
-}
-
-Vector4 Vector4::normalized() const {
-    float len = length();
-    if (len <= kEpsilon) return Vector4(0.0f, 0.0f, 0.0f, 0.0f);
-    return Vector4(x / len, y / len, z / len, w / len);
-}
-
-void Vector4::normalize() {
-    float len = length();
-    if (len <= kEpsilon) {
-        x = 0.0f; y = 0.0f; z = 0.0f; w = 0.0f; return;
-    }
-    x /= len; y /= len; z /= len; w /= len;
-}
-
-float Vector4::dot(const Vector4& other) const {
-    return x * other.x + y * other.y + z * other.z + w * other.w;
-}
-
-float Vector4::dot(const Vector4& a, const Vector4& b) {
-    return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
-}
-
-float Vector4::distance(const Vector4& other) const {
-    float dx = x - other.x;
-    float dy = y - other.y;
-    float dz = z - other.z;
-    float dw = w - other.w;
-    return std::sqrt(dx * dx + dy * dy + dz * dz + dw * dw);
-}
-
 // Matrix4 implementations
-Matrix4::Matrix4() {
-    for (int i = 0; i < 16; ++i) {
-        m[i] = 0.0f;
-    }
-}
-
-Matrix4::Matrix4(float diagonal) {
-    for (int i = 0; i < 16; ++i) {
-        m[i] = 0.0f;
-    }
-    m[0] = m[5] = m[10] = m[15] = diagonal;
-}
-
-Matrix4::Matrix4(const float* data) {
-    for (int i = 0; i < 16; ++i) {
-        m[i] = data[i];
-    }
-}
-
-Matrix4 Matrix4::identity() {
-    return Matrix4(1.0f);
-}
-
-Matrix4 Matrix4::translate(const Vector3& translation) {
-    Matrix4 result = identity();
-    result(0, 3) = translation.x;
-    result(1, 3) = translation.y;
-    result(2, 3) = translation.z;
-    return result;
-}
-
 Matrix4 Matrix4::rotateX(float angleRadians) {
     Matrix4 result = identity();
     float c = std::cos(angleRadians);
@@ -232,18 +68,6 @@ Matrix4 Matrix4::rotate(const Vector3& axis, float angleRadians) {
     return result;
 }
 
-Matrix4 Matrix4::scale(const Vector3& scale) {
-    Matrix4 result = identity();
-    result(0, 0) = scale.x;
-    result(1, 1) = scale.y;
-    result(2, 2) = scale.z;
-    return result;
-}
-
-Matrix4 Matrix4::scale(float uniformScale) {
-    return scale(Vector3(uniformScale, uniformScale, uniformScale));
-}
-
 Matrix4 Matrix4::perspective(float fovYRadians, float aspectRatio, float nearPlane, float farPlane) {
     Matrix4 result;
     std::memset(result.m, 0, sizeof(result.m));
@@ -310,19 +134,6 @@ Matrix4 Matrix4::operator-(const Matrix4& other) const {
     return result;
 }
 
-Matrix4 Matrix4::operator*(const Matrix4& other) const {
-    Matrix4 result;
-    for (int i = 0; i < 4; ++i) {
-        for (int j = 0; j < 4; ++j) {
-            result(i, j) = 0.0f;
-            for (int k = 0; k < 4; ++k) {
-                result(i, j) += (*this)(i, k) * other(k, j);
-            }
-        }
-    }
-    return result;
-}
-
 Matrix4 Matrix4::operator*(float scalar) const {
     Matrix4 result;
     for (int i = 0; i < 16; ++i) {
@@ -331,15 +142,6 @@ Matrix4 Matrix4::operator*(float scalar) const {
     return result;
 }
 
-Vector4 Matrix4::operator*(const Vector4& vec) const {
-    return Vector4(
-        m[0] * vec.x + m[4] * vec.y + m[8]  * vec.z + m[12] * vec.w,
-        m[1] * vec.x + m[5] * vec.y + m[9]  * vec.z + m[13] * vec.w,
-        m[2] * vec.x + m[6] * vec.y + m[10] * vec.z + m[14] * vec.w,
-        m[3] * vec.x + m[7] * vec.y + m[11] * vec.z + m[15] * vec.w
-    );
-}
-
 Vector3 Matrix4::transformPoint(const Vector3& point) const {
     Vector4 result = (*this) * Vector4(point.x, point.y, point.z, 1.0f);
     if (result.w != 0.0f) {
@@ -353,16 +155,6 @@ Vector3 Matrix4::transformVector(const Vector3& vector) const {
     return result.xyz();
 }
 
-Matrix4 Matrix4::transposed() const {
-    Matrix4 result;
-    for (int i = 0; i < 4; ++i) {
-        for (int j = 0; j < 4; ++j) {
-            result(i, j) = (*this)(j, i);
-        }
-    }
-    return result;
-}
-
 float Matrix4::determinant() const {
     float det = 
         m[0] * (m[5] * (m[10] * m[15] - m[11] * m[14]) - m[6] * (m[9] * m[15] - m[11] * m[13]) + m[7] * (m[9] * m[14] - m[10] * m[13])) -
@@ -372,7 +164,191 @@ float Matrix4::determinant() const {
     return det;
 }
 
-Matrix4 Matrix4::inverse() const {
+
+// Quaternion implementations
+Quaternion Quaternion::fromAxisAngle(const Vector3& axis, float angleRadians) {
+    const Vector3 n = axis.normalized();
+    const float halfAngle = angleRadians * 0.5f;
+    const float s = std::sin(halfAngle);
+    return Quaternion(n.x * s, n.y * s, n.z * s, std::cos(halfAngle));
+}
+
+Quaternion Quaternion::operator*(const Quaternion& o) const {
+    return Quaternion(
+        w * o.x + x * o.w + y * o.z - z * o.y,
+        w * o.y - x * o.z + y * o.w + z * o.x,
+        w * o.z + x * o.y - y * o.x + z * o.w,
+        w * o.w - x * o.x - y * o.y - z * o.z
+    );
+}
+
+float Quaternion::length() const {
+    return std::sqrt(dot(*this));
+}
+
+Quaternion Quaternion::normalized() const {
+    const float len = length();
+    if (len < kEpsilon) return Quaternion();
+    const float invLen = 1.0f / len;
+    return Quaternion(x * invLen, y * invLen, z * invLen, w * invLen);
+}
+
+Quaternion Quaternion::inverse() const {
+    const float lengthSq = dot(*this);
+    if (lengthSq < kEpsilon) return Quaternion();
+    const float inv = 1.0f / lengthSq;
+    return Quaternion(-x * inv, -y * inv, -z * inv, w * inv);
+}
+
+Vector3 Quaternion::rotate(const Vector3& v) const {
+    // v' = v + w * t + q x t, with t = 2 * (q x v)
+    const Vector3 q(x, y, z);
+    const Vector3 t = q.cross(v) * 2.0f;
+    return v + t * w + q.cross(t);
+}
+
+Matrix4 Quaternion::toMatrix() const {
+    return Transform::fromTRS(Vector3(), *this, Vector3(1.0f, 1.0f, 1.0f)).toMatrix4();
+}
+
+Quaternion Quaternion::nlerp(const Quaternion& a, const Quaternion& b, float t) {
+    // flip b onto a's hemisphere so we take the shorter arc
+    const float sign = a.dot(b) < 0.0f ? -1.0f : 1.0f;
+    const float u = 1.0f - t;
+    const float v = t * sign;
+    return Quaternion(a.x * u + b.x * v, a.y * u + b.y * v, a.z * u + b.z * v, a.w * u + b.w * v)
+        .normalized();
+}
+
+Quaternion Quaternion::slerp(const Quaternion& a, const Quaternion& b, float t) {
+    float cosTheta = a.dot(b);
+    float sign = 1.0f;
+    if (cosTheta < 0.0f) {
+        cosTheta = -cosTheta;
+        sign = -1.0f;
+    }
+    // nearly parallel: sin(theta) underflows, and nlerp is exact enough
+    if (cosTheta > 0.9995f) {
+        return nlerp(a, b, t);
+    }
+    const float theta = std::acos(cosTheta);
+    const float invSin = 1.0f / std::sin(theta);
+    const float u = std::sin((1.0f - t) * theta) * invSin;
+    const float v = std::sin(t * theta) * invSin * sign;
+    return Quaternion(a.x * u + b.x * v, a.y * u + b.y * v, a.z * u + b.z * v, a.w * u + b.w * v);
+}
+
+// Transform implementations
+Transform Transform::fromTRS(const Vector3& t, const Quaternion& q, const Vector3& s) {
+    const float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    const float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    const float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+    Transform result;
+    result.m[0] = (1.0f - 2.0f * (yy + zz)) * s.x;
+    result.m[1] = (2.0f * (xy + wz)) * s.x;
+    result.m[2] = (2.0f * (xz - wy)) * s.x;
+    result.m[3] = (2.0f * (xy - wz)) * s.y;
+    result.m[4] = (1.0f - 2.0f * (xx + zz)) * s.y;
+    result.m[5] = (2.0f * (yz + wx)) * s.y;
+    result.m[6] = (2.0f * (xz + wy)) * s.z;
+    result.m[7] = (2.0f * (yz - wx)) * s.z;
+    result.m[8] = (1.0f - 2.0f * (xx + yy)) * s.z;
+    result.m[9] = t.x;
+    result.m[10] = t.y;
+    result.m[11] = t.z;
+    return result;
+}
+
+Transform Transform::fromMatrix4(const Matrix4& matrix) {
+    Transform result;
+    for (int col = 0; col < 4; ++col) {
+        for (int row = 0; row < 3; ++row) {
+            result(row, col) = matrix(row, col);
+        }
+    }
+    return result;
+}
+
+Transform Transform::operator*(const Transform& o) const {
+    Transform result;
+    const float a00 = m[0], a10 = m[1], a20 = m[2];
+    const float a01 = m[3], a11 = m[4], a21 = m[5];
+    const float a02 = m[6], a12 = m[7], a22 = m[8];
+    for (int col = 0; col < 4; ++col) {
+        const float b0 = o.m[col * 3 + 0];
+        const float b1 = o.m[col * 3 + 1];
+        const float b2 = o.m[col * 3 + 2];
+        result.m[col * 3 + 0] = a00 * b0 + a01 * b1 + a02 * b2;
+        result.m[col * 3 + 1] = a10 * b0 + a11 * b1 + a12 * b2;
+        result.m[col * 3 + 2] = a20 * b0 + a21 * b1 + a22 * b2;
+    }
+    // the implied 1 in the translation column of `o`
+    result.m[9] += m[9];
+    result.m[10] += m[10];
+    result.m[11] += m[11];
+    return result;
+}
+
+Transform Transform::inverse() const {
+    // Rows of the inverse 3x3 are the pairwise cross products of its columns
+    const Vector3 a(m[0], m[1], m[2]);
+    const Vector3 b(m[3], m[4], m[5]);
+    const Vector3 c(m[6], m[7], m[8]);
+    const Vector3 r0 = b.cross(c);
+    const Vector3 r1 = c.cross(a);
+    const Vector3 r2 = a.cross(b);
+    const float det = a.dot(r0);
+    if (std::fabs(det) < kEpsilon) {
+        return identity();
+    }
+    const float invDet = 1.0f / det;
+
+    Transform result;
+    result.m[0] = r0.x * invDet; result.m[3] = r0.y * invDet; result.m[6] = r0.z * invDet;
+    result.m[1] = r1.x * invDet; result.m[4] = r1.y * invDet; result.m[7] = r1.z * invDet;
+    result.m[2] = r2.x * invDet; result.m[5] = r2.y * invDet; result.m[8] = r2.z * invDet;
+
+    const Vector3 t = translation();
+    const Vector3 it = result.transformVector(t);
+    result.m[9] = -it.x;
+    result.m[10] = -it.y;
+    result.m[11] = -it.z;
+    return result;
+}
+
+Vector3 Transform::transformPoint(const Vector3& p) const {
+    return Vector3(
+        m[0] * p.x + m[3] * p.y + m[6] * p.z + m[9],
+        m[1] * p.x + m[4] * p.y + m[7] * p.z + m[10],
+        m[2] * p.x + m[5] * p.y + m[8] * p.z + m[11]
+    );
+}
+
+Vector3 Transform::transformVector(const Vector3& v) const {
+    return Vector3(
+        m[0] * v.x + m[3] * v.y + m[6] * v.z,
+        m[1] * v.x + m[4] * v.y + m[7] * v.z,
+        m[2] * v.x + m[5] * v.y + m[8] * v.z
+    );
+}
+
+Matrix4 Transform::toMatrix4() const {
+    Matrix4 result;
+    for (int col = 0; col < 4; ++col) {
+        result.m[col * 4 + 0] = m[col * 3 + 0];
+        result.m[col * 4 + 1] = m[col * 3 + 1];
+        result.m[col * 4 + 2] = m[col * 3 + 2];
+        result.m[col * 4 + 3] = col == 3 ? 1.0f : 0.0f;
+    }
+    return result;
+}
+
+// Scalar reference implementations
+namespace scalar {
+
+Matrix4 inverse(const Matrix4& a) {
+    const float* m = a.m;
     Matrix4 result;
     float s0 = m[0] * m[5] - m[1] * m[4];
     float s1 = m[0] * m[6] - m[2] * m[4];
@@ -392,7 +368,7 @@ Matrix4 Matrix4::inverse() const {
 
     if (std::fabs(det) < kEpsilon) {
         // Non-invertible matrix, return identity as a fallback
-        return identity();
+        return Matrix4::identity();
     }
     float invDet = 1.0f / det;
 
@@ -422,8 +398,6 @@ Matrix4 Matrix4::inverse() const {
 
 }
 
-
-
+} // namespace scalar
 
 } // namespace mathplease
-
@@ -1,45 +1,60 @@
 #pragma once
 
+#include <cmath>
+#include <type_traits>
 
 namespace mathplease {
 
+// Small epsilon for normalization safety
+inline constexpr float kEpsilon = 1e-8f;
+
 struct Vector2 {
     float x;
     float y;
 
-    Vector2() : x(0), y(0) {}
-    Vector2(float x, float y) : x(x), y(y) {}
+    constexpr Vector2() : x(0), y(0) {}
+    constexpr Vector2(float x, float y) : x(x), y(y) {}
 
-    Vector2 operator+(const Vector2& other) const {
+    constexpr Vector2 operator+(const Vector2& other) const {
         return Vector2(x + other.x, y + other.y);
     }
 
-    Vector2 operator-(const Vector2& other) const {
+    constexpr Vector2 operator-(const Vector2& other) const {
         return Vector2(x - other.x, y - other.y);
     }
 
-    Vector2 operator*(float scalar) const {
+    constexpr Vector2 operator*(float scalar) const {
         return Vector2(x * scalar, y * scalar);
     }
 
-    Vector2 operator/(float scalar) const {
+    constexpr Vector2 operator/(float scalar) const {
         return Vector2(x / scalar, y / scalar);
     }
 
-    bool operator==(const Vector2& other) const {
+    constexpr bool operator==(const Vector2& other) const {
         return (x == other.x) && (y == other.y);
     }
 
     // Length and normalization
-    float length() const;
-    float lengthSquared() const;
-    Vector2 normalized() const;
-    void normalize();
+    float length() const { return std::sqrt(x * x + y * y); }
+    constexpr float lengthSquared() const { return x * x + y * y; }
+    Vector2 normalized() const {
+        float len = length();
+        if (len <= kEpsilon) return Vector2(0.0f, 0.0f);
+        return Vector2(x / len, y / len);
+    }
+    void normalize() {
+        float len = length();
+        if (len <= kEpsilon) {
+            x = 0.0f; y = 0.0f; return;
+        }
+        x /= len; y /= len;
+    }
 
     // Dot and distance
-    float dot(const Vector2& other) const;
-    static float dot(const Vector2& a, const Vector2& b);
-    float distance(const Vector2& other) const;
+    constexpr float dot(const Vector2& other) const { return x * other.x + y * other.y; }
+    static constexpr float dot(const Vector2& a, const Vector2& b) { return a.x * b.x + a.y * b.y; }
+    float distance(const Vector2& other) const { return (*this - other).length(); }
 };
 
 struct Vector3 {
@@ -47,45 +62,67 @@ struct Vector3 {
     float y;
     float z;
 
-    Vector3() : x(0), y(0), z(0) {}
-    Vector3(float x, float y, float z) : x(x), y(y), z(z) {}
+    constexpr Vector3() : x(0), y(0), z(0) {}
+    constexpr Vector3(float x, float y, float z) : x(x), y(y), z(z) {}
+
+    static constexpr Vector3 zero() { return Vector3(0.0f, 0.0f, 0.0f); }
+    static constexpr Vector3 one() { return Vector3(1.0f, 1.0f, 1.0f); }
+    static constexpr Vector3 unitX() { return Vector3(1.0f, 0.0f, 0.0f); }
+    static constexpr Vector3 unitY() { return Vector3(0.0f, 1.0f, 0.0f); }
+    static constexpr Vector3 unitZ() { return Vector3(0.0f, 0.0f, 1.0f); }
 
-    Vector3 operator+(const Vector3& other) const {
+    constexpr Vector3 operator+(const Vector3& other) const {
         return Vector3(x + other.x, y + other.y, z + other.z);
     }
 
-    Vector3 operator-(const Vector3& other) const {
+    constexpr Vector3 operator-(const Vector3& other) const {
         return Vector3(x - other.x, y - other.y, z - other.z);
     }
 
-    Vector3 operator-() const {
+    constexpr Vector3 operator-() const {
         return Vector3(-x, -y, -z);
     }
 
-    Vector3 operator*(float scalar) const {
+    constexpr Vector3 operator*(float scalar) const {
         return Vector3(x * scalar, y * scalar, z * scalar);
     }
 
-    Vector3 operator/(float scalar) const {
+    constexpr Vector3 operator/(float scalar) const {
         return Vector3(x / scalar, y / scalar, z / scalar);
     }
     
-    bool operator==(const Vector3& other) const {
+    constexpr bool operator==(const Vector3& other) const {
         return (x == other.x) && (y == other.y) && (z == other.z);
     }
 
     // Length and normalization
-    float length() const;
-    float lengthSquared() const;
-    mathplease::Vector3 normalized() const;
-    void normalize();
+    float length() const { return std::sqrt(x * x + y * y + z * z); }
+    constexpr float lengthSquared() const { return x * x + y * y + z * z; }
+    mathplease::Vector3 normalized() const {
+        float len = length();
+        if (len <= kEpsilon) return Vector3(0.0f, 0.0f, 0.0f);
+        return Vector3(x / len, y / len, z / len);
+    }
+    void normalize() {
+        float len = length();
+        if (len <= kEpsilon) {
+            x = 0.0f; y = 0.0f; z = 0.0f; return;
+        }
+        x /= len; y /= len; z /= len;
+    }
 
     // Dot, cross and distance
-    float dot(const mathplease::Vector3& other) const;
-    static float dot(const mathplease::Vector3& a, const mathplease::Vector3& b);
-    mathplease::Vector3 cross(const mathplease::Vector3& other) const;
-    static mathplease::Vector3 cross(const mathplease::Vector3& a, const mathplease::Vector3& b);
-    float distance(const mathplease::Vector3& other) const;
+    constexpr float dot(const mathplease::Vector3& other) const { return x * other.x + y * other.y + z * other.z; }
+    static constexpr float dot(const mathplease::Vector3& a, const mathplease::Vector3& b) { return a.dot(b); }
+    constexpr mathplease::Vector3 cross(const mathplease::Vector3& other) const {
+        return Vector3(
+            y * other.z - z * other.y,
+            z * other.x - x * other.z,
+            x * other.y - y * other.x
+        );
+    }
+    static constexpr mathplease::Vector3 cross(const mathplease::Vector3& a, const mathplease::Vector3& b) { return a.cross(b); }
+    float distance(const mathplease::Vector3& other) const { return (*this - other).length(); }
 };
 
 struct Vector4 {
@@ -94,39 +131,49 @@ struct Vector4 {
     float z;
     float w;
 
-    Vector4() : x(0), y(0), z(0), w(0) {}
-    Vector4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
-    Vector4(const mathplease::Vector3& v3, float w) : x(v3.x), y(v3.y), z(v3.z), w(w) {}
+    constexpr Vector4() : x(0), y(0), z(0), w(0) {}
+    constexpr Vector4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+    constexpr Vector4(const mathplease::Vector3& v3, float w) : x(v3.x), y(v3.y), z(v3.z), w(w) {}
 
-    Vector4 operator+(const Vector4& other) const {
+    constexpr Vector4 operator+(const Vector4& other) const {
         return Vector4(x + other.x, y + other.y, z + other.z, w + other.w);
     }
 
-    Vector4 operator-(const Vector4& other) const {
+    constexpr Vector4 operator-(const Vector4& other) const {
         return Vector4(x - other.x, y - other.y, z - other.z, w - other.w);
     }
 
-    Vector4 operator*(float scalar) const {
+    constexpr Vector4 operator*(float scalar) const {
         return Vector4(x * scalar, y * scalar, z * scalar, w * scalar);
     }
 
-    Vector4 operator/(float scalar) const {
+    constexpr Vector4 operator/(float scalar) const {
         return Vector4(x / scalar, y / scalar, z / scalar, w / scalar);
     }
 
     // Length and normalization
-    float length() const;
-    float lengthSquared() const;
-    Vector4 normalized() const;
-    void normalize();
+    float length() const { return std::sqrt(x * x + y * y + z * z + w * w); }
+    constexpr float lengthSquared() const { return x * x + y * y + z * z + w * w; }
+    Vector4 normalized() const {
+        float len = length();
+        if (len <= kEpsilon) return Vector4(0.0f, 0.0f, 0.0f, 0.0f);
+        return Vector4(x / len, y / len, z / len, w / len);
+    }
+    void normalize() {
+        float len = length();
+        if (len <= kEpsilon) {
+            x = 0.0f; y = 0.0f; z = 0.0f; w = 0.0f; return;
+        }
+        x /= len; y /= len; z /= len; w /= len;
+    }
 
     // Dot and distance
-    float dot(const Vector4& other) const;
-    static float dot(const Vector4& a, const Vector4& b);
-    float distance(const Vector4& other) const;
+    constexpr float dot(const Vector4& other) const { return x * other.x + y * other.y + z * other.z + w * other.w; }
+    static constexpr float dot(const Vector4& a, const Vector4& b) { return a.dot(b); }
+    float distance(const Vector4& other) const { return (*this - other).length(); }
 
     // Conversion
-    mathplease::Vector3 xyz() const { return mathplease::Vector3(x, y, z); }
+    constexpr mathplease::Vector3 xyz() const { return mathplease::Vector3(x, y, z); }
 };
 
 struct Matrix4 {
@@ -134,48 +181,177 @@ struct Matrix4 {
     float m[16];
 
     // Constructors
-    Matrix4();
-    Matrix4(float diagonal);
-    Matrix4(const float* data);
+    constexpr Matrix4() : m{} {}
+    constexpr Matrix4(float diagonal) : m{} { m[0] = m[5] = m[10] = m[15] = diagonal; }
+    constexpr Matrix4(const float* data) : m{} {
+        for (int i = 0; i < 16; ++i) m[i] = data[i];
+    }
     
     // Static factory methods
-    static Matrix4 identity();
-    static Matrix4 translate(const mathplease::Vector3& translation);
+    static constexpr Matrix4 identity() { return Matrix4(1.0f); }
+    static constexpr Matrix4 translate(const mathplease::Vector3& translation) {
+        Matrix4 result(1.0f);
+        result(0, 3) = translation.x;
+        result(1, 3) = translation.y;
+        result(2, 3) = translation.z;
+        return result;
+    }
     static Matrix4 rotate(const mathplease::Vector3& axis, float angleRadians);
     static Matrix4 rotateX(float angleRadians);
     static Matrix4 rotateY(float angleRadians);
     static Matrix4 rotateZ(float angleRadians);
-    static Matrix4 scale(const mathplease::Vector3& scale);
-    static Matrix4 scale(float uniformScale);
+    static constexpr Matrix4 scale(const mathplease::Vector3& scale) {
+        Matrix4 result(1.0f);
+        result(0, 0) = scale.x;
+        result(1, 1) = scale.y;
+        result(2, 2) = scale.z;
+        return result;
+    }
+    static constexpr Matrix4 scale(float uniformScale) {
+        return scale(mathplease::Vector3(uniformScale, uniformScale, uniformScale));
+    }
     
     // Camera/projection matrices
     static Matrix4 perspective(float fovYRadians, float aspectRatio, float nearPlane, float farPlane);
     static Matrix4 orthographic(float left, float right, float bottom, float top, float nearPlane, float farPlane);
     static Matrix4 lookAt(const mathplease::Vector3& eye, const mathplease::Vector3& center, const mathplease::Vector3& up);
 
-    // Matrix operations
+    // Matrix operations. Multiplication, transpose and inverse are inline
+    // and vectorised, see matrix_simd.hpp; in constant expressions the
+    // constexpr ones use the scalar code
     Matrix4 operator+(const Matrix4& other) const;
     Matrix4 operator-(const Matrix4& other) const;
-    Matrix4 operator*(const Matrix4& other) const;
+    constexpr Matrix4 operator*(const Matrix4& other) const;
     Matrix4 operator*(float scalar) const;
     
-    Vector4 operator*(const Vector4& vec) const;
+    constexpr Vector4 operator*(const Vector4& vec) const;
     mathplease::Vector3 transformPoint(const mathplease::Vector3& point) const;
     mathplease::Vector3 transformVector(const mathplease::Vector3& vector) const;
     
     // Matrix properties
-    Matrix4 transposed() const;
+    constexpr Matrix4 transposed() const;
     Matrix4 inverse() const;
     float determinant() const;
     
     
     // Element access
-    float& operator()(int row, int col) { return m[col * 4 + row]; }
-    const float& operator()(int row, int col) const { return m[col * 4 + row]; }
+    constexpr float& operator()(int row, int col) { return m[col * 4 + row]; }
+    constexpr const float& operator()(int row, int col) const { return m[col * 4 + row]; }
     
     // Data access
-    const float* data() const { return m; }
-    float* data() { return m; }
+    constexpr const float* data() const { return m; }
+    constexpr float* data() { return m; }
+};
+
+/** Unit quaternion rotation (x, y, z vector part, w scalar part) */
+struct Quaternion {
+    float x;
+    float y;
+    float z;
+    float w;
+
+    constexpr Quaternion() : x(0), y(0), z(0), w(1) {}
+    constexpr Quaternion(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+
+    static constexpr Quaternion identity() { return Quaternion(); }
+    static Quaternion fromAxisAngle(const mathplease::Vector3& axis, float angleRadians);
+
+    /** Hamilton product: rotating by the result applies `other` first, then this */
+    Quaternion operator*(const Quaternion& other) const;
+    constexpr bool operator==(const Quaternion& other) const {
+        return (x == other.x) && (y == other.y) && (z == other.z) && (w == other.w);
+    }
+
+    constexpr float dot(const Quaternion& other) const { return x * other.x + y * other.y + z * other.z + w * other.w; }
+    float length() const;
+    Quaternion normalized() const;
+    constexpr Quaternion conjugate() const { return Quaternion(-x, -y, -z, w); }
+    /** General inverse, conjugate() / dot(*this), identity if near zero; prefer conjugate() for unit quaternions */
+    Quaternion inverse() const;
+
+    mathplease::Vector3 rotate(const mathplease::Vector3& v) const;
+    Matrix4 toMatrix() const;
+
+    // Interpolation along the shorter arc. nlerp is cheaper and fine for
+    // small steps (animation blending); slerp keeps constant angular speed
+    static Quaternion nlerp(const Quaternion& a, const Quaternion& b, float t);
+    static Quaternion slerp(const Quaternion& a, const Quaternion& b, float t);
 };
 
-} // namespace mathplease
\ No newline at end of file
+/**
+ * Affine transform stored as a 3x4 matrix (column-major: three basis columns,
+ * then translation) with an implied 0 0 0 1 bottom row. Composing two costs
+ * 36 multiplies instead of the 64 of Matrix4, and the inverse only has to
+ * invert the 3x3 part.
+ */
+struct Transform {
+    float m[12];
+
+    constexpr Transform() : m{1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f} {} // identity
+
+    static constexpr Transform identity() { return Transform(); }
+    /** T * R * S without building intermediate matrices */
+    static Transform fromTRS(const mathplease::Vector3& translation, const Quaternion& rotation,
+                             const mathplease::Vector3& scale);
+    /** Drops the bottom row; only meaningful for affine matrices */
+    static Transform fromMatrix4(const Matrix4& matrix);
+
+    Transform operator*(const Transform& other) const;
+    /** General affine inverse (handles non-uniform scale); identity if singular */
+    Transform inverse() const;
+
+    mathplease::Vector3 transformPoint(const mathplease::Vector3& point) const;
+    mathplease::Vector3 transformVector(const mathplease::Vector3& vector) const;
+    constexpr mathplease::Vector3 translation() const { return mathplease::Vector3(m[9], m[10], m[11]); }
+    Matrix4 toMatrix4() const;
+
+    // Element access, rows 0-2 and columns 0-3
+    constexpr float& operator()(int row, int col) { return m[col * 3 + row]; }
+    constexpr const float& operator()(int row, int col) const { return m[col * 3 + row]; }
+};
+
+/**
+ * Portable reference versions of the vectorised Matrix4 operations, used
+ * when no SIMD backend is available, in constant expressions, and by tests
+ * and benchmarks to check the SIMD paths against.
+ */
+namespace scalar {
+constexpr Matrix4 multiply(const Matrix4& a, const Matrix4& b) {
+    Matrix4 result;
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            result(i, j) = 0.0f;
+            for (int k = 0; k < 4; ++k) {
+                result(i, j) += a(i, k) * b(k, j);
+            }
+        }
+    }
+    return result;
+}
+
+constexpr Vector4 transform(const Matrix4& a, const Vector4& vec) {
+    const float* m = a.m;
+    return Vector4(
+        m[0] * vec.x + m[4] * vec.y + m[8]  * vec.z + m[12] * vec.w,
+        m[1] * vec.x + m[5] * vec.y + m[9]  * vec.z + m[13] * vec.w,
+        m[2] * vec.x + m[6] * vec.y + m[10] * vec.z + m[14] * vec.w,
+        m[3] * vec.x + m[7] * vec.y + m[11] * vec.z + m[15] * vec.w
+    );
+}
+
+constexpr Matrix4 transpose(const Matrix4& a) {
+    Matrix4 result;
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            result(i, j) = a(j, i);
+        }
+    }
+    return result;
+}
+
+Matrix4 inverse(const Matrix4& a);
+} // namespace scalar
+
+} // namespace mathplease
+
+#include "matrix_simd.hpp"
@@ -0,0 +1,484 @@
+#include "vertex_packing.hpp"
+#include <algorithm>
+#include <bit>
+#include <cfloat>
+#include <cmath>
+
+#if defined(MATHPLEASE_SIMD_SSE) && defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+namespace mathplease {
+
+namespace {
+
+// The scalar functions below are the reference: each SIMD kernel performs
+// the same IEEE operations in the same order, and rounds float to integer
+// to nearest even like lrint in the default rounding mode.
+
+int32_t roundToInt(float value) {
+    return static_cast<int32_t>(std::lrint(value));
+}
+
+float clampf(float value, float lo, float hi) {
+    return std::min(std::max(value, lo), hi);
+}
+
+uint32_t snorm16(float value) {
+    return static_cast<uint32_t>(roundToInt(clampf(value, -1.0f, 1.0f) * 32767.0f)) & 0xffffu;
+}
+
+uint32_t unorm(float value, float scale) {
+    return static_cast<uint32_t>(roundToInt(clampf(value, 0.0f, 1.0f) * scale));
+}
+
+float fromSnorm16(uint32_t bits) {
+    return std::max(static_cast<float>(static_cast<int16_t>(bits)) / 32767.0f, -1.0f);
+}
+
+Vector3 inverseExtent(const PositionQuantization& quantization) {
+    const Vector3& e = quantization.extent;
+    return Vector3(e.x > 0.0f ? 1.0f / e.x : 0.0f, e.y > 0.0f ? 1.0f / e.y : 0.0f,
+                   e.z > 0.0f ? 1.0f / e.z : 0.0f);
+}
+
+Unorm16x4 quantize(const Vector3& offset, const Vector3& inverse, const Vector3& p) {
+    return Unorm16x4{static_cast<uint16_t>(unorm((p.x - offset.x) * inverse.x, 65535.0f)),
+                     static_cast<uint16_t>(unorm((p.y - offset.y) * inverse.y, 65535.0f)),
+                     static_cast<uint16_t>(unorm((p.z - offset.z) * inverse.z, 65535.0f)), 0xffff};
+}
+
+// Four-wide float and integer helpers. Lanes are gathered from the strided
+// arrays with set4 and scattered through small aligned buffers (writing lanes
+// to a buffer and loading it as a vector would stall store forwarding); only
+// the arithmetic is vectorised. AArch64 only on ARM: ARMv7 NEON has no divide and no
+// round-to-nearest conversion.
+#if defined(MATHPLEASE_SIMD_SSE)
+#define MATHPLEASE_PACK_SIMD 1
+using f32x4 = __m128;
+using u32x4 = __m128i;
+
+inline f32x4 set4(float a, float b, float c, float d) { return _mm_setr_ps(a, b, c, d); }
+inline u32x4 set4(uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
+    return _mm_setr_epi32(static_cast<int32_t>(a), static_cast<int32_t>(b), static_cast<int32_t>(c),
+                          static_cast<int32_t>(d));
+}
+inline void store(uint32_t* p, u32x4 v) { _mm_store_si128(reinterpret_cast<__m128i*>(p), v); }
+inline void store(float* p, f32x4 v) { _mm_store_ps(p, v); }
+inline f32x4 splat(float value) { return _mm_set1_ps(value); }
+inline u32x4 splatU(uint32_t value) { return _mm_set1_epi32(static_cast<int32_t>(value)); }
+inline f32x4 add(f32x4 a, f32x4 b) { return _mm_add_ps(a, b); }
+inline f32x4 sub(f32x4 a, f32x4 b) { return _mm_sub_ps(a, b); }
+inline f32x4 mul(f32x4 a, f32x4 b) { return _mm_mul_ps(a, b); }
+inline f32x4 div(f32x4 a, f32x4 b) { return _mm_div_ps(a, b); }
+inline f32x4 squareRoot(f32x4 a) { return _mm_sqrt_ps(a); }
+// Unlike std::max/std::min these may pick the other zero when comparing -0
+// with +0; everything clamped here is then rounded to an integer, so the
+// results still match the scalar code
+inline f32x4 maximum(f32x4 a, f32x4 b) { return _mm_max_ps(a, b); }
+inline f32x4 minimum(f32x4 a, f32x4 b) { return _mm_min_ps(a, b); }
+inline f32x4 absolute(f32x4 a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+/** copysign(1, a) */
+inline f32x4 signOf(f32x4 a) { return _mm_or_ps(_mm_set1_ps(1.0f), _mm_and_ps(_mm_set1_ps(-0.0f), a)); }
+inline f32x4 lessThan(f32x4 a, f32x4 b) { return _mm_cmplt_ps(a, b); }
+inline f32x4 greaterEqual(f32x4 a, f32x4 b) { return _mm_cmpge_ps(a, b); }
+/** mask ? a : b */
+inline f32x4 select(f32x4 mask, f32x4 a, f32x4 b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+inline u32x4 toInt(f32x4 a) { return _mm_cvtps_epi32(a); }
+inline f32x4 toFloat(u32x4 a) { return _mm_cvtepi32_ps(a); }
+inline u32x4 andU(u32x4 a, u32x4 b) { return _mm_and_si128(a, b); }
+inline u32x4 orU(u32x4 a, u32x4 b) { return _mm_or_si128(a, b); }
+template <int N> inline u32x4 shiftLeft(u32x4 a) { return _mm_slli_epi32(a, N); }
+template <int N> inline u32x4 shiftRight(u32x4 a) { return _mm_srli_epi32(a, N); }
+/** Sign extends the low 16 bits of each lane */
+inline u32x4 signExtend16(u32x4 a) { return _mm_srai_epi32(_mm_slli_epi32(a, 16), 16); }
+#elif defined(MATHPLEASE_SIMD_NEON) && defined(__aarch64__)
+#define MATHPLEASE_PACK_SIMD 1
+using f32x4 = float32x4_t;
+using u32x4 = uint32x4_t;
+
+inline f32x4 set4(float a, float b, float c, float d) {
+    return vsetq_lane_f32(d, vsetq_lane_f32(c, vsetq_lane_f32(b, vdupq_n_f32(a), 1), 2), 3);
+}
+inline u32x4 set4(uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
+    return vsetq_lane_u32(d, vsetq_lane_u32(c, vsetq_lane_u32(b, vdupq_n_u32(a), 1), 2), 3);
+}
+inline void store(uint32_t* p, u32x4 v) { vst1q_u32(p, v); }
+inline void store(float* p, f32x4 v) { vst1q_f32(p, v); }
+inline f32x4 splat(float value) { return vdupq_n_f32(value); }
+inline u32x4 splatU(uint32_t value) { return vdupq_n_u32(value); }
+inline f32x4 add(f32x4 a, f32x4 b) { return vaddq_f32(a, b); }
+inline f32x4 sub(f32x4 a, f32x4 b) { return vsubq_f32(a, b); }
+inline f32x4 mul(f32x4 a, f32x4 b) { return vmulq_f32(a, b); }
+inline f32x4 div(f32x4 a, f32x4 b) { return vdivq_f32(a, b); }
+inline f32x4 squareRoot(f32x4 a) { return vsqrtq_f32(a); }
+inline f32x4 maximum(f32x4 a, f32x4 b) { return vmaxq_f32(a, b); }
+inline f32x4 minimum(f32x4 a, f32x4 b) { return vminq_f32(a, b); }
+inline f32x4 absolute(f32x4 a) { return vabsq_f32(a); }
+inline f32x4 signOf(f32x4 a) {
+    return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(vdupq_n_f32(1.0f)),
+                                           vandq_u32(vreinterpretq_u32_f32(a), vdupq_n_u32(0x80000000u))));
+}
+inline f32x4 lessThan(f32x4 a, f32x4 b) { return vreinterpretq_f32_u32(vcltq_f32(a, b)); }
+inline f32x4 greaterEqual(f32x4 a, f32x4 b) { return vreinterpretq_f32_u32(vcgeq_f32(a, b)); }
+inline f32x4 select(f32x4 mask, f32x4 a, f32x4 b) { return vbslq_f32(vreinterpretq_u32_f32(mask), a, b); }
+inline u32x4 toInt(f32x4 a) { return vreinterpretq_u32_s32(vcvtnq_s32_f32(a)); }
+inline f32x4 toFloat(u32x4 a) { return vcvtq_f32_s32(vreinterpretq_s32_u32(a)); }
+inline u32x4 andU(u32x4 a, u32x4 b) { return vandq_u32(a, b); }
+inline u32x4 orU(u32x4 a, u32x4 b) { return vorrq_u32(a, b); }
+template <int N> inline u32x4 shiftLeft(u32x4 a) { return vshlq_n_u32(a, N); }
+template <int N> inline u32x4 shiftRight(u32x4 a) { return vshrq_n_u32(a, N); }
+inline u32x4 signExtend16(u32x4 a) {
+    return vreinterpretq_u32_s32(vshrq_n_s32(vreinterpretq_s32_u32(vshlq_n_u32(a, 16)), 16));
+}
+#endif
+
+#if defined(MATHPLEASE_PACK_SIMD)
+inline f32x4 clamp4(f32x4 value, float lo, float hi) {
+    return minimum(maximum(value, splat(lo)), splat(hi));
+}
+
+inline u32x4 snorm16x4(f32x4 value) {
+    return andU(toInt(mul(clamp4(value, -1.0f, 1.0f), splat(32767.0f))), splatU(0xffffu));
+}
+
+inline f32x4 fromSnorm16x4(u32x4 bits) {
+    return maximum(div(toFloat(signExtend16(bits)), splat(32767.0f)), splat(-1.0f));
+}
+
+u32x4 encodeOctahedral4(f32x4 x, f32x4 y, f32x4 z) {
+    const f32x4 l1 = maximum(add(add(absolute(x), absolute(y)), absolute(z)), splat(FLT_MIN));
+    const f32x4 u = div(x, l1);
+    const f32x4 v = div(y, l1);
+    const f32x4 one = splat(1.0f);
+    const f32x4 lower = lessThan(z, splat(0.0f));
+    const f32x4 foldedU = select(lower, mul(sub(one, absolute(v)), signOf(u)), u);
+    const f32x4 foldedV = select(lower, mul(sub(one, absolute(u)), signOf(v)), v);
+    return orU(snorm16x4(foldedU), shiftLeft<16>(snorm16x4(foldedV)));
+}
+
+void decodeOctahedral4(u32x4 packed, f32x4& x, f32x4& y, f32x4& z) {
+    f32x4 u = fromSnorm16x4(packed);
+    f32x4 v = fromSnorm16x4(shiftRight<16>(packed));
+    const f32x4 w = sub(sub(splat(1.0f), absolute(u)), absolute(v));
+    const f32x4 t = maximum(sub(splat(0.0f), w), splat(0.0f));
+    const f32x4 negT = sub(splat(0.0f), t);
+    u = add(u, select(greaterEqual(u, splat(0.0f)), negT, t));
+    v = add(v, select(greaterEqual(v, splat(0.0f)), negT, t));
+    const f32x4 length = squareRoot(add(add(mul(u, u), mul(v, v)), mul(w, w)));
+    x = div(u, length);
+    y = div(v, length);
+    z = div(w, length);
+}
+#endif
+
+// binary16 conversion with integer operations (after Fabian Giesen's
+// float_to_half_fast3_rtne and half_to_float_fast4), identical to F16C and
+// the ARMv8 instructions for every non-NaN input
+#if defined(MATHPLEASE_SIMD_SSE) && !defined(__F16C__)
+__m128i floatToHalf4(__m128 value) {
+    const __m128i bits = _mm_castps_si128(value);
+    const __m128i sign = _mm_and_si128(bits, _mm_set1_epi32(static_cast<int32_t>(0x80000000u)));
+    const __m128i x = _mm_xor_si128(bits, sign);
+
+    const __m128i infOrNan = _mm_cmpgt_epi32(x, _mm_set1_epi32(0x477fffff));
+    const __m128i isNan = _mm_cmpgt_epi32(x, _mm_set1_epi32(0x7f800000));
+    const __m128i nanPayload = _mm_or_si128(_mm_set1_epi32(0x200),
+                                            _mm_and_si128(_mm_srli_epi32(x, 13), _mm_set1_epi32(0x3ff)));
+    const __m128i special = _mm_or_si128(_mm_set1_epi32(0x7c00), _mm_and_si128(isNan, nanPayload));
+
+    const __m128i subnormal = _mm_cmplt_epi32(x, _mm_set1_epi32(0x38800000));
+    const __m128 magic = _mm_castsi128_ps(_mm_set1_epi32(0x3f000000));
+    const __m128i small = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(x), magic)),
+                                        _mm_castps_si128(magic));
+
+    const __m128i mantissaOdd = _mm_and_si128(_mm_srli_epi32(x, 13), _mm_set1_epi32(1));
+    const __m128i rebias = _mm_set1_epi32(static_cast<int32_t>(0xc8000fffu));
+    const __m128i normal = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(x, rebias), mantissaOdd), 13);
+
+    __m128i half = _mm_or_si128(_mm_and_si128(subnormal, small), _mm_andnot_si128(subnormal, normal));
+    half = _mm_or_si128(_mm_and_si128(infOrNan, special), _mm_andnot_si128(infOrNan, half));
+    return _mm_or_si128(half, _mm_srli_epi32(sign, 16));
+}
+
+__m128 halfToFloat4(__m128i half) {
+    const __m128i shifted = _mm_slli_epi32(_mm_and_si128(half, _mm_set1_epi32(0x7fff)), 13);
+    const __m128i exponent = _mm_and_si128(shifted, _mm_set1_epi32(0x0f800000));
+    const __m128i rebias = _mm_set1_epi32(0x38000000);
+    __m128i bits = _mm_add_epi32(shifted, rebias);
+
+    const __m128i infOrNan = _mm_cmpeq_epi32(exponent, _mm_set1_epi32(0x0f800000));
+    bits = _mm_add_epi32(bits, _mm_and_si128(infOrNan, rebias));
+
+    const __m128i subnormal = _mm_cmpeq_epi32(exponent, _mm_setzero_si128());
+    const __m128 magic = _mm_castsi128_ps(_mm_set1_epi32(113 << 23));
+    const __m128i renormalised = _mm_castps_si128(
+        _mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(bits, _mm_set1_epi32(1 << 23))), magic));
+    bits = _mm_or_si128(_mm_and_si128(subnormal, renormalised), _mm_andnot_si128(subnormal, bits));
+
+    const __m128i sign = _mm_slli_epi32(_mm_and_si128(half, _mm_set1_epi32(0x8000)), 16);
+    return _mm_castsi128_ps(_mm_or_si128(bits, sign));
+}
+#endif
+
+// Four Half2, each as a uint32 x | y << 16, to and from lanes of x and y
+#if defined(MATHPLEASE_SIMD_SSE)
+u32x4 encodeHalf2x4(f32x4 x, f32x4 y) {
+#if defined(__F16C__)
+    return _mm_unpacklo_epi16(_mm_cvtps_ph(x, _MM_FROUND_TO_NEAREST_INT), _mm_cvtps_ph(y, _MM_FROUND_TO_NEAREST_INT));
+#else
+    return _mm_or_si128(floatToHalf4(x), _mm_slli_epi32(floatToHalf4(y), 16));
+#endif
+}
+
+void decodeHalf2x4(u32x4 packed, f32x4& x, f32x4& y) {
+#if defined(__F16C__)
+    // narrow to four packed halves; sign extending first keeps packs from saturating
+    x = _mm_cvtph_ps(_mm_packs_epi32(signExtend16(packed), _mm_setzero_si128()));
+    y = _mm_cvtph_ps(_mm_packs_epi32(_mm_srai_epi32(packed, 16), _mm_setzero_si128()));
+#else
+    x = halfToFloat4(_mm_and_si128(packed, _mm_set1_epi32(0xffff)));
+    y = halfToFloat4(_mm_srli_epi32(packed, 16));
+#endif
+}
+#elif defined(MATHPLEASE_PACK_SIMD)
+u32x4 encodeHalf2x4(f32x4 x, f32x4 y) {
+    const uint16x4_t hx = vreinterpret_u16_f16(vcvt_f16_f32(x));
+    const uint16x4_t hy = vreinterpret_u16_f16(vcvt_f16_f32(y));
+    return vorrq_u32(vmovl_u16(hx), vshlq_n_u32(vmovl_u16(hy), 16));
+}
+
+void decodeHalf2x4(u32x4 packed, f32x4& x, f32x4& y) {
+    x = vcvt_f32_f16(vreinterpret_f16_u16(vmovn_u32(packed)));
+    y = vcvt_f32_f16(vreinterpret_f16_u16(vshrn_n_u32(packed, 16)));
+}
+#endif
+
+} // namespace
+
+uint16_t floatToHalf(float value) {
+    uint32_t x = std::bit_cast<uint32_t>(value);
+    const uint32_t sign = x & 0x80000000u;
+    x ^= sign;
+
+    uint32_t half;
+    if (x >= 0x47800000u) {
+        // 65536 and up, infinity or NaN (quietened, top payload bits kept)
+        half = x > 0x7f800000u ? 0x7e00u | ((x >> 13) & 0x3ffu) : 0x7c00u;
+    } else if (x < 0x38800000u) {
+        // subnormal or zero: let the FPU round the mantissa into place
+        const float magic = std::bit_cast<float>(0x3f000000u);
+        half = std::bit_cast<uint32_t>(std::bit_cast<float>(x) + magic) - 0x3f000000u;
+    } else {
+        const uint32_t mantissaOdd = (x >> 13) & 1u;
+        half = (x + 0xc8000fffu + mantissaOdd) >> 13;
+    }
+    return static_cast<uint16_t>(half | (sign >> 16));
+}
+
+float halfToFloat(uint16_t half) {
+    uint32_t bits = static_cast<uint32_t>(half & 0x7fffu) << 13;
+    const uint32_t exponent = bits & 0x0f800000u;
+    bits += 0x38000000u;
+    if (exponent == 0x0f800000u) {
+        bits += 0x38000000u;
+    } else if (exponent == 0) {
+        const float magic = std::bit_cast<float>(113u << 23);
+        bits = std::bit_cast<uint32_t>(std::bit_cast<float>(bits + (1u << 23)) - magic);
+    }
+    return std::bit_cast<float>(bits | static_cast<uint32_t>(half & 0x8000u) << 16);
+}
+
+uint32_t encodeOctahedral(const Vector3& unitVector) {
+    const float l1 = std::max(std::fabs(unitVector.x) + std::fabs(unitVector.y) + std::fabs(unitVector.z), FLT_MIN);
+    float u = unitVector.x / l1;
+    float v = unitVector.y / l1;
+    if (unitVector.z < 0.0f) {
+        const float foldedU = (1.0f - std::fabs(v)) * std::copysign(1.0f, u);
+        const float foldedV = (1.0f - std::fabs(u)) * std::copysign(1.0f, v);
+        u = foldedU;
+        v = foldedV;
+    }
+    return snorm16(u) | snorm16(v) << 16;
+}
+
+Vector3 decodeOctahedral(uint32_t packed) {
+    float u = fromSnorm16(packed);
+    float v = fromSnorm16(packed >> 16);
+    const float w = 1.0f - std::fabs(u) - std::fabs(v);
+    const float t = std::max(0.0f - w, 0.0f);
+    u = u + (u >= 0.0f ? 0.0f - t : t);
+    v = v + (v >= 0.0f ? 0.0f - t : t);
+    const float length = std::sqrt(u * u + v * v + w * w);
+    return Vector3(u / length, v / length, w / length);
+}
+
+uint32_t packUnorm4x8(const Vector4& value) {
+    return unorm(value.x, 255.0f) | unorm(value.y, 255.0f) << 8 | unorm(value.z, 255.0f) << 16 |
+           unorm(value.w, 255.0f) << 24;
+}
+
+Vector4 unpackUnorm4x8(uint32_t packed) {
+    return Vector4(static_cast<float>(packed & 0xffu) / 255.0f, static_cast<float>((packed >> 8) & 0xffu) / 255.0f,
+                   static_cast<float>((packed >> 16) & 0xffu) / 255.0f, static_cast<float>(packed >> 24) / 255.0f);
+}
+
+PositionQuantization PositionQuantization::fromBounds(const AABB& bounds) {
+    return PositionQuantization{bounds.min, bounds.max - bounds.min};
+}
+
+Unorm16x4 quantizePosition(const PositionQuantization& quantization, const Vector3& position) {
+    return quantize(quantization.offset, inverseExtent(quantization), position);
+}
+
+Vector3 dequantizePosition(const PositionQuantization& quantization, const Unorm16x4& packed) {
+    const Vector3& o = quantization.offset;
+    const Vector3& e = quantization.extent;
+    return Vector3(o.x + static_cast<float>(packed.x) / 65535.0f * e.x,
+                   o.y + static_cast<float>(packed.y) / 65535.0f * e.y,
+                   o.z + static_cast<float>(packed.z) / 65535.0f * e.z);
+}
+
+void encodeHalf2(Strided<const Vector2> in, Strided<Half2> out, size_t count) {
+    size_t i = 0;
+#if defined(MATHPLEASE_PACK_SIMD)
+    alignas(16) uint32_t packed[4];
+    for (; i + 4 <= count; i += 4) {
+        const Vector2 &a = in[i], &b = in[i + 1], &c = in[i + 2], &d = in[i + 3];
+        store(packed, encodeHalf2x4(set4(a.x, b.x, c.x, d.x), set4(a.y, b.y, c.y, d.y)));
+        for (int lane = 0; lane < 4; ++lane) out[i + lane] = std::bit_cast<Half2>(packed[lane]);
+    }
+#endif
+    for (; i < count; ++i) out[i] = Half2{floatToHalf(in[i].x), floatToHalf(in[i].y)};
+}
+
+void decodeHalf2(Strided<const Half2> in, Strided<Vector2> out, size_t count) {
+    size_t i = 0;
+#if defined(MATHPLEASE_PACK_SIMD)
+    alignas(16) float x[4], y[4];
+    const auto bits = [](const Half2& h) { return std::bit_cast<uint32_t>(h); };
+    for (; i + 4 <= count; i += 4) {
+        f32x4 vx, vy;
+        decodeHalf2x4(set4(bits(in[i]), bits(in[i + 1]), bits(in[i + 2]), bits(in[i + 3])), vx, vy);
+        store(x, vx);
+        store(y, vy);
+        for (int lane = 0; lane < 4; ++lane) out[i + lane] = Vector2(x[lane], y[lane]);
+    }
+#endif
+    for (; i < count; ++i) out[i] = Vector2(halfToFloat(in[i].x), halfToFloat(in[i].y));
+}
+
+void encodeOctahedral(Strided<const Vector3> in, Strided<uint32_t> out, size_t count) {
+    size_t i = 0;
+#if defined(MATHPLEASE_PACK_SIMD)
+    alignas(16) uint32_t packed[4];
+    for (; i + 4 <= count; i += 4) {
+        const Vector3 &a = in[i], &b = in[i + 1], &c = in[i + 2], &d = in[i + 3];
+        store(packed, encodeOctahedral4(set4(a.x, b.x, c.x, d.x), set4(a.y, b.y, c.y, d.y), set4(a.z, b.z, c.z, d.z)));
+        for (int lane = 0; lane < 4; ++lane) out[i + lane] = packed[lane];
+    }
+#endif
+    for (; i < count; ++i) out[i] = encodeOctahedral(in[i]);
+}
+
+void decodeOctahedral(Strided<const uint32_t> in, Strided<Vector3> out, size_t count) {
+    size_t i = 0;
+#if defined(MATHPLEASE_PACK_SIMD)
+    alignas(16) float x[4], y[4], z[4];
+    for (; i + 4 <= count; i += 4) {
+        f32x4 vx, vy, vz;
+        decodeOctahedral4(set4(in[i], in[i + 1], in[i + 2], in[i + 3]), vx, vy, vz);
+        store(x, vx);
+        store(y, vy);
+        store(z, vz);
+        for (int lane = 0; lane < 4; ++lane) out[i + lane] = Vector3(x[lane], y[lane], z[lane]);
+    }
+#endif
+    for (; i < count; ++i) out[i] = decodeOctahedral(in[i]);
+}
+
+void packColours(Strided<const Vector3> in, Strided<uint32_t> out, size_t count) {
+    size_t i = 0;
+#if defined(MATHPLEASE_PACK_SIMD)
+    alignas(16) uint32_t packed[4];
+    const f32x4 scale = splat(255.0f);
+    for (; i + 4 <= count; i += 4) {
+        const Vector3 &a = in[i], &b = in[i + 1], &c = in[i + 2], &d = in[i + 3];
+        const u32x4 red = toInt(mul(clamp4(set4(a.x, b.x, c.x, d.x), 0.0f, 1.0f), scale));
+        const u32x4 green = toInt(mul(clamp4(set4(a.y, b.y, c.y, d.y), 0.0f, 1.0f), scale));
+        const u32x4 blue = toInt(mul(clamp4(set4(a.z, b.z, c.z, d.z), 0.0f, 1.0f), scale));
+        store(packed, orU(orU(red, shiftLeft<8>(green)), orU(shiftLeft<16>(blue), splatU(0xff000000u))));
+        for (int lane = 0; lane < 4; ++lane) out[i + lane] = packed[lane];
+    }
+#endif
+    for (; i < count; ++i) out[i] = packUnorm4x8(Vector4(in[i].x, in[i].y, in[i].z, 1.0f));
+}
+
+void unpackColours(Strided<const uint32_t> in, Strided<Vector3> out, size_t count) {
+    size_t i = 0;
+#if defined(MATHPLEASE_PACK_SIMD)
+    alignas(16) float r[4], g[4], b[4];
+    const f32x4 scale = splat(255.0f);
+    const u32x4 mask = splatU(0xffu);
+    for (; i + 4 <= count; i += 4) {
+        const u32x4 bits = set4(in[i], in[i + 1], in[i + 2], in[i + 3]);
+        store(r, div(toFloat(andU(bits, mask)), scale));
+        store(g, div(toFloat(andU(shiftRight<8>(bits), mask)), scale));
+        store(b, div(toFloat(andU(shiftRight<16>(bits), mask)), scale));
+        for (int lane = 0; lane < 4; ++lane) out[i + lane] = Vector3(r[lane], g[lane], b[lane]);
+    }
+#endif
+    for (; i < count; ++i) {
+        const Vector4 c = unpackUnorm4x8(in[i]);
+        out[i] = Vector3(c.x, c.y, c.z);
+    }
+}
+
+void quantizePositions(const PositionQuantization& quantization, Strided<const Vector3> in,
+                       Strided<Unorm16x4> out, size_t count) {
+    const Vector3 inverse = inverseExtent(quantization);
+    size_t i = 0;
+#if defined(MATHPLEASE_PACK_SIMD)
+    alignas(16) uint32_t xy[4], zw[4];
+    const f32x4 ox = splat(quantization.offset.x), oy = splat(quantization.offset.y), oz = splat(quantization.offset.z);
+    const f32x4 ix = splat(inverse.x), iy = splat(inverse.y), iz = splat(inverse.z);
+    const f32x4 scale = splat(65535.0f);
+    for (; i + 4 <= count; i += 4) {
+        const Vector3 &a = in[i], &b = in[i + 1], &c = in[i + 2], &d = in[i + 3];
+        const u32x4 qx = toInt(mul(clamp4(mul(sub(set4(a.x, b.x, c.x, d.x), ox), ix), 0.0f, 1.0f), scale));
+        const u32x4 qy = toInt(mul(clamp4(mul(sub(set4(a.y, b.y, c.y, d.y), oy), iy), 0.0f, 1.0f), scale));
+        const u32x4 qz = toInt(mul(clamp4(mul(sub(set4(a.z, b.z, c.z, d.z), oz), iz), 0.0f, 1.0f), scale));
+        store(xy, orU(qx, shiftLeft<16>(qy)));
+        store(zw, orU(qz, splatU(0xffff0000u)));
+        for (int lane = 0; lane < 4; ++lane) {
+            const uint64_t word = xy[lane] | static_cast<uint64_t>(zw[lane]) << 32;
+            out[i + lane] = std::bit_cast<Unorm16x4>(word);
+        }
+    }
+#endif
+    for (; i < count; ++i) out[i] = quantize(quantization.offset, inverse, in[i]);
+}
+
+void dequantizePositions(const PositionQuantization& quantization, Strided<const Unorm16x4> in,
+                         Strided<Vector3> out, size_t count) {
+    size_t i = 0;
+#if defined(MATHPLEASE_PACK_SIMD)
+    alignas(16) float x[4], y[4], z[4];
+    const Vector3& o = quantization.offset;
+    const Vector3& e = quantization.extent;
+    const f32x4 scale = splat(65535.0f);
+    for (; i + 4 <= count; i += 4) {
+        const Unorm16x4 &a = in[i], &b = in[i + 1], &c = in[i + 2], &d = in[i + 3];
+        const u32x4 qx = set4(uint32_t{a.x}, uint32_t{b.x}, uint32_t{c.x}, uint32_t{d.x});
+        const u32x4 qy = set4(uint32_t{a.y}, uint32_t{b.y}, uint32_t{c.y}, uint32_t{d.y});
+        const u32x4 qz = set4(uint32_t{a.z}, uint32_t{b.z}, uint32_t{c.z}, uint32_t{d.z});
+        store(x, add(splat(o.x), mul(div(toFloat(qx), scale), splat(e.x))));
+        store(y, add(splat(o.y), mul(div(toFloat(qy), scale), splat(e.y))));
+        store(z, add(splat(o.z), mul(div(toFloat(qz), scale), splat(e.z))));
+        for (int lane = 0; lane < 4; ++lane) out[i + lane] = Vector3(x[lane], y[lane], z[lane]);
+    }
+#endif
+    for (; i < count; ++i) out[i] = dequantizePosition(quantization, in[i]);
+}
+
+} // namespace mathplease
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "batch_kernels.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace mathplease {
+
+/*
+ * Compact encodings for vertex attributes, each matching a Vulkan vertex
+ * format so the GPU unpacks them for free (or with a couple of ALU ops for
+ * octahedral normals). Packed values are little-endian with the first
+ * component at the lowest address, as Vulkan reads them.
+ *
+ * The batch converters take Strided views so they can read and write one
+ * field of an interleaved vertex array in place. They work four elements at
+ * a time on SSE2 (F16C for halves when the build enables it) and AArch64
+ * NEON, and give bit-identical results to the single-value functions.
+ */
+
+/** Two IEEE binary16 values (VK_FORMAT_R16G16_SFLOAT) */
+struct Half2 {
+    uint16_t x = 0;
+    uint16_t y = 0;
+};
+
+/** Four unsigned normalised 16-bit values (VK_FORMAT_R16G16B16A16_UNORM) */
+struct Unorm16x4 {
+    uint16_t x = 0;
+    uint16_t y = 0;
+    uint16_t z = 0;
+    uint16_t w = 0;
+};
+
+/** Element i lives at base + i * stride bytes */
+template <typename T>
+struct Strided {
+    T* base = nullptr;
+    size_t stride = sizeof(T);
+
+    T& operator[](size_t i) const {
+        using Byte = std::conditional_t<std::is_const_v<T>, const std::byte, std::byte>;
+        return *reinterpret_cast<T*>(reinterpret_cast<Byte*>(base) + i * stride);
+    }
+};
+
+/** Round to nearest even; out of range values become infinity, NaNs stay NaN */
+uint16_t floatToHalf(float value);
+float halfToFloat(uint16_t half);
+
+/** Unit vector folded onto the octahedron, as two snorm16 (VK_FORMAT_R16G16_SNORM) */
+uint32_t encodeOctahedral(const Vector3& unitVector);
+/** Always a unit vector; the round trip is within about 7e-5 radians */
+Vector3 decodeOctahedral(uint32_t packed);
+
+/** Components clamped to [0, 1], red in the low byte (VK_FORMAT_R8G8B8A8_UNORM) */
+uint32_t packUnorm4x8(const Vector4& value);
+Vector4 unpackUnorm4x8(uint32_t packed);
+
+/*
+ * Positions stored as unorm16 fractions of the mesh bounds:
+ * position = offset + unorm * extent, per axis. A vertex shader reading
+ * VK_FORMAT_R16G16B16A16_UNORM gets the fraction (w reads as 1) and applies
+ * offset and extent from a uniform. Error is at most extent / 131070.
+ */
+struct PositionQuantization {
+    Vector3 offset;
+    Vector3 extent;
+
+    static PositionQuantization fromBounds(const AABB& bounds);
+};
+
+Unorm16x4 quantizePosition(const PositionQuantization& quantization, const Vector3& position);
+Vector3 dequantizePosition(const PositionQuantization& quantization, const Unorm16x4& packed);
+
+/* Batch versions of the above over count elements */
+void encodeHalf2(Strided<const Vector2> in, Strided<Half2> out, size_t count);
+void decodeHalf2(Strided<const Half2> in, Strided<Vector2> out, size_t count);
+void encodeOctahedral(Strided<const Vector3> in, Strided<uint32_t> out, size_t count);
+void decodeOctahedral(Strided<const uint32_t> in, Strided<Vector3> out, size_t count);
+/** RGB colours with alpha 1 */
+void packColours(Strided<const Vector3> in, Strided<uint32_t> out, size_t count);
+void unpackColours(Strided<const uint32_t> in, Strided<Vector3> out, size_t count);
+void quantizePositions(const PositionQuantization& quantization, Strided<const Vector3> in,
+                       Strided<Unorm16x4> out, size_t count);
+void dequantizePositions(const PositionQuantization& quantization, Strided<const Unorm16x4> in,
+                         Strided<Vector3> out, size_t count);
+
+} // namespace mathplease
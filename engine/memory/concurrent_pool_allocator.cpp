@@ -0,0 +1,215 @@
+#include "concurrent_pool_allocator.h"
+#include <algorithm>
+#include <cassert>
+#include <new>
+
+// Concurrent Pool Allocator Implementation
+
+// Slabs are cache line aligned so block contents (ECS chunks) start aligned.
+static constexpr std::align_val_t SLAB_ALIGNMENT{64};
+
+/*
+ * The global head is one 64-bit word so it can be swapped with a plain
+ * compare-exchange. The tag changes on every push and pop, so a thread that
+ * read the head before another thread popped and re-pushed the same batch
+ * fails its exchange instead of installing a stale next pointer (ABA). On
+ * 64-bit targets the pointer takes the low 48 bits, as user-space addresses
+ * on x86-64 and AArch64 do.
+ */
+namespace {
+constexpr unsigned POINTER_BITS = sizeof(void*) == 8 ? 48 : 32;
+constexpr uint64_t POINTER_MASK = (uint64_t(1) << POINTER_BITS) - 1;
+
+uint64_t nextHead(const void* node, uint64_t previous) {
+    const uint64_t tag = (previous >> POINTER_BITS) + 1;
+    return reinterpret_cast<uintptr_t>(node) | (tag << POINTER_BITS);
+}
+
+template <typename Node>
+Node* headNode(uint64_t head) {
+    return reinterpret_cast<Node*>(static_cast<uintptr_t>(head & POINTER_MASK));
+}
+} // namespace
+
+ConcurrentPoolAllocator::ConcurrentPoolAllocator(size_t block_size, size_t block_count, size_t batch_size,
+                                                 [[maybe_unused]] MemoryTag tag){
+    // round up so every free block's links are naturally aligned
+    block_size_ = (std::max(block_size, sizeof(Node)) + alignof(Node) - 1) & ~(alignof(Node) - 1);
+    block_count_ = block_count;
+    batch_size_ = std::max<size_t>(batch_size, 1);
+    caches_ = std::make_unique<ThreadCache[]>(MAX_THREAD_SLOTS);
+#if LIGHTS_PLEASE_MEMORY_TRACKING
+    tag_ = tag;
+#endif
+}
+
+ConcurrentPoolAllocator::~ConcurrentPoolAllocator(){
+    memory_tracker::UntrackedScope untracked; // slabs are reported block by block
+    for (std::byte* slab : slabs_) {
+        ::operator delete(slab, SLAB_ALIGNMENT);
+    }
+}
+
+ConcurrentPoolAllocator::Node* ConcurrentPoolAllocator::popBatch(){
+    uint64_t head = global_head_.load(std::memory_order_acquire);
+    while (Node* batch = headNode<Node>(head)) {
+        // the batch may already be popped and in use by the time this is
+        // read; the tag check in the exchange then discards the value
+        Node* next = std::atomic_ref<Node*>(batch->nextBatch).load(std::memory_order_relaxed);
+        if (global_head_.compare_exchange_weak(head, nextHead(next, head), std::memory_order_acquire,
+                                               std::memory_order_acquire)) {
+            return batch;
+        }
+    }
+    return nullptr;
+}
+
+void ConcurrentPoolAllocator::pushBatch(Node* batch){
+    uint64_t head = global_head_.load(std::memory_order_relaxed);
+    do {
+        std::atomic_ref<Node*>(batch->nextBatch).store(headNode<Node>(head), std::memory_order_relaxed);
+    } while (!global_head_.compare_exchange_weak(head, nextHead(batch, head), std::memory_order_release,
+                                                 std::memory_order_relaxed));
+}
+
+/*
+ * Carves a new slab into batches, keeps the first one for the caller and
+ * publishes the rest. Under the mutex the global list is checked again so
+ * threads that ran dry together add one slab, not one each.
+ */
+ConcurrentPoolAllocator::Node* ConcurrentPoolAllocator::addSlab(){
+    std::lock_guard<std::mutex> lock(slab_mutex_);
+    if (Node* batch = popBatch()) return batch;
+    if (block_count_ == 0) return nullptr;
+
+    memory_tracker::UntrackedScope untracked;
+    std::byte* memory = static_cast<std::byte*>(::operator new(block_size_ * block_count_, SLAB_ALIGNMENT));
+    assert((reinterpret_cast<uintptr_t>(memory) + block_size_ * block_count_ - 1) <= POINTER_MASK);
+    slabs_.push_back(memory);
+
+    Node* first = nullptr;
+    for (size_t begin = 0; begin < block_count_; begin += batch_size_) {
+        const size_t end = std::min(block_count_, begin + batch_size_);
+        Node* batch = reinterpret_cast<Node*>(memory + begin * block_size_);
+        for (size_t i = begin; i < end; ++i) {
+            Node* node = reinterpret_cast<Node*>(memory + i * block_size_);
+            node->next = i + 1 < end ? reinterpret_cast<Node*>(memory + (i + 1) * block_size_) : nullptr;
+        }
+        batch->count = end - begin;
+        if (first) {
+            pushBatch(batch);
+        } else {
+            first = batch;
+        }
+    }
+    slab_count_.fetch_add(1, std::memory_order_relaxed);
+    return first;
+}
+
+void ConcurrentPoolAllocator::checkOut(size_t blocks){
+    const size_t now = checked_out_.fetch_add(blocks, std::memory_order_relaxed) + blocks;
+    size_t peak = peak_checked_out_.load(std::memory_order_relaxed);
+    while (now > peak && !peak_checked_out_.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+    }
+}
+
+void* ConcurrentPoolAllocator::allocate([[maybe_unused]] memory_tracker::Callsite where){
+    const uint32_t slot = currentThreadSlot();
+    if (slot == THREAD_SLOT_OVERFLOW) {
+        Node* batch = popBatch();
+        if (!batch) batch = addSlab();
+        if (!batch) return nullptr;
+        if (batch->count > 1) {
+            Node* rest = batch->next;
+            rest->count = batch->count - 1;
+            pushBatch(rest);
+        }
+        checkOut(1);
+        overflow_used_.fetch_add(1, std::memory_order_relaxed);
+#if LIGHTS_PLEASE_MEMORY_TRACKING
+        memory_tracker::recordAllocation(batch, block_size_, tag_, where);
+#endif
+        return batch;
+    }
+
+    ThreadCache& cache = caches_[slot];
+    if (!cache.head) {
+        Node* batch = popBatch();
+        if (!batch) batch = addSlab();
+        if (!batch) return nullptr;
+        cache.head = batch;
+        cache.count = batch->count;
+        checkOut(batch->count);
+    }
+    Node* node = cache.head;
+    cache.head = node->next;
+    cache.count--;
+    cache.used.store(cache.used.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+#if LIGHTS_PLEASE_MEMORY_TRACKING
+    memory_tracker::recordAllocation(node, block_size_, tag_, where);
+#endif
+    return node;
+}
+
+void ConcurrentPoolAllocator::deallocate(void* node_data){
+    if (!node_data) return;
+    memory_tracker::recordFree(node_data);
+
+    Node* node = static_cast<Node*>(node_data);
+    const uint32_t slot = currentThreadSlot();
+    if (slot == THREAD_SLOT_OVERFLOW) {
+        node->next = nullptr;
+        node->count = 1;
+        pushBatch(node);
+        checked_out_.fetch_sub(1, std::memory_order_relaxed);
+        overflow_used_.fetch_sub(1, std::memory_order_relaxed);
+        return;
+    }
+
+    ThreadCache& cache = caches_[slot];
+    node->next = cache.head;
+    cache.head = node;
+    cache.count++;
+    cache.used.store(cache.used.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+
+    // keep one batch for the next allocations and hand a full one back
+    if (cache.count >= batch_size_ * 2) {
+        Node* batch = cache.head;
+        Node* last = batch;
+        for (size_t i = 1; i < batch_size_; ++i) last = last->next;
+        cache.head = last->next;
+        cache.count -= batch_size_;
+        last->next = nullptr;
+        batch->count = batch_size_;
+        pushBatch(batch);
+        checked_out_.fetch_sub(batch_size_, std::memory_order_relaxed);
+    }
+}
+
+void ConcurrentPoolAllocator::flushThreadCache(){
+    const uint32_t slot = currentThreadSlot();
+    if (slot == THREAD_SLOT_OVERFLOW) return;
+
+    ThreadCache& cache = caches_[slot];
+    if (!cache.head) return;
+    cache.head->count = cache.count;
+    pushBatch(cache.head);
+    checked_out_.fetch_sub(cache.count, std::memory_order_relaxed);
+    cache.head = nullptr;
+    cache.count = 0;
+}
+
+ConcurrentPoolAllocator::Stats ConcurrentPoolAllocator::getStats() const{
+    int64_t used = overflow_used_.load(std::memory_order_relaxed);
+    for (uint32_t slot = 0; slot < MAX_THREAD_SLOTS; ++slot) {
+        used += caches_[slot].used.load(std::memory_order_relaxed);
+    }
+
+    Stats stats;
+    stats.blockSize = block_size_;
+    stats.slabCount = slab_count_.load(std::memory_order_relaxed);
+    stats.totalBlocks = stats.slabCount * block_count_;
+    stats.usedBlocks = static_cast<size_t>(std::max<int64_t>(used, 0));
+    stats.peakUsedBlocks = peak_checked_out_.load(std::memory_order_relaxed);
+    return stats;
+}
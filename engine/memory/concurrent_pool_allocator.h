@@ -0,0 +1,86 @@
+#pragma once
+#include "../thread_slot.h"
+#include "memory_tracker.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*
+ * Thread-safe PoolAllocator variant for blocks allocated and freed from job
+ * workers. Each thread slot keeps a small private free list; it refills from
+ * and spills to a lock-free global list a whole batch at a time, so most
+ * calls touch no shared cache line. When the global list is empty another
+ * slab is carved up under a mutex; slabs are only released by the
+ * destructor, so blocks never move.
+ *
+ * A block may be freed on a different thread from the one that allocated
+ * it. Threads without a thread slot (see thread_slot.h) bypass the caches
+ * and go straight to the global list.
+ */
+class ConcurrentPoolAllocator {
+    struct Node {
+        Node* next;      // next block in the same batch
+        Node* nextBatch; // next batch on the global list, set on batch heads
+        size_t count;    // blocks in the batch, set on batch heads
+    };
+public:
+    struct Stats {
+        size_t blockSize = 0;
+        size_t slabCount = 0;
+        size_t totalBlocks = 0;    // blocks owned across all slabs
+        size_t usedBlocks = 0;     // currently handed out, exact once threads are idle
+        size_t peakUsedBlocks = 0; // high-water mark, counting blocks held in thread caches
+    };
+
+    // block_count blocks per slab, moved between a thread cache and the
+    // global list batch_size at a time
+    ConcurrentPoolAllocator(size_t block_size, size_t block_count, size_t batch_size = 32,
+                            MemoryTag tag = MemoryTag::Untagged);
+    ~ConcurrentPoolAllocator();
+    ConcurrentPoolAllocator(const ConcurrentPoolAllocator&) = delete;
+    ConcurrentPoolAllocator& operator=(const ConcurrentPoolAllocator&) = delete;
+
+    void* allocate(memory_tracker::Callsite where = memory_tracker::Callsite::current());
+    void deallocate(void* node_data);
+
+    // Returns the calling thread's cached blocks to the global list, e.g.
+    // before a worker exits
+    void flushThreadCache();
+
+    Stats getStats() const;
+private:
+    // cache line per slot so threads never share lines
+    struct alignas(64) ThreadCache {
+        Node* head = nullptr;
+        size_t count = 0;
+        std::atomic<int64_t> used{0}; // allocations minus frees; only the owning thread writes
+    };
+
+    Node* popBatch();
+    void pushBatch(Node* batch);
+    Node* addSlab();
+    void checkOut(size_t blocks);
+
+    size_t block_size_;
+    size_t block_count_;
+    size_t batch_size_;
+
+    // Treiber stack of batches; the head packs a pointer and an ABA tag
+    std::atomic<uint64_t> global_head_{0};
+    std::unique_ptr<ThreadCache[]> caches_;
+    std::atomic<int64_t> overflow_used_{0};
+
+    // blocks taken off the global list (in use or cached) and its maximum
+    std::atomic<size_t> checked_out_{0};
+    std::atomic<size_t> peak_checked_out_{0};
+
+    std::mutex slab_mutex_;
+    std::vector<std::byte*> slabs_;
+    std::atomic<size_t> slab_count_{0};
+#if LIGHTS_PLEASE_MEMORY_TRACKING
+    MemoryTag tag_;
+#endif
+};
@@ -0,0 +1,24 @@
+#include "frame_allocator.h"
+#include <algorithm>
+
+// Frame Allocator Implementation
+
+FrameAllocator::FrameAllocator(size_t frame_size, uint32_t frame_count, MemoryTag tag){
+    frames_.reserve(std::max<uint32_t>(frame_count, 1));
+    for (uint32_t i = 0; i < std::max<uint32_t>(frame_count, 1); ++i) {
+        frames_.emplace_back(frame_size, tag);
+    }
+}
+
+void FrameAllocator::beginFrame(uint32_t frame_index){
+    frame_index_ = frame_index % getFrameCount();
+    frames_[frame_index_].reset();
+}
+
+size_t FrameAllocator::getPeakUsed() const{
+    size_t peak = 0;
+    for (const LinearAllocator& frame : frames_) {
+        peak = std::max(peak, frame.getPeakUsed());
+    }
+    return peak;
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include "linear_allocator.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+ * One LinearAllocator per frame in flight, for data that lives for a single
+ * frame (drawable lists, upload staging). beginFrame(i) drops whatever frame
+ * i allocated frame_count frames ago, so memory the GPU may still read from
+ * an earlier frame is left alone. Call it once that frame's fence has been
+ * waited on.
+ */
+class FrameAllocator {
+public:
+    // frame_size bytes per frame; 2 for double, 3 for triple buffering
+    FrameAllocator(size_t frame_size, uint32_t frame_count = 2, MemoryTag tag = MemoryTag::Untagged);
+
+    // Makes frame_index % frame_count current and empties it
+    void beginFrame(uint32_t frame_index);
+
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        return current().allocate(size, alignment);
+    }
+    template <typename T>
+    T* allocateArray(size_t count) {
+        return current().template allocateArray<T>(count);
+    }
+
+    LinearAllocator& current() { return frames_[frame_index_]; }
+    uint32_t getFrameIndex() const { return frame_index_; }
+    uint32_t getFrameCount() const { return static_cast<uint32_t>(frames_.size()); }
+    // highest usage any single frame reached
+    size_t getPeakUsed() const;
+private:
+    std::vector<LinearAllocator> frames_;
+    uint32_t frame_index_ = 0;
+};
@@ -1,27 +1,72 @@
 #include "linear_allocator.h"
+#include <algorithm>
+#include <cassert>
 #include <cstddef>
+#include <cstdint>
 
 // Linear Allocator Implementation
 
-LinearAllocator::LinearAllocator(size_t size){
+LinearAllocator::LinearAllocator(size_t size, [[maybe_unused]] MemoryTag tag){
     size_ = size;
     offset_ = 0;
+    peak_ = 0;
+    // the block is reported as it is used, not up front
+    memory_tracker::UntrackedScope untracked;
     memory_ = new std::byte[size];
+#if LIGHTS_PLEASE_MEMORY_TRACKING
+    tag_ = tag;
+#endif
 }
 
 LinearAllocator::~LinearAllocator(){
+    reset();
+    memory_tracker::UntrackedScope untracked;
     delete[] memory_;
 }
 
-void* LinearAllocator::allocate(size_t size){
-    if (offset_ + size > size_) {
+LinearAllocator::LinearAllocator(LinearAllocator&& other) noexcept{
+    size_ = other.size_;
+    offset_ = other.offset_;
+    peak_ = other.peak_;
+    memory_ = other.memory_;
+#if LIGHTS_PLEASE_MEMORY_TRACKING
+    tag_ = other.tag_;
+#endif
+    other.size_ = 0;
+    other.offset_ = 0;
+    other.memory_ = nullptr;
+}
+
+void* LinearAllocator::allocate(size_t size, size_t alignment){
+    assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+    // align the address rather than the offset, so alignments above the
+    // block's own alignment work too
+    const uintptr_t base = reinterpret_cast<uintptr_t>(memory_);
+    const uintptr_t aligned = (base + offset_ + alignment - 1) & ~(uintptr_t(alignment) - 1);
+    const size_t start = aligned - base;
+    if (start > size_ || size > size_ - start) {
         return nullptr; // not enough memory
     }
-    void* ptr = memory_ + offset_;
-    offset_ += size;
-    return ptr;
+#if LIGHTS_PLEASE_MEMORY_TRACKING
+    memory_tracker::recordUsage(tag_, static_cast<ptrdiff_t>(start + size - offset_));
+#endif
+    offset_ = start + size;
+    peak_ = std::max(peak_, offset_);
+    return memory_ + start;
+}
+
+void LinearAllocator::freeToMarker(Marker marker){
+    assert(marker <= offset_); // markers must be released in reverse order
+#if LIGHTS_PLEASE_MEMORY_TRACKING
+    memory_tracker::recordUsage(tag_, -static_cast<ptrdiff_t>(offset_ - marker));
+#endif
+    offset_ = marker;
 }
 
 void LinearAllocator::reset(){
+#if LIGHTS_PLEASE_MEMORY_TRACKING
+    memory_tracker::recordUsage(tag_, -static_cast<ptrdiff_t>(offset_));
+#endif
     offset_ = 0;
 }
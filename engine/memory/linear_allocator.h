@@ -1,14 +1,74 @@
 #pragma once
+#include "memory_tracker.h"
 #include <cstddef>
+#include <memory>
+#include <type_traits>
 
+/*
+ * Bump allocator over one fixed block. Allocations are freed together, either
+ * all at once with reset() or back to a saved marker, so nested scopes can
+ * use it as a stack. Nothing is destroyed on the way out, which is why
+ * allocateArray only takes trivially destructible types.
+ */
 class LinearAllocator {
 public:
-    LinearAllocator(size_t size);
+    // Offset to roll back to; everything allocated after it is freed together
+    using Marker = size_t;
+
+    // Restores the allocator to where it was on construction
+    class ScopedFrame {
+    public:
+        explicit ScopedFrame(LinearAllocator& allocator)
+            : allocator_(allocator), marker_(allocator.getMarker()) {}
+        ~ScopedFrame() { allocator_.freeToMarker(marker_); }
+        ScopedFrame(const ScopedFrame&) = delete;
+        ScopedFrame& operator=(const ScopedFrame&) = delete;
+    private:
+        LinearAllocator& allocator_;
+        Marker marker_;
+    };
+
+    LinearAllocator(size_t size, MemoryTag tag = MemoryTag::Untagged);
     ~LinearAllocator();
-    void* allocate(size_t size);
+    LinearAllocator(LinearAllocator&& other) noexcept;
+    LinearAllocator(const LinearAllocator&) = delete;
+    LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+    // alignment must be a power of two; returns nullptr when out of space
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    // count default-initialised Ts, or nullptr when out of space
+    template <typename T>
+    T* allocateArray(size_t count) {
+        static_assert(std::is_trivially_destructible_v<T>, "linear allocations are never destroyed");
+        if (count > size_ / sizeof(T)) return nullptr;
+        void* memory = allocate(sizeof(T) * count, alignof(T));
+        if (!memory) return nullptr;
+        T* items = static_cast<T*>(memory);
+        std::uninitialized_default_construct_n(items, count);
+        return items;
+    }
+
+    Marker getMarker() const { return offset_; }
+    void freeToMarker(Marker marker);
     void reset();
+
+    // true for addresses inside this allocator's block
+    bool owns(const void* memory) const {
+        const std::byte* byte = static_cast<const std::byte*>(memory);
+        return byte >= memory_ && byte < memory_ + size_;
+    }
+
+    size_t getUsed() const { return offset_; }
+    size_t getCapacity() const { return size_; }
+    // high-water mark of getUsed() since construction
+    size_t getPeakUsed() const { return peak_; }
 private:
     size_t size_;
     size_t offset_;
+    size_t peak_;
     std::byte* memory_;
+#if LIGHTS_PLEASE_MEMORY_TRACKING
+    MemoryTag tag_;
+#endif
 };
@@ -0,0 +1,347 @@
+#include "memory_tracker.h"
+
+#if LIGHTS_PLEASE_MEMORY_TRACKING
+#include "../logger.h"
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+#if __has_include(<dlfcn.h>)
+#include <dlfcn.h>
+#define LIGHTS_PLEASE_HAS_DLADDR 1
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define CALLER_ADDRESS() _ReturnAddress()
+#else
+#define CALLER_ADDRESS() __builtin_return_address(0)
+#endif
+
+// Memory Tracker Implementation
+
+namespace {
+
+// Containers inside the tracker allocate with malloc so they never call
+// back into the replaced operator new
+template <typename T>
+struct MallocAllocator {
+    using value_type = T;
+    MallocAllocator() = default;
+    template <typename U>
+    MallocAllocator(const MallocAllocator<U>&) {}
+    T* allocate(size_t count) {
+        if (void* memory = std::malloc(count * sizeof(T))) return static_cast<T*>(memory);
+        throw std::bad_alloc();
+    }
+    void deallocate(T* memory, size_t) { std::free(memory); }
+    template <typename U>
+    bool operator==(const MallocAllocator<U>&) const { return true; }
+};
+
+struct Record {
+    size_t size = 0;
+    MemoryTag tag = MemoryTag::Untagged;
+    const char* file = nullptr;     // allocator callsite, null for global new
+    const char* function = nullptr;
+    uint32_t line = 0;
+    void* returnAddress = nullptr;  // global new caller
+    uint64_t sequence = 0;
+};
+
+struct Registry {
+    std::mutex mutex;
+    // keyed by address value; the memory itself is never read
+    std::unordered_map<uintptr_t, Record, std::hash<uintptr_t>, std::equal_to<uintptr_t>,
+                       MallocAllocator<std::pair<const uintptr_t, Record>>> live;
+    // records displaced by a new allocation at the same address, e.g. pool
+    // blocks never returned before their pool freed the slab
+    std::vector<Record, MallocAllocator<Record>> orphaned;
+    memory_tracker::TagStats tags[static_cast<size_t>(MemoryTag::Count)];
+    uint64_t sequence = 0;
+    uint64_t baseline = 0;
+};
+
+// Built on first use and never destroyed, so allocations made during
+// static initialisation and destruction are still recorded safely
+Registry& registry() {
+    alignas(Registry) static std::byte storage[sizeof(Registry)];
+    static Registry* instance = new (storage) Registry();
+    return *instance;
+}
+
+// constant-initialised so reading them never runs TLS constructors
+thread_local MemoryTag currentTag = MemoryTag::Untagged;
+thread_local bool untracked = false;
+
+memory_tracker::TagStats& tagStats(Registry& state, MemoryTag tag) {
+    return state.tags[static_cast<size_t>(tag)];
+}
+
+void addLive(memory_tracker::TagStats& stats, size_t bytes) {
+    stats.liveBytes += bytes;
+    stats.peakBytes = std::max(stats.peakBytes, stats.liveBytes);
+}
+
+void insert(uintptr_t address, Record record) {
+    Registry& state = registry();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    record.sequence = ++state.sequence;
+    memory_tracker::TagStats& stats = tagStats(state, record.tag);
+    addLive(stats, record.size);
+    stats.liveAllocations++;
+    stats.totalAllocations++;
+    auto [it, inserted] = state.live.try_emplace(address, record);
+    if (!inserted) {
+        state.orphaned.push_back(it->second);
+        it->second = record;
+    }
+}
+
+void* allocateRaw(size_t size, size_t alignment) {
+    if (alignment <= alignof(std::max_align_t)) return std::malloc(size);
+#if defined(_MSC_VER)
+    return _aligned_malloc(size, alignment);
+#else
+    return std::aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+#endif
+}
+
+void* trackedNew(size_t size, size_t alignment, void* returnAddress) {
+    if (size == 0) size = 1;
+    void* const memory = allocateRaw(size, alignment);
+    if (!memory) return nullptr;
+    if (!untracked) {
+        untracked = true; // nothing below may record itself
+        Record record;
+        record.size = size;
+        record.tag = currentTag;
+        record.returnAddress = returnAddress;
+        insert(reinterpret_cast<uintptr_t>(memory), record);
+        untracked = false;
+    }
+    return memory;
+}
+
+void trackedDelete(void* memory, size_t alignment) {
+    if (!memory) return;
+    if (!untracked) {
+        untracked = true;
+        memory_tracker::recordFree(memory);
+        untracked = false;
+    }
+#if defined(_MSC_VER)
+    if (alignment > alignof(std::max_align_t)) {
+        _aligned_free(memory);
+        return;
+    }
+#else
+    (void)alignment;
+#endif
+    std::free(memory);
+}
+
+void* throwingNew(size_t size, size_t alignment, void* returnAddress) {
+    void* memory = trackedNew(size, alignment, returnAddress);
+    if (!memory) throw std::bad_alloc();
+    return memory;
+}
+
+void logRecord(const Record& record) {
+    if (record.file) {
+        logger::log(LogLevel::Warning, "MEMORY", "  {} bytes [{}] at {}:{} ({})", record.size,
+                    memory_tracker::tagName(record.tag), record.file, record.line, record.function);
+        return;
+    }
+#if defined(LIGHTS_PLEASE_HAS_DLADDR)
+    Dl_info info{};
+    if (dladdr(record.returnAddress, &info) && info.dli_fname) {
+        const uintptr_t address = reinterpret_cast<uintptr_t>(record.returnAddress);
+        if (info.dli_sname) {
+            logger::log(LogLevel::Warning, "MEMORY", "  {} bytes [{}] from {}+{:#x} ({})", record.size,
+                        memory_tracker::tagName(record.tag), info.dli_sname,
+                        address - reinterpret_cast<uintptr_t>(info.dli_saddr), info.dli_fname);
+        } else {
+            // no exported symbol; the module offset is what addr2line takes
+            logger::log(LogLevel::Warning, "MEMORY", "  {} bytes [{}] from {}+{:#x}", record.size,
+                        memory_tracker::tagName(record.tag), info.dli_fname,
+                        address - reinterpret_cast<uintptr_t>(info.dli_fbase));
+        }
+        return;
+    }
+#endif
+    logger::log(LogLevel::Warning, "MEMORY", "  {} bytes [{}] from {}", record.size,
+                memory_tracker::tagName(record.tag), record.returnAddress);
+}
+
+} // namespace
+
+namespace memory_tracker {
+
+void recordAllocation(const void* memory, size_t size, MemoryTag tag, const Callsite& where) {
+    if (!memory) return;
+    const bool previous = untracked;
+    untracked = true;
+    Record record;
+    record.size = size;
+    record.tag = tag;
+    record.file = where.file_name();
+    record.function = where.function_name();
+    record.line = where.line();
+    insert(reinterpret_cast<uintptr_t>(memory), record);
+    untracked = previous;
+}
+
+void recordFree(const void* memory) {
+    if (!memory) return;
+    Registry& state = registry();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    auto it = state.live.find(reinterpret_cast<uintptr_t>(memory));
+    if (it == state.live.end()) return; // made while untracked
+    TagStats& stats = tagStats(state, it->second.tag);
+    stats.liveBytes -= it->second.size;
+    stats.liveAllocations--;
+    state.live.erase(it);
+}
+
+void recordUsage(MemoryTag tag, ptrdiff_t bytes) {
+    if (bytes == 0) return;
+    Registry& state = registry();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    TagStats& stats = tagStats(state, tag);
+    if (bytes > 0) {
+        addLive(stats, static_cast<size_t>(bytes));
+    } else {
+        stats.liveBytes -= std::min(stats.liveBytes, static_cast<size_t>(-bytes));
+    }
+}
+
+TagStats getStats(MemoryTag tag) {
+    Registry& state = registry();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return tagStats(state, tag);
+}
+
+void markBaseline() {
+    Registry& state = registry();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.baseline = state.sequence;
+}
+
+size_t reportLeaks() {
+    // copy out under the lock, log without it; logging may allocate
+    UntrackedScope untrackedHere;
+    std::vector<Record, MallocAllocator<Record>> leaks;
+    TagStats tags[static_cast<size_t>(MemoryTag::Count)];
+    {
+        Registry& state = registry();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        for (const auto& [address, record] : state.live) {
+            if (record.sequence > state.baseline) leaks.push_back(record);
+        }
+        for (const Record& record : state.orphaned) {
+            if (record.sequence > state.baseline) leaks.push_back(record);
+        }
+        std::copy(std::begin(state.tags), std::end(state.tags), std::begin(tags));
+    }
+    std::sort(leaks.begin(), leaks.end(),
+              [](const Record& a, const Record& b) { return a.sequence < b.sequence; });
+
+    for (size_t i = 0; i < static_cast<size_t>(MemoryTag::Count); ++i) {
+        logger::log(LogLevel::Info, "MEMORY", "{}: {} bytes live in {} allocations, peak {} bytes, {} total",
+                    tagName(static_cast<MemoryTag>(i)), tags[i].liveBytes, tags[i].liveAllocations,
+                    tags[i].peakBytes, tags[i].totalAllocations);
+    }
+    if (leaks.empty()) {
+        logger::log(LogLevel::Info, "MEMORY", "No leaks");
+        return 0;
+    }
+
+    size_t leakedBytes = 0;
+    for (const Record& record : leaks) leakedBytes += record.size;
+    logger::log(LogLevel::Warning, "MEMORY", "{} allocations ({} bytes) still live, oldest first:", leaks.size(),
+                leakedBytes);
+    constexpr size_t MAX_LISTED = 64;
+    for (size_t i = 0; i < std::min(leaks.size(), MAX_LISTED); ++i) logRecord(leaks[i]);
+    if (leaks.size() > MAX_LISTED) {
+        logger::log(LogLevel::Warning, "MEMORY", "  ... and {} more", leaks.size() - MAX_LISTED);
+    }
+    return leaks.size();
+}
+
+TagScope::TagScope(MemoryTag tag) : previous(currentTag) {
+    currentTag = tag;
+}
+
+TagScope::~TagScope() {
+    currentTag = previous;
+}
+
+UntrackedScope::UntrackedScope() : previous(untracked) {
+    untracked = true;
+}
+
+UntrackedScope::~UntrackedScope() {
+    untracked = previous;
+}
+
+} // namespace memory_tracker
+
+// Replaceable global allocation functions, all routed through the registry
+
+void* operator new(size_t size) {
+    return throwingNew(size, alignof(std::max_align_t), CALLER_ADDRESS());
+}
+void* operator new[](size_t size) {
+    return throwingNew(size, alignof(std::max_align_t), CALLER_ADDRESS());
+}
+void* operator new(size_t size, std::align_val_t alignment) {
+    return throwingNew(size, static_cast<size_t>(alignment), CALLER_ADDRESS());
+}
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return throwingNew(size, static_cast<size_t>(alignment), CALLER_ADDRESS());
+}
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return trackedNew(size, alignof(std::max_align_t), CALLER_ADDRESS());
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return trackedNew(size, alignof(std::max_align_t), CALLER_ADDRESS());
+}
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return trackedNew(size, static_cast<size_t>(alignment), CALLER_ADDRESS());
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return trackedNew(size, static_cast<size_t>(alignment), CALLER_ADDRESS());
+}
+
+void operator delete(void* memory) noexcept { trackedDelete(memory, alignof(std::max_align_t)); }
+void operator delete[](void* memory) noexcept { trackedDelete(memory, alignof(std::max_align_t)); }
+void operator delete(void* memory, size_t) noexcept { trackedDelete(memory, alignof(std::max_align_t)); }
+void operator delete[](void* memory, size_t) noexcept { trackedDelete(memory, alignof(std::max_align_t)); }
+void operator delete(void* memory, std::align_val_t alignment) noexcept {
+    trackedDelete(memory, static_cast<size_t>(alignment));
+}
+void operator delete[](void* memory, std::align_val_t alignment) noexcept {
+    trackedDelete(memory, static_cast<size_t>(alignment));
+}
+void operator delete(void* memory, size_t, std::align_val_t alignment) noexcept {
+    trackedDelete(memory, static_cast<size_t>(alignment));
+}
+void operator delete[](void* memory, size_t, std::align_val_t alignment) noexcept {
+    trackedDelete(memory, static_cast<size_t>(alignment));
+}
+void operator delete(void* memory, const std::nothrow_t&) noexcept {
+    trackedDelete(memory, alignof(std::max_align_t));
+}
+void operator delete[](void* memory, const std::nothrow_t&) noexcept {
+    trackedDelete(memory, alignof(std::max_align_t));
+}
+void operator delete(void* memory, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    trackedDelete(memory, static_cast<size_t>(alignment));
+}
+void operator delete[](void* memory, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    trackedDelete(memory, static_cast<size_t>(alignment));
+}
+
+#endif
@@ -0,0 +1,109 @@
+#pragma once
+#include "../config.h"
+#include <cstddef>
+#include <cstdint>
+#if LIGHTS_PLEASE_MEMORY_TRACKING
+#include <source_location>
+#endif
+
+/*
+ * Engine-wide allocation tracking, built with LIGHTSPLEASE_MEMORY_TRACKING
+ * (LIGHTS_PLEASE_MEMORY_TRACKING=1). When on, global new/delete and the
+ * engine allocators (PoolAllocator, ConcurrentPoolAllocator,
+ * LinearAllocator) report to one registry that keeps live and peak bytes
+ * per tag and every live allocation with its callsite, so the leaks left at
+ * shutdown can be listed.
+ *
+ * When off, everything below is an empty inline function or an empty type
+ * and compiles to nothing.
+ */
+
+enum class MemoryTag : uint8_t { Untagged, ECS, Assets, Renderer, Jobs, Count };
+
+namespace memory_tracker {
+
+struct TagStats {
+    size_t liveBytes = 0;
+    size_t peakBytes = 0;
+    size_t liveAllocations = 0;
+    size_t totalAllocations = 0;
+};
+
+constexpr const char* tagName(MemoryTag tag) {
+    switch (tag) {
+    case MemoryTag::ECS: return "ECS";
+    case MemoryTag::Assets: return "Assets";
+    case MemoryTag::Renderer: return "Renderer";
+    case MemoryTag::Jobs: return "Jobs";
+    default: return "Untagged";
+    }
+}
+
+#if LIGHTS_PLEASE_MEMORY_TRACKING
+
+// Where an allocator was called from; defaulted on the allocate() calls
+using Callsite = std::source_location;
+
+void recordAllocation(const void* memory, size_t size, MemoryTag tag, const Callsite& where);
+void recordFree(const void* memory);
+// Bulk usage change for allocators that free wholesale (LinearAllocator)
+void recordUsage(MemoryTag tag, ptrdiff_t bytes);
+
+TagStats getStats(MemoryTag tag);
+// Allocations made before this (static initialisation, say) are left out
+// of the leak report
+void markBaseline();
+// Logs per-tag totals and every allocation still live since the baseline;
+// returns how many there were
+size_t reportLeaks();
+
+// Tags global new on this thread until destroyed
+class TagScope {
+public:
+    explicit TagScope(MemoryTag tag);
+    ~TagScope();
+    TagScope(const TagScope&) = delete;
+    TagScope& operator=(const TagScope&) = delete;
+private:
+    MemoryTag previous;
+};
+
+// Hides global new/delete on this thread from the registry, for allocator
+// backing memory that the allocator reports itself
+class UntrackedScope {
+public:
+    UntrackedScope();
+    ~UntrackedScope();
+    UntrackedScope(const UntrackedScope&) = delete;
+    UntrackedScope& operator=(const UntrackedScope&) = delete;
+private:
+    bool previous;
+};
+
+#else
+
+struct Callsite {
+    static constexpr Callsite current() noexcept { return {}; }
+};
+
+inline void recordAllocation(const void*, size_t, MemoryTag, const Callsite&) {}
+inline void recordFree(const void*) {}
+inline void recordUsage(MemoryTag, ptrdiff_t) {}
+
+inline TagStats getStats(MemoryTag) { return {}; }
+inline void markBaseline() {}
+inline size_t reportLeaks() { return 0; }
+
+class TagScope {
+public:
+    explicit TagScope(MemoryTag) {}
+};
+
+class UntrackedScope {
+public:
+    UntrackedScope() {}
+};
+
+#endif
+
+} // namespace memory_tracker
@@ -1,41 +1,82 @@
 #include "pool_allocator.h"
+#include <algorithm>
 #include <cstddef>
+#include <new>
 
 // Pool Allocator Implementation
 
-PoolAllocator::PoolAllocator(size_t block_size, size_t block_count){
-    block_size_ = block_size;
+// Slabs are cache line aligned so block contents (ECS chunks) start aligned.
+static constexpr std::align_val_t SLAB_ALIGNMENT{64};
+
+PoolAllocator::PoolAllocator(size_t block_size, size_t block_count, Growth growth, [[maybe_unused]] MemoryTag tag){
+    block_size_ = std::max(block_size, sizeof(Node));
     block_count_ = block_count;
-    memory_ = new std::byte[block_size * block_count]; // allocate the big memory chunk
+    growth_ = growth;
     head = nullptr;
+    stats_.blockSize = block_size_;
+#if LIGHTS_PLEASE_MEMORY_TRACKING
+    tag_ = tag;
+#endif
+    addSlab();
+}
+
+PoolAllocator::~PoolAllocator(){
+    memory_tracker::UntrackedScope untracked; // slabs are reported block by block
+    for (std::byte* slab : slabs_) {
+        ::operator delete(slab, SLAB_ALIGNMENT);
+    }
+}
+
+/*
+ * Allocates one more big memory chunk and threads its blocks onto the free
+ * list. Earlier slabs are never moved, so handed out blocks stay valid.
+ */
+void PoolAllocator::addSlab(){
+    if (block_count_ == 0) return;
+    memory_tracker::UntrackedScope untracked;
+    std::byte* memory = static_cast<std::byte*>(::operator new(block_size_ * block_count_, SLAB_ALIGNMENT));
+    slabs_.push_back(memory);
 
-    // each node needs to point to the next free block
-    for (size_t i = 0; i < block_count; ++i) {
-        Node* node = reinterpret_cast<Node*>(memory_ + i * block_size);
+    // each node needs to point to the next free block; walk backwards so the
+    // slab is handed out in address order
+    for (size_t i = block_count_; i-- > 0;) {
+        Node* node = reinterpret_cast<Node*>(memory + i * block_size_);
         node->data = node; // point data to itself
         node->next = head; // link to previous head
         head = node;       // update head to new node
     }
-}
 
-PoolAllocator::~PoolAllocator(){
-    delete[] memory_;
+    stats_.slabCount++;
+    stats_.totalBlocks += block_count_;
 }
 
-void* PoolAllocator::allocate(){
+void* PoolAllocator::allocate([[maybe_unused]] memory_tracker::Callsite where){
     if (!head) {
-        return nullptr; // no more blocks available
+        if (growth_ == Fixed) {
+            return nullptr; // no more blocks available
+        }
+        addSlab();
+        if (!head) return nullptr;
     }
     Node* free_node = head;
     head = head->next; // move head to next free block
     free_node->next = nullptr; // detach the allocated block from the free list
+
+    stats_.usedBlocks++;
+    stats_.peakUsedBlocks = std::max(stats_.peakUsedBlocks, stats_.usedBlocks);
+#if LIGHTS_PLEASE_MEMORY_TRACKING
+    memory_tracker::recordAllocation(free_node->data, block_size_, tag_, where);
+#endif
     return free_node->data;
 }
 
 void PoolAllocator::deallocate(void* node_data){
     if (!node_data) return;
+    memory_tracker::recordFree(node_data);
 
     Node* node = reinterpret_cast<Node*>(node_data);
+    node->data = node; // user data overwrote the self pointer while allocated
     node->next = head; // link the freed block to the front of the free list
     head = node;       // update head to the freed block
+    stats_.usedBlocks--;
 }
@@ -1,5 +1,7 @@
 #pragma once
+#include "memory_tracker.h"
 #include <cstddef>
+#include <vector>
 
 class PoolAllocator {
     struct Node {
@@ -7,13 +9,37 @@ class PoolAllocator {
         void* data;
     };
 public:
-    PoolAllocator(size_t block_size, size_t block_count);
+    // Fixed pools hand out block_count blocks and then return nullptr;
+    // growable pools add another slab of block_count blocks instead.
+    enum Growth { Fixed, Growable };
+
+    struct Stats {
+        size_t blockSize = 0;
+        size_t slabCount = 0;
+        size_t totalBlocks = 0;   // blocks owned across all slabs
+        size_t usedBlocks = 0;    // currently handed out
+        size_t peakUsedBlocks = 0;
+    };
+
+    PoolAllocator(size_t block_size, size_t block_count, Growth growth = Fixed,
+                  MemoryTag tag = MemoryTag::Untagged);
     ~PoolAllocator();
-    void* allocate();
+    PoolAllocator(const PoolAllocator&) = delete;
+    PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+    void* allocate(memory_tracker::Callsite where = memory_tracker::Callsite::current());
     void deallocate(void* node_data);
+    const Stats& getStats() const { return stats_; }
 private:
+    void addSlab();
+
     size_t block_size_;
     size_t block_count_;
-    std::byte* memory_;
+    Growth growth_;
+    std::vector<std::byte*> slabs_;
     Node* head;
+    Stats stats_;
+#if LIGHTS_PLEASE_MEMORY_TRACKING
+    MemoryTag tag_;
+#endif
 };
@@ -1,6 +1,7 @@
 #include "../external/vk_mem_alloc.h"
 
 #include "mesh.h"
+#include "primitive_data.h"
 #include "../logger.h"
 #include <vulkan/vulkan.h>
 #include <vulkan/vulkan_core.h>
@@ -348,64 +349,25 @@ void Mesh::updateIndices(const std::vector<uint32_t>& newIndices) {
 // Static factory methods
 Mesh Mesh::createQuad(VkDevice device, VmaAllocator allocator, VkCommandPool commandPool, VkQueue graphicsQueue) {
     MeshData data;
-    data.vertices = {
-        {{ -0.5f, 0.5f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.5f, 0.0f}}, // top-left
-        {{ 0.5f,  0.5f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {1.0f, 0.0f}}, // top-right
-        {{ 0.5f, -0.5f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {1.0f, 1.0f}}, // bottom-right
-        {{-0.5f,  -0.5f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 1.0f}}  // bottom-left
+    data.vertices.assign(primitives::QUAD_VERTICES.begin(), primitives::QUAD_VERTICES.end());
+    data.indices.assign(primitives::QUAD_INDICES.begin(), primitives::QUAD_INDICES.end());
 
-    };
-    
-    data.indices = { 0, 1, 2, 
-        2, 3, 0 };
-    
     return Mesh(device, allocator, commandPool, graphicsQueue, data);
 }
 
 Mesh Mesh::createTriangle(VkDevice device, VmaAllocator allocator, VkCommandPool commandPool, VkQueue graphicsQueue) {
     MeshData data;
-    data.vertices = {
-        {{ 0.0f, 0.5f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.5f, 0.0f}}, // top
-        {{ 0.5f, -0.5f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {1.0f, 1.0f}}, // bottom-right
-        {{-0.5f,  -0.5f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 1.0f}}  // bottom-left
-    };
-    
-    data.indices = { 0, 1, 2 };
-    
+    data.vertices.assign(primitives::TRIANGLE_VERTICES.begin(), primitives::TRIANGLE_VERTICES.end());
+    data.indices.assign(primitives::TRIANGLE_INDICES.begin(), primitives::TRIANGLE_INDICES.end());
+
     return Mesh(device, allocator, commandPool, graphicsQueue, data);
 }
 
 Mesh Mesh::createCube(VkDevice device, VmaAllocator allocator, VkCommandPool commandPool, VkQueue graphicsQueue) {
     MeshData data;
-    data.vertices = {
-        // Front face
-        {{-0.5f, -0.5f,  0.5f}, {1.0f, 0.0f, 0.0f}, { 0.0f,  0.0f,  1.0f}, {0.0f, 0.0f}},
-        {{ 0.5f, -0.5f,  0.5f}, {0.0f, 1.0f, 0.0f}, { 0.0f,  0.0f,  1.0f}, {1.0f, 0.0f}},
-        {{ 0.5f,  0.5f,  0.5f}, {0.0f, 0.0f, 1.0f}, { 0.0f,  0.0f,  1.0f}, {1.0f, 1.0f}},
-        {{-0.5f,  0.5f,  0.5f}, {1.0f, 1.0f, 0.0f}, { 0.0f,  0.0f,  1.0f}, {0.0f, 1.0f}},
-        
-        // Back face
-        {{-0.5f, -0.5f, -0.5f}, {1.0f, 0.0f, 1.0f}, { 0.0f,  0.0f, -1.0f}, {1.0f, 0.0f}},
-        {{ 0.5f, -0.5f, -0.5f}, {1.0f, 1.0f, 1.0f}, { 0.0f,  0.0f, -1.0f}, {0.0f, 0.0f}},
-        {{ 0.5f,  0.5f, -0.5f}, {0.0f, 1.0f, 1.0f}, { 0.0f,  0.0f, -1.0f}, {0.0f, 1.0f}},
-        {{-0.5f,  0.5f, -0.5f}, {0.5f, 0.5f, 0.5f}, { 0.0f,  0.0f, -1.0f}, {1.0f, 1.0f}}
-    };
-    
-    data.indices = {
-        // Front face
-        0, 1, 2, 2, 3, 0,
-        // Back face
-        4, 5, 6, 6, 7, 4,
-        // Left face
-        7, 3, 0, 0, 4, 7,
-        // Right face
-        1, 5, 6, 6, 2, 1,
-        // Top face
-        3, 2, 6, 6, 7, 3,
-        // Bottom face
-        0, 1, 5, 5, 4, 0
-    };
-    
+    data.vertices.assign(primitives::CUBE_VERTICES.begin(), primitives::CUBE_VERTICES.end());
+    data.indices.assign(primitives::CUBE_INDICES.begin(), primitives::CUBE_INDICES.end());
+
     return Mesh(device, allocator, commandPool, graphicsQueue, data);
 }
 
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "../geometry.h"
+#include <array>
+#include <cstdint>
+
+/*
+ * Vertex and index tables for the fixed built-in primitives, evaluated at
+ * compile time so Mesh::createQuad/createTriangle/createCube only copy them
+ * into the upload. The sphere depends on its subdivision count and is still
+ * generated at runtime.
+ */
+namespace primitives {
+
+inline constexpr std::array<Vertex, 4> QUAD_VERTICES = {{
+    {{-0.5f,  0.5f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.5f, 0.0f}}, // top-left
+    {{ 0.5f,  0.5f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {1.0f, 0.0f}}, // top-right
+    {{ 0.5f, -0.5f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {1.0f, 1.0f}}, // bottom-right
+    {{-0.5f, -0.5f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 1.0f}}  // bottom-left
+}};
+inline constexpr std::array<uint32_t, 6> QUAD_INDICES = {
+    0, 1, 2,
+    2, 3, 0
+};
+
+inline constexpr std::array<Vertex, 3> TRIANGLE_VERTICES = {{
+    {{ 0.0f,  0.5f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.5f, 0.0f}}, // top
+    {{ 0.5f, -0.5f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {1.0f, 1.0f}}, // bottom-right
+    {{-0.5f, -0.5f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 1.0f}}  // bottom-left
+}};
+inline constexpr std::array<uint32_t, 3> TRIANGLE_INDICES = {0, 1, 2};
+
+// Unit cube centred on the origin, corners shared between faces
+inline constexpr std::array<Vertex, 8> CUBE_VERTICES = {{
+    // Front face
+    {{-0.5f, -0.5f,  0.5f}, {1.0f, 0.0f, 0.0f}, { 0.0f,  0.0f,  1.0f}, {0.0f, 0.0f}},
+    {{ 0.5f, -0.5f,  0.5f}, {0.0f, 1.0f, 0.0f}, { 0.0f,  0.0f,  1.0f}, {1.0f, 0.0f}},
+    {{ 0.5f,  0.5f,  0.5f}, {0.0f, 0.0f, 1.0f}, { 0.0f,  0.0f,  1.0f}, {1.0f, 1.0f}},
+    {{-0.5f,  0.5f,  0.5f}, {1.0f, 1.0f, 0.0f}, { 0.0f,  0.0f,  1.0f}, {0.0f, 1.0f}},
+
+    // Back face
+    {{-0.5f, -0.5f, -0.5f}, {1.0f, 0.0f, 1.0f}, { 0.0f,  0.0f, -1.0f}, {1.0f, 0.0f}},
+    {{ 0.5f, -0.5f, -0.5f}, {1.0f, 1.0f, 1.0f}, { 0.0f,  0.0f, -1.0f}, {0.0f, 0.0f}},
+    {{ 0.5f,  0.5f, -0.5f}, {0.0f, 1.0f, 1.0f}, { 0.0f,  0.0f, -1.0f}, {0.0f, 1.0f}},
+    {{-0.5f,  0.5f, -0.5f}, {0.5f, 0.5f, 0.5f}, { 0.0f,  0.0f, -1.0f}, {1.0f, 1.0f}}
+}};
+inline constexpr std::array<uint32_t, 36> CUBE_INDICES = {
+    // Front face
+    0, 1, 2, 2, 3, 0,
+    // Back face
+    4, 5, 6, 6, 7, 4,
+    // Left face
+    7, 3, 0, 0, 4, 7,
+    // Right face
+    1, 5, 6, 6, 2, 1,
+    // Top face
+    3, 2, 6, 6, 7, 3,
+    // Bottom face
+    0, 1, 5, 5, 4, 0
+};
+
+template <size_t VertexCount, size_t IndexCount>
+constexpr bool indicesInRange(const std::array<uint32_t, IndexCount>& indices) {
+    for (uint32_t index : indices) {
+        if (index >= VertexCount) return false;
+    }
+    return IndexCount % 3 == 0;
+}
+
+static_assert(indicesInRange<QUAD_VERTICES.size()>(QUAD_INDICES));
+static_assert(indicesInRange<TRIANGLE_VERTICES.size()>(TRIANGLE_INDICES));
+static_assert(indicesInRange<CUBE_VERTICES.size()>(CUBE_INDICES));
+
+} // namespace primitives
@@ -772,6 +772,13 @@ VkPipelineLayout Renderer::createPipelineLayout() {
 
 
 
+void Renderer::beginFrame() {
+	// drawFrame waits for the queue to go idle, so the frame being reused
+	// has no GPU work left reading its scratch memory
+	currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+	frameAllocator.beginFrame(currentFrame);
+}
+
 void Renderer::drawFrame() {
 	
 	// wait for previous frame
@@ -17,6 +17,7 @@
 #include "descriptor_layout.h"
 #include "ubo.h"
 #include "texture.h"
+#include "../memory/frame_allocator.h"
 
 #define MAX_FRAMES_IN_FLIGHT 3 // max is 3 because min is set to 2 and max is min+1 or less
 
@@ -47,6 +48,8 @@ public:
     bool initialize(SDL_Window* window);
     
     // Public rendering methods
+    // Advances currentFrame and empties its frameAllocator; call before
+    // anything allocates frame data for the frame about to be drawn
     void beginFrame();
     void endFrame();
 
@@ -54,6 +57,8 @@ public:
         drawables.push_back(drawable);
     }
     void clearDrawables() { drawables.clear(); }
+    // This frame's scratch memory, emptied by the next beginFrame() for it
+    LinearAllocator& frameScratch() { return frameAllocator.current(); }
 
     Drawable& getDrawable(size_t index) {
         return drawables[index];
@@ -143,6 +148,11 @@ private:
     VkFence inFlightFence{VK_NULL_HANDLE};
     uint32_t currentFrame = 0;
 
+    // Scratch memory for data that lives one frame (drawable lists, upload
+    // staging), one buffer per frame in flight
+    static constexpr size_t FRAME_SCRATCH_SIZE = 8 * 1024 * 1024;
+    FrameAllocator frameAllocator{FRAME_SCRATCH_SIZE, MAX_FRAMES_IN_FLIGHT, MemoryTag::Renderer};
+
 
     VkRenderingAttachmentInfo colorAttachmentInfo{};
     
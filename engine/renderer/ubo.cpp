@@ -35,7 +35,7 @@ void UBO::update(mathplease::Matrix4 model, mathplease::Matrix4 view, mathplease
 // Overloaded update function for view and proj only
 void UBO::update(mathplease::Matrix4 view, mathplease::Matrix4 proj) {
     // proj(1, 1) *= -1;
-    mathplease::Matrix4 identity = mathplease::Matrix4::identity();
+    constexpr mathplease::Matrix4 identity = mathplease::Matrix4::identity();
     data.model = identity;
     data.view = view;
     data.proj = proj;
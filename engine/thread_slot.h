@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+
+/*
+ * Small dense per-thread index for per-thread buffers (one slot per live
+ * thread, recycled when the thread exits). Threads beyond MAX_THREAD_SLOTS
+ * get THREAD_SLOT_OVERFLOW and must fall back to a shared, locked path.
+ */
+constexpr uint32_t MAX_THREAD_SLOTS = 64;
+constexpr uint32_t THREAD_SLOT_OVERFLOW = MAX_THREAD_SLOTS;
+
+namespace thread_slot_detail {
+inline std::atomic<uint64_t>& usedSlots() {
+    static std::atomic<uint64_t> used{0};
+    return used;
+}
+
+struct SlotHolder {
+    uint32_t slot = THREAD_SLOT_OVERFLOW;
+
+    SlotHolder() {
+        uint64_t used = usedSlots().load(std::memory_order_relaxed);
+        while (~used != 0) {
+            const uint32_t free = static_cast<uint32_t>(std::countr_zero(~used));
+            if (usedSlots().compare_exchange_weak(used, used | (uint64_t(1) << free),
+                                                  std::memory_order_acquire)) {
+                slot = free;
+                return;
+            }
+        }
+    }
+    ~SlotHolder() {
+        if (slot != THREAD_SLOT_OVERFLOW) {
+            usedSlots().fetch_and(~(uint64_t(1) << slot), std::memory_order_release);
+        }
+    }
+};
+} // namespace thread_slot_detail
+
+inline uint32_t currentThreadSlot() {
+    thread_local thread_slot_detail::SlotHolder holder;
+    return holder.slot;
+}
@@ -1,13 +1,19 @@
 #include "engine/demo_scene.h"
 #include "engine/engine.h"
+#include "engine/memory/memory_tracker.h"
 
 int main() {
-  Engine engine;
-  engine.initialize();
+  // static initialisation is not the engine's to free
+  memory_tracker::markBaseline();
+  {
+    Engine engine;
+    engine.initialize();
 
-  DemoScene scene;
-  scene.load(engine);
+    DemoScene scene;
+    scene.load(engine);
 
-  engine.run();
+    engine.run();
+  }
+  memory_tracker::reportLeaks();
   return 0;
 }
@@ -1,6 +1,13 @@
+#include "../engine/memory/concurrent_pool_allocator.h"
+#include "../engine/memory/frame_allocator.h"
 #include "../engine/memory/linear_allocator.h"
 #include "../engine/memory/pool_allocator.h"
 #include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <vector>
 
 int main() {
   LinearAllocator linear(32);
@@ -14,6 +21,61 @@ int main() {
   void *d = linear.allocate(16);
   assert(d != nullptr);
 
+  // aligned allocations, including alignments above the block's own
+  LinearAllocator aligned(1024);
+  void *byte = aligned.allocate(1, 1);
+  assert(byte != nullptr);
+  void *wide = aligned.allocate(32, 256);
+  assert(wide != nullptr && reinterpret_cast<uintptr_t>(wide) % 256 == 0);
+  double *values = aligned.allocateArray<double>(4);
+  assert(values != nullptr && reinterpret_cast<uintptr_t>(values) % alignof(double) == 0);
+  double *tooMany = aligned.allocateArray<double>(1000);
+  void *tooBig = aligned.allocate(4096);
+  assert(tooMany == nullptr && tooBig == nullptr);
+
+  // markers roll back everything allocated after them
+  const LinearAllocator::Marker marker = aligned.getMarker();
+  void *scratch = aligned.allocate(64);
+  aligned.freeToMarker(marker);
+  void *rewound = aligned.allocate(64);
+  assert(rewound == scratch);
+  aligned.freeToMarker(marker);
+  {
+    LinearAllocator::ScopedFrame frame(aligned);
+    void *framed = aligned.allocate(128);
+    assert(framed == scratch);
+    {
+      LinearAllocator::ScopedFrame inner(aligned);
+      aligned.allocate(256);
+    }
+    assert(aligned.getUsed() == marker + 128);
+  }
+  assert(aligned.getUsed() == marker);
+  assert(aligned.getPeakUsed() >= marker + 384);
+  aligned.reset();
+  assert(aligned.getUsed() == 0 && aligned.getCapacity() == 1024);
+
+  // frame allocators keep a frame's data until that frame index comes round
+  FrameAllocator frames(256, 3);
+  assert(frames.getFrameCount() == 3);
+  int *frameData[3];
+  for (uint32_t frame = 0; frame < 3; ++frame) {
+    frames.beginFrame(frame);
+    frameData[frame] = frames.allocateArray<int>(8);
+    assert(frameData[frame] != nullptr);
+    frameData[frame][0] = static_cast<int>(frame);
+  }
+  assert(frameData[0] != frameData[1] && frameData[1] != frameData[2]);
+  assert(frameData[0][0] == 0 && frameData[1][0] == 1);
+  frames.beginFrame(3); // reuses frame 0's memory only
+  assert(frames.getFrameIndex() == 0 && frames.current().getUsed() == 0);
+  int *reused = frames.allocateArray<int>(8);
+  assert(reused == frameData[0]);
+  assert(frameData[1][0] == 1 && frameData[2][0] == 2);
+  void *overflow = frames.allocate(512);
+  assert(overflow == nullptr);
+  assert(frames.getPeakUsed() == 8 * sizeof(int));
+
   PoolAllocator pool(32, 2);
   void *p1 = pool.allocate();
   void *p2 = pool.allocate();
@@ -21,9 +83,87 @@ int main() {
   assert(p1 != nullptr);
   assert(p2 != nullptr);
   assert(p3 == nullptr);
+  std::memset(p1, 0xAB, 32); // freed blocks must not depend on user bytes
   pool.deallocate(p1);
   void *p4 = pool.allocate();
   assert(p4 == p1);
+  assert(pool.getStats().usedBlocks == 2);
+  assert(pool.getStats().totalBlocks == 2);
+
+  // growable pools add slabs instead of failing and never move old blocks
+  PoolAllocator growable(64, 4, PoolAllocator::Growable);
+  void *blocks[10];
+  for (void *&block : blocks) {
+    block = growable.allocate();
+    assert(block != nullptr);
+    std::memset(block, 0xCD, 64);
+  }
+  assert(growable.getStats().slabCount == 3);
+  assert(growable.getStats().totalBlocks == 12);
+  assert(growable.getStats().usedBlocks == 10);
+  for (void *block : blocks) {
+    growable.deallocate(block);
+  }
+  assert(growable.getStats().usedBlocks == 0);
+  assert(growable.getStats().peakUsedBlocks == 10);
+  void *reusedBlock = growable.allocate();
+  assert(reusedBlock != nullptr);
+  assert(growable.getStats().slabCount == 3);
+
+  // concurrent pools: blocks are unique across threads while held, survive
+  // being freed on another thread, and slabs are added on demand
+  ConcurrentPoolAllocator shared(48, 256, 16);
+  assert(shared.getStats().blockSize >= 48 && shared.getStats().slabCount == 0);
+  constexpr int THREADS = 4;
+  constexpr int BLOCKS_PER_THREAD = 1000;
+  std::vector<std::vector<void *>> held(THREADS);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < THREADS; ++t) {
+    threads.emplace_back([&shared, &held, t] {
+      for (int round = 0; round < 20; ++round) {
+        for (int i = 0; i < BLOCKS_PER_THREAD; ++i) {
+          void *block = shared.allocate();
+          assert(block != nullptr);
+          std::memset(block, t + 1, 48);
+          held[t].push_back(block);
+        }
+        for (void *block : held[t]) {
+          assert(static_cast<unsigned char *>(block)[47] == t + 1);
+        }
+        if (round + 1 < 20) {
+          for (void *block : held[t]) shared.deallocate(block);
+          held[t].clear();
+        }
+      }
+    });
+  }
+  for (std::thread &thread : threads) thread.join();
+  std::set<void *> unique;
+  for (const std::vector<void *> &blocks : held) unique.insert(blocks.begin(), blocks.end());
+  assert(unique.size() == THREADS * BLOCKS_PER_THREAD);
+  ConcurrentPoolAllocator::Stats stats = shared.getStats();
+  assert(stats.usedBlocks == THREADS * BLOCKS_PER_THREAD);
+  assert(stats.totalBlocks == stats.slabCount * 256 && stats.totalBlocks >= stats.usedBlocks);
+  assert(stats.peakUsedBlocks >= stats.usedBlocks && stats.peakUsedBlocks <= stats.totalBlocks);
+
+  // free everything from other threads than the ones that allocated it
+  threads.clear();
+  for (int t = 0; t < THREADS; ++t) {
+    threads.emplace_back([&shared, &held, t] {
+      for (void *block : held[(t + 1) % THREADS]) shared.deallocate(block);
+      shared.flushThreadCache();
+    });
+  }
+  for (std::thread &thread : threads) thread.join();
+  assert(shared.getStats().usedBlocks == 0);
+
+  // freed blocks are reused before another slab is added
+  const size_t slabs = shared.getStats().slabCount;
+  std::vector<void *> again;
+  for (int i = 0; i < THREADS * BLOCKS_PER_THREAD; ++i) again.push_back(shared.allocate());
+  assert(shared.getStats().slabCount == slabs);
+  for (void *block : again) shared.deallocate(block);
+  assert(shared.getStats().usedBlocks == 0);
 
   return 0;
 }
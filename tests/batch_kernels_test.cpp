@@ -0,0 +1,102 @@
+#include "../engine/math/batch_kernels.hpp"
+#include "../engine/job_system.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using mathplease::AABB;
+using mathplease::Matrix4;
+using mathplease::Quaternion;
+using mathplease::Vector3;
+
+namespace {
+
+bool approx(float a, float b) { return std::fabs(a - b) <= 1e-4f * (1.0f + std::fabs(b)); }
+
+bool approx(const Vector3 &a, const Vector3 &b) { return approx(a.x, b.x) && approx(a.y, b.y) && approx(a.z, b.z); }
+
+bool sameBits(const Matrix4 &a, const Matrix4 &b) { return std::memcmp(a.m, b.m, sizeof(a.m)) == 0; }
+
+// Reference box: all eight corners through transformPoint
+AABB cornerBox(const Matrix4 &matrix, const AABB &box) {
+  AABB result{Vector3(INFINITY, INFINITY, INFINITY), Vector3(-INFINITY, -INFINITY, -INFINITY)};
+  for (int corner = 0; corner < 8; ++corner) {
+    const Vector3 p = matrix.transformPoint(Vector3(corner & 1 ? box.max.x : box.min.x,
+                                                    corner & 2 ? box.max.y : box.min.y,
+                                                    corner & 4 ? box.max.z : box.min.z));
+    result.min = Vector3(std::min(result.min.x, p.x), std::min(result.min.y, p.y), std::min(result.min.z, p.z));
+    result.max = Vector3(std::max(result.max.x, p.x), std::max(result.max.y, p.y), std::max(result.max.z, p.z));
+  }
+  return result;
+}
+
+} // namespace
+
+int main() {
+  std::mt19937 rng(9);
+  std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+  const Matrix4 matrix = Matrix4::translate({1.0f, -2.0f, 3.0f}) *
+                         Quaternion::fromAxisAngle({1.0f, 1.0f, 0.0f}, 0.7f).toMatrix() *
+                         Matrix4::scale({2.0f, 0.5f, 1.5f});
+
+  // odd sizes exercise the scalar tail after the groups of four
+  constexpr size_t COUNT = 1003;
+  std::vector<Matrix4> a(COUNT), b(COUNT), product(COUNT);
+  std::vector<Vector3> points(COUNT), transformed(COUNT);
+  std::vector<AABB> boxes(COUNT), transformedBoxes(COUNT);
+  for (size_t i = 0; i < COUNT; ++i) {
+    for (int k = 0; k < 16; ++k) {
+      a[i].m[k] = unit(rng);
+      b[i].m[k] = unit(rng);
+    }
+    points[i] = Vector3(unit(rng), unit(rng), unit(rng)) * 10.0f;
+    const Vector3 corner(unit(rng), unit(rng), unit(rng));
+    boxes[i] = AABB{corner, corner + Vector3(1.0f + unit(rng), 1.0f + unit(rng), 1.0f + unit(rng))};
+  }
+
+  mathplease::mulMatrices(a, b, product);
+  for (size_t i = 0; i < COUNT; ++i) assert(sameBits(product[i], a[i] * b[i]));
+  mathplease::mulMatrices(matrix, b, product);
+  for (size_t i = 0; i < COUNT; ++i) assert(sameBits(product[i], matrix * b[i]));
+
+  mathplease::transformPoints(matrix, points, transformed);
+  for (size_t i = 0; i < COUNT; ++i) assert(approx(transformed[i], matrix.transformPoint(points[i])));
+
+  mathplease::transformAABBs(matrix, boxes, transformedBoxes);
+  for (size_t i = 0; i < COUNT; ++i) {
+    const AABB expected = cornerBox(matrix, boxes[i]);
+    assert(approx(transformedBoxes[i].min, expected.min) && approx(transformedBoxes[i].max, expected.max));
+  }
+
+  // shorter output bounds the count; in place is allowed
+  std::vector<Vector3> inPlace(points.begin(), points.begin() + 7);
+  mathplease::transformPoints(matrix, points, std::span<Vector3>(inPlace));
+  mathplease::transformPoints(matrix, inPlace, inPlace);
+  assert(approx(inPlace[6], matrix.transformPoint(matrix.transformPoint(points[6]))));
+
+  // split across workers gives the same bits as the serial call
+  JobSystem jobSystem;
+  jobSystem.initialize(4);
+  constexpr size_t LARGE = 100001;
+  std::vector<Vector3> largePoints(LARGE), serialPoints(LARGE), jobPoints(LARGE);
+  std::vector<AABB> largeBoxes(LARGE), serialBoxes(LARGE), jobBoxes(LARGE);
+  for (size_t i = 0; i < LARGE; ++i) {
+    largePoints[i] = points[i % COUNT] + Vector3(float(i), 0.0f, 0.0f);
+    largeBoxes[i] = boxes[i % COUNT];
+  }
+  mathplease::transformPoints(matrix, largePoints, serialPoints);
+  mathplease::transformPoints(matrix, largePoints, jobPoints, &jobSystem);
+  assert(std::memcmp(serialPoints.data(), jobPoints.data(), LARGE * sizeof(Vector3)) == 0);
+  mathplease::transformAABBs(matrix, largeBoxes, serialBoxes);
+  mathplease::transformAABBs(matrix, largeBoxes, jobBoxes, &jobSystem);
+  assert(std::memcmp(serialBoxes.data(), jobBoxes.data(), LARGE * sizeof(AABB)) == 0);
+  std::vector<Matrix4> largeMatrices(LARGE), serialProducts(LARGE), jobProducts(LARGE);
+  for (size_t i = 0; i < LARGE; ++i) largeMatrices[i] = b[i % COUNT];
+  mathplease::mulMatrices(largeMatrices, largeMatrices, serialProducts);
+  mathplease::mulMatrices(largeMatrices, largeMatrices, jobProducts, &jobSystem);
+  assert(std::memcmp(serialProducts.data(), jobProducts.data(), LARGE * sizeof(Matrix4)) == 0);
+  return 0;
+}
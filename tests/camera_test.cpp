@@ -33,5 +33,14 @@ int main() {
   assert(approx(cameraInView.y, 0.0f));
   assert(approx(cameraInView.z, 0.0f));
 
+  // the frustum follows the view: points just in front of the camera along
+  // view -z are inside, points behind it are not
+  auto frustum = camera.getFrustum(0.1f, 100.0f);
+  auto ahead = view.inverse().transformPoint(mathplease::Vector3(0.0f, 0.0f, -5.0f));
+  auto behind = view.inverse().transformPoint(mathplease::Vector3(0.0f, 0.0f, 5.0f));
+  assert(frustum.contains(ahead));
+  assert(!frustum.contains(behind));
+  assert(!frustum.contains(view.inverse().transformPoint(mathplease::Vector3(0.0f, 0.0f, -200.0f))));
+
   return 0;
 }
@@ -0,0 +1,105 @@
+#include "../engine/entity/entity.h"
+#include "../engine/entity/systems.h"
+#include "../engine/job_system.h"
+#include <algorithm>
+#include <cassert>
+#include <thread>
+#include <vector>
+
+namespace {
+bool contains(std::span<const Entity_id> ids, Entity_id id) {
+  return std::find(ids.begin(), ids.end(), id) != ids.end();
+}
+} // namespace
+
+int main() {
+  EntityManager em;
+  ComponentEventStream &events = em.getEvents();
+
+  // nothing is recorded until a component is observed
+  Entity_id ignored = em.createEntity(Components::Health);
+  events.sync();
+  assert(events.get(ComponentEvent::OnAdd, Components::Health).empty());
+
+  events.observe(Components::Health | Components::Renderable);
+  Entity_id a = em.createEntity(Components::Health | Components::Position);
+  Entity_id b = em.createEntity(Components::Renderable);
+  em.addComponent(ignored, Components::Renderable);
+  em.removeComponent(a, Components::Health);
+  Health hp{5, 10};
+  em.writeComponent(b, Components::Health, &hp); // b has no Health: no event
+  em.writeComponent(ignored, Components::Health, &hp);
+  em.destroyEntity(b);
+
+  // events are invisible until the sync point
+  assert(events.get(ComponentEvent::OnAdd, Components::Health).empty());
+  events.sync();
+
+  auto addedHealth = events.get(ComponentEvent::OnAdd, Components::Health);
+  assert(addedHealth.size() == 1 && addedHealth[0] == a);
+  auto addedRenderable = events.get(ComponentEvent::OnAdd, Components::Renderable);
+  assert(addedRenderable.size() == 2);
+  assert(contains(addedRenderable, b) && contains(addedRenderable, ignored));
+  auto removedHealth = events.get(ComponentEvent::OnRemove, Components::Health);
+  assert(removedHealth.size() == 1 && removedHealth[0] == a);
+  auto removedRenderable = events.get(ComponentEvent::OnRemove, Components::Renderable);
+  assert(removedRenderable.size() == 1 && removedRenderable[0] == b);
+  auto setHealth = events.get(ComponentEvent::OnSet, Components::Health);
+  assert(setHealth.size() == 1 && setHealth[0] == ignored);
+  assert(events.get(ComponentEvent::OnAdd, Components::Position).empty());
+
+  // a sync with no new events empties the streams
+  events.sync();
+  assert(events.get(ComponentEvent::OnAdd, Components::Health).empty());
+
+  // many producers: jobs mark changes concurrently into per-thread buffers
+  JobSystem jobSystem;
+  jobSystem.initialize(4);
+  std::vector<Entity_id> ids;
+  for (int i = 0; i < 4000; ++i) {
+    ids.push_back(em.createEntity(Components::Health));
+  }
+  events.sync();
+  assert(events.get(ComponentEvent::OnAdd, Components::Health).size() == 4000);
+
+  JobCounter counter;
+  for (uint32_t job = 0; job < 16; ++job) {
+    jobSystem.kickJob(
+        [&em, &ids, job]() {
+          for (size_t i = job; i < ids.size(); i += 16) {
+            em.markComponentSet(ids[i], Components::Health | Components::Position);
+          }
+        },
+        &counter);
+  }
+  jobSystem.waitForCounter(&counter);
+
+  // plain threads that outlive nothing still land in their own slots
+  std::thread producer([&em, &ids]() { em.markComponentSet(ids[0], Components::Health); });
+  producer.join();
+
+  events.sync();
+  auto set = events.get(ComponentEvent::OnSet, Components::Health);
+  assert(set.size() == ids.size() + 1);
+  std::vector<Entity_id> sorted(set.begin(), set.end());
+  std::sort(sorted.begin(), sorted.end());
+  std::vector<Entity_id> expected = ids;
+  expected.push_back(ids[0]);
+  std::sort(expected.begin(), expected.end());
+  assert(sorted == expected);
+  assert(events.get(ComponentEvent::OnSet, Components::Position).empty());
+
+  // systems writing through chunk columns report OnSet when observed
+  events.observe(Components::Position);
+  Entity_id falling =
+      em.createEntity(Components::Position | Components::Velocity | Components::Gravity);
+  GravitySystem gravity;
+  events.sync();
+  gravity.update(em, &jobSystem, 1.0f / 60.0f);
+  events.sync();
+  auto moved = events.get(ComponentEvent::OnSet, Components::Position);
+  assert(moved.size() == 1 && moved[0] == falling);
+  assert(events.get(ComponentEvent::OnSet, Components::Velocity).empty());
+
+  return 0;
+}
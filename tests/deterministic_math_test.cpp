@@ -0,0 +1,117 @@
+// Golden hash of a fixed simulation in deterministic math mode. Every gravity
+// kernel backend reproduces it bit for bit within this binary, and any other
+// conforming build (compiler, optimisation level, Matrix4 SIMD backend, CPU)
+// must reproduce GOLDEN_HASH. A different hash means the arithmetic changed:
+// update the constant only when that is intended.
+#include "../engine/entity/motion_kernels.h"
+#include "../engine/math/batch_kernels.hpp"
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+static_assert(mathplease::isDeterministicMath(), "build with MATHPLEASE_DETERMINISTIC");
+
+using mathplease::Matrix4;
+using mathplease::Quaternion;
+using mathplease::Vector3;
+using mathplease::Vector4;
+
+namespace {
+
+constexpr uint32_t BODIES = 1037; // odd, so vector loops and tails both run
+constexpr uint32_t NODES = 63;
+constexpr int STEPS = 240;
+constexpr float DELTA_TIME = 1.0f / 60.0f;
+constexpr uint64_t GOLDEN_HASH = 0x28febd38555b9514ull;
+
+// Inputs from a fixed integer generator: std::uniform_real_distribution is
+// implementation defined and differs between standard libraries
+struct Random {
+  uint32_t state;
+  // exact multiples of 2^-23 in [-1, 1)
+  float next() {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return static_cast<float>(state >> 8) * (1.0f / 8388608.0f) - 1.0f;
+  }
+};
+
+// FNV-1a over the raw bytes
+struct Hasher {
+  uint64_t value = 14695981039346656037ull;
+  template <typename T> void add(const std::vector<T> &items) {
+    const auto *bytes = reinterpret_cast<const unsigned char *>(items.data());
+    for (size_t i = 0; i < items.size() * sizeof(T); ++i) value = (value ^ bytes[i]) * 1099511628211ull;
+  }
+};
+
+uint64_t simulate(KernelBackend backend) {
+  Random rng{0x2545F491u};
+  std::vector<Position> positions(BODIES);
+  std::vector<Velocity> velocities(BODIES);
+  for (uint32_t i = 0; i < BODIES; ++i) {
+    positions[i].value = Vector4(rng.next() * 100.0f, rng.next() * 100.0f, rng.next() * 100.0f, 1.0f);
+    velocities[i].value = Vector4(rng.next() * 10.0f, rng.next() * 10.0f, rng.next() * 10.0f, 0.0f);
+  }
+  // A binary tree of spinning, offset nodes; spins avoid sin/cos, which are
+  // libm's and not covered by the mode
+  std::vector<Quaternion> spins(NODES), spinSteps(NODES);
+  std::vector<Vector3> offsets(NODES);
+  for (uint32_t i = 0; i < NODES; ++i) {
+    spinSteps[i] = Quaternion(rng.next() * 0.02f, rng.next() * 0.02f, rng.next() * 0.02f, 1.0f).normalized();
+    offsets[i] = Vector3(rng.next(), rng.next(), rng.next()) * 4.0f;
+  }
+
+  const GravityKernels &kernels = getGravityKernels(backend);
+  std::vector<Matrix4> world(NODES);
+  for (int step = 0; step < STEPS; ++step) {
+    kernels.interleaved(positions.data(), velocities.data(), BODIES, DELTA_TIME);
+    // speed dependent drag: sqrt and division
+    for (Velocity &velocity : velocities) {
+      const float speed = velocity.value.xyz().length();
+      const float damping = 1.0f / (1.0f + 0.05f * speed * DELTA_TIME);
+      velocity.value = Vector4(velocity.value.xyz() * damping, velocity.value.w);
+    }
+    for (uint32_t i = 0; i < NODES; ++i) {
+      spins[i] = (spins[i] * spinSteps[i]).normalized();
+      const Matrix4 local = Matrix4::translate(offsets[i]) * spins[i].toMatrix();
+      world[i] = i == 0 ? local : world[(i - 1) / 2] * local;
+    }
+  }
+
+  std::vector<Vector3> points(BODIES), transformed(BODIES), directions(BODIES);
+  for (uint32_t i = 0; i < BODIES; ++i) {
+    points[i] = positions[i].value.xyz();
+    directions[i] = velocities[i].value.xyz().normalized();
+  }
+  mathplease::transformPoints(world.back(), points, transformed);
+  std::vector<Matrix4> inverses;
+  for (const Matrix4 &matrix : world) inverses.push_back(matrix.inverse());
+
+  Hasher hasher;
+  hasher.add(positions);
+  hasher.add(velocities);
+  hasher.add(directions);
+  hasher.add(world);
+  hasher.add(transformed);
+  hasher.add(inverses);
+  return hasher.value;
+}
+
+} // namespace
+
+int main() {
+  const uint64_t hash = simulate(KernelBackend::Scalar);
+  for (KernelBackend backend : {KernelBackend::SSE, KernelBackend::AVX2}) {
+    if (isKernelBackendSupported(backend)) assert(simulate(backend) == hash);
+  }
+  if (hash != GOLDEN_HASH) {
+    std::fprintf(stderr, "simulation hash %016llx, expected %016llx (matrix backend %s)\n",
+                 static_cast<unsigned long long>(hash), static_cast<unsigned long long>(GOLDEN_HASH),
+                 mathplease::matrixBackendName());
+    return 1;
+  }
+  return 0;
+}
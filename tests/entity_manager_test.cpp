@@ -1,4 +1,5 @@
 #include "../engine/entity/entity.h"
+#include "../engine/entity/prefab.h"
 #include <cassert>
 
 int main() {
@@ -33,5 +34,103 @@ int main() {
       em.getAllArchetypesWithComponent(Components::Position | Components::Velocity);
   assert(!archetypes.empty());
 
+  // split layout: vector components live in x/y/z streams
+  EntityManager splitEm(ColumnLayout::Split);
+  Entity_id splitEntity = splitEm.createEntity(movingMask | Components::Health);
+  const Position splitPosition{mathplease::Vector4(4.0f, 5.0f, 6.0f, 0.0f)};
+  const bool written = splitEm.writeComponent(splitEntity, Components::Position, &splitPosition);
+  assert(written);
+  assert(splitEm.getComponentData(splitEntity, Components::Position) == nullptr);
+  assert(splitEm.getComponentData(splitEntity, Components::Health) != nullptr);
+
+  Archetype *splitArch = splitEm.getAllArchetypesWithComponent(movingMask)[0];
+  const Vector3Streams streams =
+      getVector3Streams(*splitArch, *splitArch->chunks[0], Components::Position);
+  assert(streams.x[0] == 4.0f && streams.y[0] == 5.0f && streams.z[0] == 6.0f);
+
+  // components survive archetype moves lane by lane
+  splitEm.removeComponent(splitEntity, Components::Health);
+  Position readBack;
+  const bool gathered = splitEm.readComponent(splitEntity, Components::Position, &readBack);
+  assert(gathered);
+  assert(readBack.value.x == 4.0f && readBack.value.y == 5.0f &&
+         readBack.value.z == 6.0f && readBack.value.w == 0.0f);
+
+  // tag components: in the mask, no column, no row bytes
+  Entity_id falling = em.createEntity(movingMask | Components::Gravity);
+  assert(em.hasComponent(falling, Components::Gravity));
+  assert(em.hasComponent(falling, movingMask | Components::Gravity));
+  assert(!em.hasComponent(moving, Components::Gravity));
+  assert(em.getComponentData(falling, Components::Gravity) == nullptr);
+  assert(em.getComponentData(falling, Components::Position) != nullptr);
+
+  Archetype *movingArch =
+      em.getArchetypes(ComponentQuery(movingMask, Components::Gravity))[0];
+  Archetype *fallingArch =
+      em.getArchetypes(movingMask | Components::Gravity)[0];
+  const uint8_t gravityIndex = componentMaskToIndex(Components::Gravity);
+  assert(fallingArch->sizes[gravityIndex] == 0);
+  assert(fallingArch->lanes[gravityIndex] == 0);
+  assert(fallingArch->rowSize == movingArch->rowSize);
+  assert(fallingArch->chunkCapacity == movingArch->chunkCapacity);
+
+  struct Frozen {};
+  assert(ComponentRegistry::getInfo(ComponentRegistry::registerType<Frozen>()).size == 0);
+
+  // with/without filters work on whole archetypes and stay cached
+  auto &withoutGravity =
+      em.getArchetypes(ComponentQuery(Components::Position, Components::Gravity));
+  for (Archetype *arch : withoutGravity) {
+    assert((arch->componentMask & Components::Gravity) == 0);
+  }
+  const size_t before = withoutGravity.size();
+  Entity_id aiEntity = em.createEntity(Components::Position | Components::AI);
+  assert(withoutGravity.size() == before + 1);
+  em.createEntity(Components::Position | Components::AI | Components::Gravity);
+  assert(withoutGravity.size() == before + 1);
+
+  auto grounded = em.getAllEntitiesWithComponents(
+      ComponentQuery(Components::Position, Components::Gravity));
+  assert(grounded.size() == 3);
+  auto gravityEntities = em.getAllEntitiesWithComponents(Components::Gravity);
+  assert(gravityEntities.size() == 2);
+  em.destroyEntity(aiEntity);
+  assert(em.getAllEntitiesWithComponents(
+                ComponentQuery(Components::Position, Components::Gravity))
+             .size() == 2);
+
+  // memory stats: worlds grow past the old fixed 1024-chunk (16 MB) pool
+  {
+    EntityManager big;
+    const uint32_t count = 1000000;
+    const uint32_t made = big.instantiate(Prefab(Components::Position), count);
+    assert(made == count);
+    big.createEntity(Components::Health);
+
+    const EcsMemoryStats stats = big.getMemoryStats();
+    assert(stats.entityCount == count + 1);
+    assert(stats.chunkBytesInUse > 16u * 1024 * 1024);
+    assert(stats.chunkBytesReserved >= stats.chunkBytesInUse);
+    assert(stats.archetypes.size() == 2);
+
+    const ArchetypeMemoryStats &positions = stats.archetypes[0];
+    assert(positions.componentMask == Components::Position);
+    assert(positions.entityCount == count);
+    assert(positions.bytesPerRow == sizeof(Entity_id) + sizeof(Position));
+    assert(positions.chunkCount ==
+           (count + positions.chunkCapacity - 1) / positions.chunkCapacity);
+    assert(positions.usedBytes == size_t(count) * positions.bytesPerRow);
+    assert(positions.freeRowBytes ==
+           (size_t(positions.chunkCount) * positions.chunkCapacity - count) *
+               positions.bytesPerRow);
+    assert(positions.wastedTailBytes < positions.chunkCount * 1024u);
+    assert(positions.occupancy > 0.99f && positions.occupancy <= 1.0f);
+
+    const ArchetypeMemoryStats &health = stats.archetypes[1];
+    assert(health.chunkCount == 1 && health.entityCount == 1);
+    assert(health.occupancy < 0.01f);
+    big.logMemoryStats();
+  }
+
   return 0;
 }
@@ -0,0 +1,98 @@
+#include "../engine/math/frustum.hpp"
+#include "../engine/job_system.h"
+#include <cassert>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace mathplease;
+
+namespace {
+
+bool nearlyEqual(float a, float b) { return std::fabs(a - b) < 1e-5f * (1.0f + std::fabs(b)); }
+
+bool bit(const std::vector<uint64_t> &mask, size_t i) { return (mask[i / 64] >> (i % 64)) & 1; }
+
+} // namespace
+
+int main() {
+  // 90 degree square frustum looking down -z: |x|, |y| <= -z between 1 and 100
+  const Matrix4 projection = Matrix4::perspective(1.5707964f, 1.0f, 1.0f, 100.0f);
+  const Frustum view = Frustum::fromMatrix(projection);
+  for (const Vector4 &plane : view.planes) {
+    assert(nearlyEqual(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z, 1.0f));
+  }
+  assert(nearlyEqual(view.planes[Frustum::Near].w, -1.0f) && nearlyEqual(view.planes[Frustum::Far].w, 100.0f));
+  assert(view.contains(Vector3(0.0f, 0.0f, -10.0f)));
+  assert(view.contains(Vector3(9.0f, -9.0f, -10.0f)));
+  assert(!view.contains(Vector3(11.0f, 0.0f, -10.0f)) && !view.contains(Vector3(0.0f, -11.0f, -10.0f)));
+  assert(!view.contains(Vector3(0.0f, 0.0f, 10.0f)));
+  assert(!view.contains(Vector3(0.0f, 0.0f, -0.5f)) && !view.contains(Vector3(0.0f, 0.0f, -101.0f)));
+
+  // volumes straddling a plane intersect, ones fully behind it do not
+  assert(view.intersects(AABB{Vector3(10.5f, -1.0f, -11.0f), Vector3(12.0f, 1.0f, -10.0f)}));
+  assert(!view.intersects(AABB{Vector3(11.5f, -1.0f, -11.0f), Vector3(12.0f, 1.0f, -10.0f)}));
+  assert(view.intersects(AABB{Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 1.0f, 1.0f)}));
+  assert(view.intersects(Sphere{Vector3(0.0f, 0.0f, -0.5f), 0.6f}));
+  assert(!view.intersects(Sphere{Vector3(0.0f, 0.0f, -0.5f), 0.4f}));
+  assert(view.intersects(Sphere{Vector3(-12.0f, 0.0f, -10.0f), 1.5f}));
+  assert(!view.intersects(Sphere{Vector3(-12.0f, 0.0f, -10.0f), 1.0f}));
+
+  // projection * view gives world-space planes
+  const Frustum world = Frustum::fromMatrix(projection * Matrix4::translate(Vector3(-5.0f, 0.0f, 0.0f)));
+  assert(world.contains(Vector3(5.0f, 0.0f, -10.0f)) && !world.contains(Vector3(15.5f, 0.0f, -10.0f)));
+  assert(!world.contains(Vector3(-6.0f, 0.0f, -10.0f)));
+
+  // OpenGL-style depth: near plane at z = -w rather than z = 0
+  const Matrix4 ortho = Matrix4::orthographic(-1.0f, 1.0f, -1.0f, 1.0f, 1.0f, 10.0f);
+  const Frustum gl = Frustum::fromMatrix(ortho, ClipDepth::MinusOneToOne);
+  assert(gl.contains(Vector3(0.0f, 0.0f, -5.0f)) && gl.contains(Vector3(0.9f, 0.9f, -9.9f)));
+  assert(!gl.contains(Vector3(0.0f, 0.0f, -0.5f)) && !gl.contains(Vector3(0.0f, 0.0f, -10.5f)));
+
+  // batched masks match the single tests, including the partial last word
+  const size_t count = 100003;
+  std::mt19937 rng(17);
+  std::uniform_real_distribution<float> position(-60.0f, 60.0f);
+  std::uniform_real_distribution<float> size(0.0f, 4.0f);
+  std::vector<AABB> aabbs(count);
+  std::vector<float> cx(count), cy(count), cz(count), ex(count), ey(count), ez(count), radius(count);
+  for (size_t i = 0; i < count; ++i) {
+    const Vector3 corner(position(rng), position(rng), position(rng) - 50.0f);
+    aabbs[i] = AABB{corner, corner + Vector3(size(rng), size(rng), size(rng))};
+    // the same centre and extent arithmetic as Frustum::intersects(AABB)
+    const Vector3 center = (aabbs[i].min + aabbs[i].max) * 0.5f;
+    const Vector3 extent = (aabbs[i].max - aabbs[i].min) * 0.5f;
+    cx[i] = center.x;
+    cy[i] = center.y;
+    cz[i] = center.z;
+    ex[i] = extent.x;
+    ey[i] = extent.y;
+    ez[i] = extent.z;
+    radius[i] = size(rng);
+  }
+  const BoxStreams boxes{cx.data(), cy.data(), cz.data(), ex.data(), ey.data(), ez.data()};
+  const SphereStreams spheres{cx.data(), cy.data(), cz.data(), radius.data()};
+  std::vector<uint64_t> boxMask(visibilityWords(count), ~0ull), sphereMask(visibilityWords(count), ~0ull);
+  cullBoxes(world, boxes, count, boxMask.data());
+  cullSpheres(world, spheres, count, sphereMask.data());
+
+  size_t visibleBoxes = 0;
+  for (size_t i = 0; i < count; ++i) {
+    assert(bit(boxMask, i) == world.intersects(aabbs[i]));
+    assert(bit(sphereMask, i) == world.intersects(Sphere{Vector3(cx[i], cy[i], cz[i]), radius[i]}));
+    visibleBoxes += bit(boxMask, i);
+  }
+  assert(visibleBoxes > count / 10 && visibleBoxes < count - count / 10); // both outcomes covered
+  assert(boxMask.back() >> (count % 64) == 0 && sphereMask.back() >> (count % 64) == 0);
+
+  // split across workers gives the same words
+  JobSystem jobSystem;
+  jobSystem.initialize(4);
+  std::vector<uint64_t> parallelBoxes(visibilityWords(count)), parallelSpheres(visibilityWords(count));
+  cullBoxes(world, boxes, count, parallelBoxes.data(), &jobSystem);
+  cullSpheres(world, spheres, count, parallelSpheres.data(), &jobSystem);
+  assert(parallelBoxes == boxMask && parallelSpheres == sphereMask);
+
+  cullBoxes(world, boxes, 0, nullptr);
+  return 0;
+}
@@ -3,6 +3,7 @@
 #include "../engine/job_system.h"
 #include <cassert>
 #include <cmath>
+#include <vector>
 
 namespace {
 bool approx(float a, float b, float eps = 1e-4f) {
@@ -62,5 +63,34 @@ int main() {
   assert(approx(staticPos->value.z, 7.0f));
   assert(approx(staticVel->value.y, 0.0f));
 
+  // split (SoA) columns go through the stream kernel; use enough entities to
+  // cover full SIMD blocks and a scalar tail
+  EntityManager splitEm(ColumnLayout::Split);
+  std::vector<Entity_id> splitIds;
+  for (int i = 0; i < 37; ++i) {
+    Entity_id id = splitEm.createEntity(gravityMask);
+    assert(splitEm.getComponentData(id, Components::Position) == nullptr);
+    const Position p{mathplease::Vector4(float(i), 10.0f, 0.0f, 0.0f)};
+    const Velocity v{mathplease::Vector4(1.0f, 2.0f, 3.0f, 0.0f)};
+    const bool written = splitEm.writeComponent(id, Components::Position, &p) &&
+                         splitEm.writeComponent(id, Components::Velocity, &v);
+    assert(written);
+    splitIds.push_back(id);
+  }
+
+  gravitySystem.update(splitEm, &jobSystem, 1.0f);
+
+  for (int i = 0; i < 37; ++i) {
+    Position p;
+    Velocity v;
+    const bool gathered = splitEm.readComponent(splitIds[i], Components::Position, &p) &&
+                      splitEm.readComponent(splitIds[i], Components::Velocity, &v);
+    assert(gathered);
+    assert(approx(v.value.y, -7.81f));
+    assert(approx(p.value.x, float(i) + 1.0f));
+    assert(approx(p.value.y, 2.19f));
+    assert(approx(p.value.z, 3.0f));
+  }
+
   return 0;
 }
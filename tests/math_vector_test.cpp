@@ -1,11 +1,29 @@
 #include "../engine/math/vector.hpp"
 #include <cassert>
 #include <cmath>
+#include <random>
 
 namespace {
 bool approx(float a, float b, float eps = 1e-4f) {
   return std::fabs(a - b) <= eps;
 }
+
+bool approx(const mathplease::Matrix4 &a, const mathplease::Matrix4 &b, float eps = 1e-4f) {
+  for (int i = 0; i < 16; ++i) {
+    if (!approx(a.m[i], b.m[i], eps * (1.0f + std::fabs(b.m[i])))) return false;
+  }
+  return true;
+}
+// the math types work in constant expressions
+constexpr mathplease::Matrix4 kModel =
+    mathplease::Matrix4::translate({1.0f, 2.0f, 3.0f}) * mathplease::Matrix4::scale(2.0f);
+static_assert(kModel(0, 0) == 2.0f && kModel(2, 3) == 3.0f && kModel(3, 3) == 1.0f);
+static_assert((kModel * mathplease::Vector4(1.0f, 1.0f, 1.0f, 1.0f)).xyz() == mathplease::Vector3(3.0f, 4.0f, 5.0f));
+static_assert(kModel.transposed()(3, 0) == 1.0f);
+static_assert(mathplease::Vector3::unitX().cross(mathplease::Vector3::unitY()) == mathplease::Vector3::unitZ());
+static_assert(mathplease::Vector3(1.0f, 2.0f, 3.0f).dot(mathplease::Vector3::one()) == 6.0f);
+static_assert(mathplease::Transform::identity()(1, 1) == 1.0f && mathplease::Transform().translation() == mathplease::Vector3::zero());
+static_assert(mathplease::Quaternion::identity().conjugate() == mathplease::Quaternion());
 } // namespace
 
 int main() {
@@ -34,5 +52,83 @@ int main() {
   assert(approx(recovered.y, original.y));
   assert(approx(recovered.z, original.z));
 
+  // quaternions agree with the axis-angle matrices
+  using mathplease::Quaternion;
+  using mathplease::Transform;
+  const mathplease::Vector3 axis(1.0f, 2.0f, -0.5f);
+  const Quaternion q = Quaternion::fromAxisAngle(axis, 0.8f);
+  const auto viaQuat = q.rotate(original);
+  const auto viaMatrix = mathplease::Matrix4::rotate(axis.normalized(), 0.8f).transformPoint(original);
+  assert(approx(viaQuat.x, viaMatrix.x) && approx(viaQuat.y, viaMatrix.y) && approx(viaQuat.z, viaMatrix.z));
+  const auto viaQuatMatrix = q.toMatrix().transformPoint(original);
+  assert(approx(viaQuatMatrix.x, viaMatrix.x) && approx(viaQuatMatrix.y, viaMatrix.y));
+  const auto back = q.inverse().rotate(viaQuat);
+  assert(approx(back.x, original.x) && approx(back.y, original.y) && approx(back.z, original.z));
+  const Quaternion twice = q * q;
+  const auto viaTwice = twice.rotate(original);
+  const auto viaTwoSteps = q.rotate(q.rotate(original));
+  assert(approx(viaTwice.x, viaTwoSteps.x) && approx(viaTwice.z, viaTwoSteps.z));
+
+  // slerp hits both ends and halves the angle; nlerp stays unit length
+  const Quaternion from = Quaternion::identity();
+  const Quaternion to = Quaternion::fromAxisAngle({0.0f, 0.0f, 1.0f}, 2.0f);
+  const Quaternion half = Quaternion::slerp(from, to, 0.5f);
+  const Quaternion expectedHalf = Quaternion::fromAxisAngle({0.0f, 0.0f, 1.0f}, 1.0f);
+  assert(approx(half.z, expectedHalf.z) && approx(half.w, expectedHalf.w));
+  assert(approx(Quaternion::slerp(from, to, 1.0f).z, to.z));
+  const Quaternion negatedTo(-to.x, -to.y, -to.z, -to.w); // same rotation, other hemisphere
+  assert(approx(std::fabs(Quaternion::slerp(from, negatedTo, 0.5f).dot(expectedHalf)), 1.0f));
+  assert(approx(Quaternion::nlerp(from, to, 0.3f).length(), 1.0f));
+
+  // affine TRS matches the 4x4 T * R * S, composes and inverts like it
+  const mathplease::Vector3 t(1.0f, -2.0f, 0.5f);
+  const mathplease::Vector3 s(2.0f, 0.5f, 3.0f);
+  const Transform trs = Transform::fromTRS(t, q, s);
+  const auto full = mathplease::Matrix4::translate(t) * q.toMatrix() * mathplease::Matrix4::scale(s);
+  const auto trsMatrix = trs.toMatrix4();
+  for (int i = 0; i < 16; ++i) assert(approx(trsMatrix.m[i], full.m[i]));
+
+  const Transform other = Transform::fromTRS({0.0f, 4.0f, 0.0f}, to, {1.0f, 1.0f, 2.0f});
+  const auto product = (trs * other).toMatrix4();
+  const auto fullProduct = full * other.toMatrix4();
+  for (int i = 0; i < 16; ++i) assert(approx(product.m[i], fullProduct.m[i]));
+
+  const auto roundTrip = trs.inverse().transformPoint(trs.transformPoint(original));
+  assert(approx(roundTrip.x, original.x) && approx(roundTrip.y, original.y) &&
+         approx(roundTrip.z, original.z));
+  const auto inverseMatrix = trs.inverse().toMatrix4();
+  const auto fullInverse = full.inverse();
+  for (int i = 0; i < 16; ++i) assert(approx(inverseMatrix.m[i], fullInverse.m[i]));
+
+  // the inline (SIMD when available) Matrix4 paths match the scalar reference
+  namespace scalar = mathplease::scalar;
+  std::mt19937 rng(11);
+  std::uniform_real_distribution<float> unit(-2.0f, 2.0f);
+  for (int iteration = 0; iteration < 1000; ++iteration) {
+    mathplease::Matrix4 x, y;
+    for (int i = 0; i < 16; ++i) {
+      x.m[i] = unit(rng);
+      y.m[i] = unit(rng);
+    }
+    const mathplease::Vector4 v(unit(rng), unit(rng), unit(rng), unit(rng));
+    assert(approx(x * y, scalar::multiply(x, y)));
+    const mathplease::Vector4 xv = x * v;
+    const mathplease::Vector4 expected = scalar::transform(x, v);
+    assert(approx(xv.x, expected.x) && approx(xv.y, expected.y) && approx(xv.z, expected.z) &&
+           approx(xv.w, expected.w));
+    const mathplease::Matrix4 transposed = x.transposed();
+    for (int i = 0; i < 16; ++i) assert(transposed.m[i] == scalar::transpose(x).m[i]);
+    // random matrices can be badly conditioned; compare through M * inv(M) too
+    const mathplease::Matrix4 inverse = x.inverse();
+    if (std::fabs(x.determinant()) > 0.1f) {
+      assert(approx(inverse, scalar::inverse(x), 1e-2f));
+      assert(approx(x * inverse, mathplease::Matrix4::identity(), 1e-3f));
+    }
+  }
+  // singular matrices fall back to identity on every backend
+  mathplease::Matrix4 singular(1.0f);
+  singular.m[5] = 0.0f;
+  assert(approx(singular.inverse(), mathplease::Matrix4::identity()));
+
   return 0;
 }
@@ -0,0 +1,123 @@
+#include "../engine/memory/concurrent_pool_allocator.h"
+#include "../engine/memory/frame_allocator.h"
+#include "../engine/memory/linear_allocator.h"
+#include "../engine/memory/memory_tracker.h"
+#include "../engine/memory/pool_allocator.h"
+#include <cassert>
+#include <thread>
+#include <vector>
+
+static_assert(LIGHTS_PLEASE_MEMORY_TRACKING, "memory_tracker_tests must be built with tracking on");
+
+using memory_tracker::getStats;
+using memory_tracker::TagStats;
+
+// stops the compiler from pairing up and removing new/delete in the tests
+static void *volatile escape;
+
+int main() {
+  memory_tracker::markBaseline();
+
+  // global new/delete are charged to the tag in scope
+  {
+    const TagStats before = getStats(MemoryTag::Assets);
+    int *values = nullptr;
+    {
+      memory_tracker::TagScope tag(MemoryTag::Assets);
+      values = new int[256];
+      escape = values;
+    }
+    TagStats during = getStats(MemoryTag::Assets);
+    assert(during.liveBytes == before.liveBytes + 256 * sizeof(int));
+    assert(during.liveAllocations == before.liveAllocations + 1);
+    assert(during.totalAllocations == before.totalAllocations + 1);
+    assert(during.peakBytes >= during.liveBytes);
+
+    delete[] values; // freed outside the scope, still charged back to Assets
+    const TagStats after = getStats(MemoryTag::Assets);
+    assert(after.liveBytes == before.liveBytes);
+    assert(after.liveAllocations == before.liveAllocations);
+    assert(after.peakBytes == during.peakBytes);
+  }
+
+  // pool blocks are recorded one by one under the pool's tag; the slab is not
+  {
+    const TagStats before = getStats(MemoryTag::ECS);
+    PoolAllocator pool(64, 8, PoolAllocator::Growable, MemoryTag::ECS);
+    assert(getStats(MemoryTag::ECS).liveBytes == before.liveBytes);
+    std::vector<void *> blocks;
+    for (int i = 0; i < 12; ++i) blocks.push_back(pool.allocate());
+    TagStats during = getStats(MemoryTag::ECS);
+    assert(during.liveBytes == before.liveBytes + 12 * 64);
+    assert(during.liveAllocations == before.liveAllocations + 12);
+    for (void *block : blocks) pool.deallocate(block);
+    assert(getStats(MemoryTag::ECS).liveBytes == before.liveBytes);
+    assert(getStats(MemoryTag::ECS).peakBytes >= before.liveBytes + 12 * 64);
+  }
+
+  // the concurrent pool records blocks freed on another thread too
+  {
+    const TagStats before = getStats(MemoryTag::Jobs);
+    ConcurrentPoolAllocator pool(128, 64, 8, MemoryTag::Jobs);
+    std::vector<void *> blocks;
+    for (int i = 0; i < 100; ++i) blocks.push_back(pool.allocate());
+    assert(getStats(MemoryTag::Jobs).liveAllocations == before.liveAllocations + 100);
+    std::thread([&] {
+      for (void *block : blocks) pool.deallocate(block);
+      pool.flushThreadCache();
+    }).join();
+    assert(getStats(MemoryTag::Jobs).liveBytes == before.liveBytes);
+    assert(getStats(MemoryTag::Jobs).liveAllocations == before.liveAllocations);
+  }
+
+  // linear allocators report bytes in use, including alignment padding,
+  // and give them back on freeToMarker, reset and destruction
+  {
+    const TagStats before = getStats(MemoryTag::Renderer);
+    {
+      LinearAllocator linear(1024, MemoryTag::Renderer);
+      assert(getStats(MemoryTag::Renderer).liveBytes == before.liveBytes);
+      linear.allocate(10, 1);
+      const LinearAllocator::Marker marker = linear.getMarker();
+      linear.allocate(16, 16);
+      assert(getStats(MemoryTag::Renderer).liveBytes == before.liveBytes + linear.getUsed());
+      linear.freeToMarker(marker);
+      assert(getStats(MemoryTag::Renderer).liveBytes == before.liveBytes + 10);
+      linear.reset();
+      assert(getStats(MemoryTag::Renderer).liveBytes == before.liveBytes);
+      linear.allocate(100, 1);
+    }
+    assert(getStats(MemoryTag::Renderer).liveBytes == before.liveBytes);
+
+    FrameAllocator frames(256, 2, MemoryTag::Renderer);
+    frames.beginFrame(0);
+    frames.allocate(64, 1);
+    frames.beginFrame(1);
+    frames.allocate(32, 1);
+    assert(getStats(MemoryTag::Renderer).liveBytes == before.liveBytes + 96);
+    frames.beginFrame(2); // reuses frame 0
+    assert(getStats(MemoryTag::Renderer).liveBytes == before.liveBytes + 32);
+    assert(getStats(MemoryTag::Renderer).peakBytes >= before.liveBytes + 100);
+  }
+
+  // nothing above leaked
+  assert(memory_tracker::reportLeaks() == 0);
+
+  // leaks are reported, from global new and from pools alike
+  {
+    memory_tracker::TagScope tag(MemoryTag::Assets);
+    escape = new int(42);
+  }
+  PoolAllocator pool(32, 4, PoolAllocator::Fixed, MemoryTag::ECS);
+  void *block = pool.allocate();
+  assert(block != nullptr);
+  assert(memory_tracker::reportLeaks() == 2);
+
+  pool.deallocate(block);
+  assert(memory_tracker::reportLeaks() == 1);
+
+  // allocations made before a new baseline are left out
+  memory_tracker::markBaseline();
+  assert(memory_tracker::reportLeaks() == 0);
+  return 0;
+}
@@ -0,0 +1,112 @@
+#include "../engine/entity/motion_kernels.h"
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Odd count so every backend runs its vector loop and its tail
+constexpr uint32_t COUNT = 1037;
+constexpr float DELTA_TIME = 1.0f / 60.0f;
+constexpr int STEPS = 8;
+
+struct InterleavedData {
+  std::vector<Position> positions;
+  std::vector<Velocity> velocities;
+};
+
+struct SplitData {
+  std::vector<float> px, py, pz, vx, vy, vz;
+  Vector3Streams pos() { return {px.data(), py.data(), pz.data()}; }
+  Vector3Streams vel() { return {vx.data(), vy.data(), vz.data()}; }
+};
+
+InterleavedData makeInterleaved() {
+  std::mt19937 rng(1234);
+  std::uniform_real_distribution<float> dist(-1000.0f, 1000.0f);
+  InterleavedData data;
+  data.positions.resize(COUNT);
+  data.velocities.resize(COUNT);
+  for (uint32_t i = 0; i < COUNT; ++i) {
+    data.positions[i].value =
+        mathplease::Vector4(dist(rng), dist(rng), dist(rng), dist(rng));
+    data.velocities[i].value =
+        mathplease::Vector4(dist(rng), dist(rng), dist(rng), dist(rng));
+  }
+  // w lanes must survive untouched, including values where w + 0*w != w
+  data.positions[0].value.w = -0.0f;
+  data.positions[1].value.w = std::numeric_limits<float>::infinity();
+  data.velocities[1].value.w = std::numeric_limits<float>::infinity();
+  return data;
+}
+
+SplitData makeSplit() {
+  std::mt19937 rng(5678);
+  std::uniform_real_distribution<float> dist(-1000.0f, 1000.0f);
+  SplitData data;
+  for (auto *stream : {&data.px, &data.py, &data.pz, &data.vx, &data.vy, &data.vz}) {
+    stream->resize(COUNT);
+    for (float &value : *stream) value = dist(rng);
+  }
+  return data;
+}
+
+} // namespace
+
+int main() {
+  assert(isKernelBackendSupported(KernelBackend::Scalar));
+  assert(isKernelBackendSupported(detectKernelBackend()));
+
+  InterleavedData expectedInterleaved = makeInterleaved();
+  SplitData expectedSplit = makeSplit();
+  const GravityKernels &scalar = getGravityKernels(KernelBackend::Scalar);
+  for (int step = 0; step < STEPS; ++step) {
+    scalar.interleaved(expectedInterleaved.positions.data(),
+                       expectedInterleaved.velocities.data(), COUNT, DELTA_TIME);
+    scalar.split(expectedSplit.pos(), expectedSplit.vel(), COUNT, DELTA_TIME);
+  }
+
+  // sanity check the reference against the closed-form single step
+  {
+    InterleavedData one = makeInterleaved();
+    const mathplease::Vector4 p0 = one.positions[5].value;
+    const mathplease::Vector4 v0 = one.velocities[5].value;
+    scalar.interleaved(one.positions.data(), one.velocities.data(), COUNT, DELTA_TIME);
+    const float vy = v0.y - 9.81f * DELTA_TIME;
+    assert(one.velocities[5].value.y == vy);
+    assert(one.positions[5].value.x == p0.x + v0.x * DELTA_TIME);
+    assert(one.positions[5].value.y == p0.y + vy * DELTA_TIME);
+    assert(one.positions[5].value.w == p0.w);
+    assert(std::signbit(one.positions[0].value.w));
+  }
+
+  for (KernelBackend backend :
+       {KernelBackend::Scalar, KernelBackend::SSE, KernelBackend::AVX2}) {
+    if (!isKernelBackendSupported(backend)) continue;
+    const GravityKernels &kernels = getGravityKernels(backend);
+
+    InterleavedData interleaved = makeInterleaved();
+    SplitData split = makeSplit();
+    for (int step = 0; step < STEPS; ++step) {
+      kernels.interleaved(interleaved.positions.data(),
+                          interleaved.velocities.data(), COUNT, DELTA_TIME);
+      kernels.split(split.pos(), split.vel(), COUNT, DELTA_TIME);
+    }
+
+    assert(std::memcmp(interleaved.positions.data(),
+                       expectedInterleaved.positions.data(),
+                       COUNT * sizeof(Position)) == 0);
+    assert(std::memcmp(interleaved.velocities.data(),
+                       expectedInterleaved.velocities.data(),
+                       COUNT * sizeof(Velocity)) == 0);
+    assert(split.px == expectedSplit.px && split.py == expectedSplit.py &&
+           split.pz == expectedSplit.pz);
+    assert(split.vx == expectedSplit.vx && split.vy == expectedSplit.vy &&
+           split.vz == expectedSplit.vz);
+  }
+
+  return 0;
+}
@@ -0,0 +1,60 @@
+#include "../engine/entity/entity.h"
+#include "../engine/entity/prefab.h"
+#include <cassert>
+#include <unordered_set>
+#include <vector>
+
+int main() {
+  EntityManager em;
+
+  const ComponentMask mask = Components::Position | Components::Velocity |
+                             Components::Gravity | Components::Renderable;
+  Prefab prefab(mask);
+  const bool setAll =
+      prefab.set(Components::Position, Position{mathplease::Vector4(1.0f, 2.0f, 3.0f, 1.0f)}) &&
+      prefab.set(Components::Velocity, Velocity{mathplease::Vector4(0.0f, 5.0f, 0.0f, 0.0f)}) &&
+      prefab.set(Components::Renderable, Renderable{4, 9});
+  assert(setAll);
+  // wrong type for the component, or a component outside the mask; the
+  // velocity checked below is left as it was
+  const bool wrongType = prefab.set(Components::Velocity, Renderable{1, 1});
+  const bool notInMask = prefab.set(Components::Health, Health{});
+  assert(!wrongType && !notInMask);
+
+  // one regular entity first so instantiate has to top up a partial chunk
+  Entity_id single = em.createEntity(mask);
+  assert(single != NULL_ENTITY);
+
+  std::vector<Entity_id> ids;
+  const uint32_t count = 5000; // spans many chunks
+  const uint32_t made = em.instantiate(prefab, count, &ids);
+  assert(made == count);
+  assert(ids.size() == count);
+
+  std::unordered_set<Entity_id> unique(ids.begin(), ids.end());
+  unique.insert(single);
+  assert(unique.size() == count + 1);
+
+  for (Entity_id id : ids) {
+    auto *pos = static_cast<Position *>(em.getComponentData(id, Components::Position));
+    auto *vel = static_cast<Velocity *>(em.getComponentData(id, Components::Velocity));
+    auto *renderable =
+        static_cast<Renderable *>(em.getComponentData(id, Components::Renderable));
+    assert(pos && vel && renderable);
+    assert(pos->value.x == 1.0f && pos->value.y == 2.0f && pos->value.z == 3.0f);
+    assert(vel->value.y == 5.0f);
+    assert(renderable->meshId == 4 && renderable->materialId == 9);
+    assert(em.getComponentData(id, Components::Health) == nullptr);
+  }
+
+  assert(em.getAllEntitiesWithComponents(mask).size() == count + 1);
+
+  // instances are ordinary entities afterwards
+  em.destroyEntity(ids[0]);
+  em.removeComponent(ids[1], Components::Gravity);
+  assert(em.getAllEntitiesWithComponents(mask).size() == count - 1);
+  auto *moved = static_cast<Position *>(em.getComponentData(ids[1], Components::Position));
+  assert(moved && moved->value.z == 3.0f);
+
+  return 0;
+}
@@ -0,0 +1,108 @@
+#include "../engine/entity/entity.h"
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+int main() {
+  EntityManager em;
+  const ComponentMask mask = Components::Position;
+
+  // stale ids are rejected once their index is reused
+  Entity_id first = em.createEntity(mask);
+  em.destroyEntity(first);
+  assert(!em.isAlive(first));
+  Entity_id reused = em.createEntity(mask);
+  assert((reused & BITMASK_INDEX) == (first & BITMASK_INDEX));
+  assert(reused != first);
+  assert(em.isAlive(reused));
+  assert(em.getComponentData(first, Components::Position) == nullptr);
+  em.destroyEntity(first); // stale handle must not kill the new entity
+  assert(em.isAlive(reused));
+
+  // root -> {a, b, c}, a -> {a1, a2}, a2 -> {deep}
+  Entity_id root = em.createEntity(mask);
+  Entity_id a = em.createEntity(mask);
+  Entity_id b = em.createEntity(mask | Components::Health);
+  Entity_id c = em.createEntity(mask);
+  Entity_id a1 = em.createEntity(mask);
+  Entity_id a2 = em.createEntity(mask);
+  Entity_id deep = em.createEntity(Components::AI);
+  const bool rootLinked = em.setParent(a, root) && em.setParent(b, root) && em.setParent(c, root);
+  const bool aLinked = em.setParent(a1, a) && em.setParent(a2, a) && em.setParent(deep, a2);
+  assert(rootLinked && aLinked);
+
+  assert(em.getParent(a1) == a);
+  assert(em.getParent(root) == NULL_ENTITY);
+  assert(em.getChildren(root).size() == 3);
+  assert(em.getChildren(c).empty());
+
+  // cycles and self relations are refused
+  const bool cycle = em.setParent(root, deep);
+  const bool self = em.setParent(a, a);
+  const bool staleParent = em.setParent(a, first);
+  assert(!cycle && !self && !staleParent);
+
+  std::vector<Entity_id> descendants;
+  em.getDescendants(Relation::ChildOf, root, descendants);
+  assert(descendants.size() == 6);
+  // level order: children of root come before grandchildren
+  for (int i = 0; i < 3; ++i) {
+    assert(em.getParent(descendants[i]) == root);
+  }
+  assert(descendants.back() == deep);
+
+  // reparenting moves the child between contiguous lists
+  const bool reparented = em.setParent(c, a);
+  assert(reparented);
+  assert(em.getChildren(root).size() == 2);
+  assert(em.getChildren(a).size() == 3);
+  em.removeRelation(Relation::ChildOf, c);
+  assert(em.getParent(c) == NULL_ENTITY);
+  assert(em.getChildren(a).size() == 2);
+
+  // owner destroys what it owns; relations are independent of each other
+  Entity_id owner = em.createEntity(mask);
+  Entity_id item = em.createEntity(Components::Renderable);
+  const bool ownsItem = em.addRelation(Relation::Owns, owner, item);
+  const bool ownsC = em.addRelation(Relation::Owns, a1, c);
+  assert(ownsItem && ownsC);
+  assert(em.getRelationHolder(Relation::Owns, item) == owner);
+  assert(em.getRelationMembers(Relation::Owns, owner).size() == 1);
+
+  // cascading destroy: root takes its whole subtree, and a1 takes what it owns
+  em.destroyEntity(root);
+  for (Entity_id id : {root, a, b, a1, a2, deep, c}) {
+    assert(!em.isAlive(id));
+  }
+  assert(em.isAlive(owner) && em.isAlive(item) && em.isAlive(reused));
+  assert(em.getAllEntitiesWithComponents(Components::Position).size() == 2);
+  assert(em.getAllEntitiesWithComponents(Components::AI).empty());
+
+  // freed indices come back with a new generation and no stale relations
+  Entity_id fresh = em.createEntity(mask);
+  assert(em.getParent(fresh) == NULL_ENTITY);
+  assert(em.getChildren(fresh).empty());
+
+  em.destroyEntity(owner);
+  assert(!em.isAlive(item));
+
+  // wide hierarchy: children stay contiguous through removals
+  Entity_id parent = em.createEntity(mask);
+  std::vector<Entity_id> kids;
+  for (int i = 0; i < 1000; ++i) {
+    kids.push_back(em.createEntity(mask));
+    em.setParent(kids.back(), parent);
+  }
+  for (int i = 0; i < 1000; i += 2) {
+    em.destroyEntity(kids[i]);
+  }
+  std::span<const Entity_id> remaining = em.getChildren(parent);
+  assert(remaining.size() == 500);
+  for (Entity_id kid : remaining) {
+    assert(em.isAlive(kid) && em.getParent(kid) == parent);
+  }
+  em.destroyEntity(parent);
+  assert(em.getAllEntitiesWithComponents(Components::Position).size() == 2);
+
+  return 0;
+}
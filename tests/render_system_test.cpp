@@ -66,5 +66,52 @@ int main() {
   assert(secondDrawable->transform(1, 3) == 1.0f);
   assert(secondDrawable->transform(2, 3) == 2.0f);
 
+  // attached entities draw with their cached world matrix, which follows
+  // the parent and picks up Position writes through the component events
+  SceneGraph sceneGraph(em);
+  const Transform_id parent = sceneGraph.attachEntity(firstEntity);
+  const Transform_id child = sceneGraph.attachEntity(secondEntity, parent);
+  assert(child != NULL_TRANSFORM);
+  assert(em.hasComponent(secondEntity, Components::Transformable));
+  const Position moved{mathplease::Vector4(10.0f, 0.0f, 0.0f, 1.0f)};
+  em.writeComponent(firstEntity, Components::Position, &moved);
+  em.getEvents().sync();
+  sceneGraph.syncEntities();
+  sceneGraph.updateWorldTransforms(nullptr);
+
+  // the scratch-memory list matches the heap one and only keeps what it uses
+  LinearAllocator scratch(4096);
+  const auto heapDrawables = renderSystem.collectDrawables(em, &sceneGraph);
+  const std::span<Renderer::Drawable> scratchDrawables =
+      renderSystem.collectDrawables(em, scratch, &sceneGraph);
+  assert(scratchDrawables.size() == heapDrawables.size());
+  for (size_t i = 0; i < heapDrawables.size(); ++i) {
+    assert(scratchDrawables[i].mesh == heapDrawables[i].mesh);
+    assert(scratchDrawables[i].transform(0, 3) == heapDrawables[i].transform(0, 3));
+  }
+  assert(scratch.getUsed() <= sizeof(Renderer::Drawable) * (heapDrawables.size() + 1));
+  LinearAllocator tooSmall(sizeof(Renderer::Drawable));
+  const std::span<Renderer::Drawable> notFitted = renderSystem.collectDrawables(em, tooSmall, &sceneGraph);
+  assert(notFitted.data() == nullptr);
+  assert(tooSmall.getUsed() == 0);
+
+  for (const auto &drawable : heapDrawables) {
+    if (drawable.mesh == mesh) {
+      assert(drawable.transform(0, 3) == 10.0f);
+      assert(drawable.transform(1, 3) == 0.0f);
+    } else {
+      assert(drawable.transform(0, 3) == 10.0f);
+      assert(drawable.transform(1, 3) == 1.0f);
+      assert(drawable.transform(2, 3) == 2.0f);
+    }
+  }
+
+  // destroying the parent entity deletes its transform subtree
+  em.destroyEntity(firstEntity);
+  em.getEvents().sync();
+  sceneGraph.syncEntities();
+  assert(sceneGraph.getTransformCount() == 0);
+  assert(sceneGraph.getEntityTransform(secondEntity) == NULL_TRANSFORM);
+
   return 0;
 }
@@ -0,0 +1,175 @@
+#include "../engine/entity/sceneGraph.h"
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using mathplease::Matrix4;
+using mathplease::Quaternion;
+using mathplease::Transform;
+using mathplease::Vector4;
+
+namespace {
+
+bool nearlyEqual(const Matrix4 &a, const Matrix4 &b) {
+  for (int i = 0; i < 16; ++i) {
+    if (std::fabs(a.m[i] - b.m[i]) > 1e-3f * (1.0f + std::fabs(b.m[i]))) return false;
+  }
+  return true;
+}
+
+// Reference world matrix by walking the parent chain
+Matrix4 referenceWorld(const SceneGraph &graph, Transform_id id) {
+  Matrix4 world = graph.getLocalMatrix(id);
+  for (Transform_id p = graph.getParent(id); p != NULL_TRANSFORM; p = graph.getParent(p)) {
+    world = graph.getLocalMatrix(p) * world;
+  }
+  return world;
+}
+
+uint32_t referenceDepth(const SceneGraph &graph, Transform_id id) {
+  uint32_t depth = 0;
+  for (Transform_id p = graph.getParent(id); p != NULL_TRANSFORM; p = graph.getParent(p)) ++depth;
+  return depth;
+}
+
+} // namespace
+
+int main() {
+  // two-level bitset: set bits are found in order across words and groups
+  DirtyBitset bits;
+  bits.resize(10000);
+  assert(bits.findNext(0, bits.size()) == DirtyBitset::NONE);
+  for (uint32_t i : {3u, 64u, 4095u, 4096u, 9999u}) bits.set(i);
+  std::vector<uint32_t> found;
+  for (uint32_t i = bits.findNext(0, 10000); i != DirtyBitset::NONE; i = bits.findNext(i + 1, 10000)) {
+    found.push_back(i);
+  }
+  assert((found == std::vector<uint32_t>{3, 64, 4095, 4096, 9999}));
+  assert(bits.findNext(65, 4095) == DirtyBitset::NONE);
+  bits.reset(64);
+  assert(bits.findNext(4, 5000) == 4095);
+  bits.resize(9999); // drops bit 9999
+  bits.resize(10000);
+  assert(!bits.test(9999));
+  bits.clear();
+  assert(bits.findNext(0, bits.size()) == DirtyBitset::NONE);
+
+  EntityManager em;
+  SceneGraph graph(em);
+
+  // root -> a -> b, translations accumulate down the chain
+  Transform_id root = graph.createTransform();
+  Transform_id a = graph.createTransform(root);
+  Transform_id b = graph.createTransform(a);
+  graph.setLocalPosition(root, Vector4(1.0f, 0.0f, 0.0f, 1.0f));
+  graph.setLocalPosition(a, Vector4(0.0f, 2.0f, 0.0f, 1.0f));
+  graph.setLocalPosition(b, Vector4(0.0f, 0.0f, 3.0f, 1.0f));
+  graph.updateWorldTransforms(nullptr);
+  Matrix4 world = graph.getWorldMatrix(b);
+  assert(world(0, 3) == 1.0f && world(1, 3) == 2.0f && world(2, 3) == 3.0f);
+  assert(graph.getDepth(b) == 2 && graph.getLevelCount() == 3);
+
+  // 90 degrees about z on the root rotates the children's offsets
+  const float half = std::sqrt(0.5f);
+  graph.setLocalRotation(root, Quaternion(0.0f, 0.0f, half, half));
+  graph.updateWorldTransforms(nullptr);
+  world = graph.getWorldMatrix(b);
+  assert(std::fabs(world(0, 3) - -1.0f) < 1e-5f && std::fabs(world(1, 3) - 0.0f) < 1e-5f);
+  assert(nearlyEqual(world, referenceWorld(graph, b)));
+
+  // reparenting to the same depth keeps the slot, other depths re-sort
+  Transform_id other = graph.createTransform();
+  const bool movedUnderOther = graph.setParent(a, other);
+  assert(movedUnderOther);
+  assert(graph.getParent(a) == other && graph.getDepth(b) == 2);
+  const bool cycle = graph.setParent(a, b);
+  assert(!cycle);
+  const bool detached = graph.setParent(a, NULL_TRANSFORM);
+  assert(detached);
+  assert(graph.getDepth(a) == 0 && graph.getDepth(b) == 1 && graph.getLevelCount() == 2);
+  graph.updateWorldTransforms(nullptr);
+  world = graph.getWorldMatrix(b);
+  assert(world(0, 3) == 0.0f && world(1, 3) == 2.0f && world(2, 3) == 3.0f);
+
+  // deleting cascades and stale handles stay dead after index reuse
+  const bool movedUnderRoot = graph.setParent(a, root);
+  assert(movedUnderRoot);
+  graph.deleteTransform(a);
+  assert(!graph.alive(a) && !graph.alive(b) && graph.getTransformCount() == 2);
+  assert(graph.getChildren(root).empty());
+  Transform_id reused = graph.createTransform(root);
+  assert((reused & BITMASK_INDEX) == (b & BITMASK_INDEX) || (reused & BITMASK_INDEX) == (a & BITMASK_INDEX));
+  assert(!graph.alive(a) && graph.alive(reused));
+  assert(graph.getWorldTransformPtr(a) == nullptr);
+  graph.deleteTransform(root);
+  graph.deleteTransform(other);
+  assert(graph.getTransformCount() == 0 && graph.getLevelCount() == 0);
+
+  // random structural churn against the parent-chain reference
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+  std::vector<Transform_id> live;
+  for (int step = 0; step < 4000; ++step) {
+    const uint32_t op = live.empty() ? 0 : rng() % 10;
+    if (op < 5) {
+      Transform_id parent = live.empty() || rng() % 4 == 0 ? NULL_TRANSFORM : live[rng() % live.size()];
+      Transform_id id = graph.createTransform(parent);
+      const Quaternion q = Quaternion(unit(rng), unit(rng), unit(rng), unit(rng)).normalized();
+      graph.setLocalTRS(id, Vector4(unit(rng), unit(rng), unit(rng), 1.0f), q,
+                        Vector4(1.0f + 0.1f * unit(rng), 1.0f, 1.0f, 1.0f));
+      live.push_back(id);
+    } else if (op < 8) {
+      Transform_id child = live[rng() % live.size()];
+      Transform_id parent = rng() % 5 == 0 ? NULL_TRANSFORM : live[rng() % live.size()];
+      graph.setParent(child, parent);
+    } else if (op == 8) {
+      graph.deleteTransform(live[rng() % live.size()]);
+      std::erase_if(live, [&](Transform_id id) { return !graph.alive(id); });
+    } else {
+      graph.setLocalPosition(live[rng() % live.size()], Vector4(unit(rng), unit(rng), unit(rng), 1.0f));
+    }
+
+    if (step % 97 == 0) {
+      graph.updateWorldTransforms(nullptr);
+      assert(graph.getTransformCount() == live.size());
+      for (Transform_id id : live) {
+        assert(graph.getDepth(id) == referenceDepth(graph, id));
+        assert(nearlyEqual(graph.getWorldMatrix(id), referenceWorld(graph, id)));
+        for (Transform_id child : graph.getChildren(id)) assert(graph.getParent(child) == id);
+      }
+    }
+  }
+
+  // level-parallel update matches the serial pass bit for bit
+  JobSystem jobSystem;
+  jobSystem.initialize(4);
+  SceneGraph serial(em);
+  SceneGraph parallel(em);
+  // same build order on fresh graphs, so both hand out the same handles
+  std::vector<Transform_id> ids;
+  for (uint32_t i = 0; i < 20000; ++i) {
+    const Transform_id parent = i < 8 ? NULL_TRANSFORM : ids[rng() % ids.size()];
+    ids.push_back(serial.createTransform(parent));
+    const Transform_id mirrored = parallel.createTransform(parent);
+    assert(mirrored == ids.back());
+    const Vector4 position(unit(rng), unit(rng), unit(rng), 1.0f);
+    serial.setLocalPosition(ids.back(), position);
+    parallel.setLocalPosition(ids.back(), position);
+  }
+  for (int frame = 0; frame < 3; ++frame) {
+    for (int d = 0; d < 200; ++d) {
+      const Transform_id pick = ids[rng() % ids.size()];
+      const Quaternion rotation(0.0f, std::sin(0.01f * d), 0.0f, std::cos(0.01f * d));
+      serial.setLocalRotation(pick, rotation);
+      parallel.setLocalRotation(pick, rotation);
+    }
+    serial.updateWorldTransforms(nullptr);
+    parallel.updateWorldTransforms(&jobSystem);
+    for (Transform_id id : ids) {
+      assert(std::memcmp(serial.getWorldTransformPtr(id), parallel.getWorldTransformPtr(id), sizeof(Transform)) == 0);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,86 @@
+#include "../engine/entity/entity.h"
+#include "../engine/entity/scheduler.h"
+#include "../engine/entity/systems.h"
+#include "../engine/job_system.h"
+#include <atomic>
+#include <cassert>
+#include <cmath>
+
+namespace {
+bool approx(float a, float b, float eps = 1e-4f) {
+  return std::fabs(a - b) <= eps;
+}
+} // namespace
+
+int main() {
+  EntityManager em;
+  JobSystem jobSystem;
+  jobSystem.initialize(2);
+  GravitySystem gravitySystem;
+  SystemScheduler scheduler;
+
+  std::atomic<int> healthReads{0};
+  std::atomic<int> aiWrites{0};
+  std::atomic<int> positionReads{0};
+
+  // gravity writes Position/Velocity; health and AI touch disjoint components
+  // and can share its phase; the position reader must wait for gravity.
+  const System_id gravityId = scheduler.registerSystem("Gravity", gravitySystem);
+  const System_id healthId = scheduler.registerSystem(
+      "HealthReader", Components::Health, 0,
+      [&healthReads](EntityManager &, JobSystem *, float) { healthReads++; });
+  const System_id aiId = scheduler.registerSystem(
+      "AIWriter", Components::Health, Components::AI,
+      [&aiWrites](EntityManager &, JobSystem *, float) { aiWrites++; });
+  const System_id positionId = scheduler.registerSystem(
+      "PositionReader", Components::Position, 0,
+      [&positionReads](EntityManager &, JobSystem *, float) { positionReads++; });
+
+  assert(SystemScheduler::conflicts({Components::Position, 0},
+                                    {0, Components::Position}));
+  assert(!SystemScheduler::conflicts({Components::Position, 0},
+                                     {Components::Position, 0}));
+
+  const auto &phases = scheduler.getPhases();
+  assert(phases.size() == 2);
+  assert(phases[0].size() == 3);
+  assert(phases[1].size() == 1 && phases[1][0] == positionId);
+
+  const ComponentMask gravityMask =
+      Components::Position | Components::Velocity | Components::Gravity;
+  Entity_id falling = em.createEntity(gravityMask);
+  auto *pos =
+      static_cast<Position *>(em.getComponentData(falling, Components::Position));
+  auto *vel =
+      static_cast<Velocity *>(em.getComponentData(falling, Components::Velocity));
+  pos->value = mathplease::Vector4(0.0f, 10.0f, 0.0f, 1.0f);
+  vel->value = mathplease::Vector4(0.0f, 0.0f, 0.0f, 0.0f);
+
+  scheduler.run(em, &jobSystem, 1.0f);
+  scheduler.run(em, &jobSystem, 1.0f);
+
+  assert(healthReads.load() == 2);
+  assert(aiWrites.load() == 2);
+  assert(positionReads.load() == 2);
+
+  pos = static_cast<Position *>(em.getComponentData(falling, Components::Position));
+  vel = static_cast<Velocity *>(em.getComponentData(falling, Components::Velocity));
+  assert(approx(vel->value.y, -19.62f));
+  assert(approx(pos->value.y, 10.0f - 9.81f - 19.62f));
+
+  const auto &stats = scheduler.getLastFrameStats();
+  assert(stats.systems.size() == 4);
+  assert(stats.systems[healthId].phase == 0);
+  assert(stats.systems[aiId].phase == 0);
+  assert(!stats.criticalPath.empty());
+  if (stats.criticalPath.size() == 2) {
+    assert(stats.criticalPath[0] == gravityId);
+    assert(stats.criticalPath[1] == positionId);
+  }
+  for (const auto &timing : stats.systems) {
+    assert(stats.criticalPathSeconds >= timing.seconds);
+  }
+  assert(stats.criticalPathSeconds <= stats.frameSeconds);
+
+  return 0;
+}
@@ -0,0 +1,161 @@
+#include "../engine/math/vertex_packing.hpp"
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace mathplease;
+
+namespace {
+
+bool sameBits(const Vector3 &a, const Vector3 &b) { return std::memcmp(&a, &b, sizeof(Vector3)) == 0; }
+bool sameBits(const Vector2 &a, const Vector2 &b) { return std::memcmp(&a, &b, sizeof(Vector2)) == 0; }
+
+// Laid out like the engine's Vertex, so the batches run with a real stride
+struct InterleavedVertex {
+  Vector3 pos;
+  Vector3 colour;
+  Vector3 normal;
+  Vector2 uv;
+};
+
+struct PackedFields {
+  Unorm16x4 pos;
+  uint32_t colour;
+  uint32_t normal;
+  Half2 uv;
+};
+
+} // namespace
+
+int main() {
+  // half floats: exact values, rounding, overflow and subnormals
+  assert(floatToHalf(1.0f) == 0x3c00 && floatToHalf(-2.0f) == 0xc000);
+  assert(floatToHalf(65504.0f) == 0x7bff && floatToHalf(65520.0f) == 0x7c00);
+  assert(floatToHalf(std::numeric_limits<float>::infinity()) == 0x7c00);
+  assert(floatToHalf(-0.0f) == 0x8000 && floatToHalf(1e-8f) == 0);
+  assert(floatToHalf(std::ldexp(1.0f, -24)) == 0x0001);
+  assert(floatToHalf(1.0f + std::ldexp(1.0f, -11)) == 0x3c00); // tie to even
+  assert(floatToHalf(1.0f + 3.0f * std::ldexp(1.0f, -11)) == 0x3c02);
+  assert(std::isnan(halfToFloat(floatToHalf(std::numeric_limits<float>::quiet_NaN()))));
+  assert(halfToFloat(0x0001) == std::ldexp(1.0f, -24) && halfToFloat(0x3555) == 0.333251953125f);
+
+  // every half survives the round trip, and the batch decode matches bit for bit
+  std::vector<Half2> halves;
+  for (uint32_t h = 0; h < 0x10000; h += 2) halves.push_back(Half2{uint16_t(h), uint16_t(h + 1)});
+  std::vector<Vector2> decoded(halves.size());
+  decodeHalf2({halves.data()}, {decoded.data()}, halves.size());
+  for (size_t i = 0; i < halves.size(); ++i) {
+    const Vector2 expected(halfToFloat(halves[i].x), halfToFloat(halves[i].y));
+    if (std::isnan(expected.x) || std::isnan(expected.y)) {
+      assert(std::isnan(decoded[i].x) == std::isnan(expected.x) && std::isnan(decoded[i].y) == std::isnan(expected.y));
+      continue;
+    }
+    assert(sameBits(decoded[i], expected));
+    assert(floatToHalf(expected.x) == halves[i].x && floatToHalf(expected.y) == halves[i].y);
+  }
+
+  // batch encode against the scalar reference over random bit patterns
+  std::mt19937 rng(11);
+  std::vector<Vector2> floats;
+  while (floats.size() < 200003) {
+    const Vector2 v(std::bit_cast<float>(uint32_t(rng())), std::bit_cast<float>(uint32_t(rng()) >> 3));
+    if (!std::isnan(v.x) && !std::isnan(v.y)) floats.push_back(v);
+  }
+  std::vector<Half2> encoded(floats.size());
+  encodeHalf2({floats.data()}, {encoded.data()}, floats.size());
+  for (size_t i = 0; i < floats.size(); ++i) {
+    assert(encoded[i].x == floatToHalf(floats[i].x) && encoded[i].y == floatToHalf(floats[i].y));
+  }
+
+  // octahedral normals: axes are exact, random directions stay close
+  for (const Vector3 axis : {Vector3::unitX(), Vector3::unitY(), Vector3::unitZ(), Vector3(0.0f, 0.0f, -1.0f),
+                             Vector3(-1.0f, 0.0f, 0.0f), Vector3(0.0f, -1.0f, 0.0f)}) {
+    assert(decodeOctahedral(encodeOctahedral(axis)) == axis);
+  }
+  std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+  std::vector<Vector3> normals;
+  while (normals.size() < 100001) {
+    const Vector3 v(unit(rng), unit(rng), unit(rng));
+    if (v.lengthSquared() > 1e-4f) normals.push_back(v.normalized());
+  }
+  std::vector<uint32_t> octahedral(normals.size());
+  std::vector<Vector3> unfolded(normals.size());
+  encodeOctahedral({normals.data()}, {octahedral.data()}, normals.size());
+  decodeOctahedral({octahedral.data()}, {unfolded.data()}, normals.size());
+  float worstSine = 0.0f;
+  for (size_t i = 0; i < normals.size(); ++i) {
+    assert(octahedral[i] == encodeOctahedral(normals[i]));
+    assert(sameBits(unfolded[i], decodeOctahedral(octahedral[i])));
+    assert(std::fabs(unfolded[i].length() - 1.0f) < 1e-6f);
+    assert(unfolded[i].dot(normals[i]) > 0.0f);
+    worstSine = std::max(worstSine, unfolded[i].cross(normals[i]).length());
+  }
+  assert(worstSine < 1e-4f);
+
+  // RGBA8: clamped, rounded to nearest, and every byte value round trips
+  assert(packUnorm4x8(Vector4(0.0f, 1.0f, 0.5f, 2.0f)) == 0xff80ff00u);
+  assert(packUnorm4x8(Vector4(-1.0f, 0.2f, 0.0f, 1.0f)) == 0xff003300u);
+  for (uint32_t value = 0; value < 256; ++value) {
+    const uint32_t packed = value | (255 - value) << 8 | (value ^ 0x5a) << 16 | 0xff000000u;
+    assert(packUnorm4x8(unpackUnorm4x8(packed)) == packed);
+  }
+
+  // quantised positions: error bounded by the step, out of range clamps,
+  // flat axes decode to the offset
+  const PositionQuantization quantization =
+      PositionQuantization::fromBounds(AABB{Vector3(-3.0f, 2.0f, 5.0f), Vector3(7.0f, 2.5f, 5.0f)});
+  assert(quantizePosition(quantization, Vector3(-4.0f, 9.0f, 5.0f)).x == 0);
+  assert(quantizePosition(quantization, Vector3(-4.0f, 9.0f, 5.0f)).y == 0xffff);
+  assert(quantizePosition(quantization, Vector3(0.0f, 2.0f, 5.0f)).w == 0xffff);
+  assert(dequantizePosition(quantization, quantizePosition(quantization, Vector3(7.0f, 2.0f, 5.0f))) ==
+         Vector3(7.0f, 2.0f, 5.0f));
+
+  // everything through one interleaved array, odd count for the scalar tail
+  std::uniform_real_distribution<float> colour(-0.1f, 1.1f);
+  std::vector<InterleavedVertex> vertices(1001);
+  for (size_t i = 0; i < vertices.size(); ++i) {
+    vertices[i].pos = Vector3(-3.0f + 10.0f * (0.5f + 0.5f * unit(rng)), 2.0f + 0.25f * (1.0f + unit(rng)), 5.0f);
+    vertices[i].colour = Vector3(colour(rng), colour(rng), colour(rng));
+    vertices[i].normal = normals[i];
+    vertices[i].uv = Vector2(4.0f * unit(rng), unit(rng));
+  }
+  std::vector<PackedFields> packed(vertices.size());
+  const size_t count = vertices.size();
+  quantizePositions(quantization, {&vertices[0].pos, sizeof(InterleavedVertex)}, {&packed[0].pos, sizeof(PackedFields)},
+                    count);
+  packColours({&vertices[0].colour, sizeof(InterleavedVertex)}, {&packed[0].colour, sizeof(PackedFields)}, count);
+  encodeOctahedral({&vertices[0].normal, sizeof(InterleavedVertex)}, {&packed[0].normal, sizeof(PackedFields)}, count);
+  encodeHalf2({&vertices[0].uv, sizeof(InterleavedVertex)}, {&packed[0].uv, sizeof(PackedFields)}, count);
+
+  std::vector<InterleavedVertex> unpacked(vertices.size());
+  dequantizePositions(quantization, {&packed[0].pos, sizeof(PackedFields)}, {&unpacked[0].pos, sizeof(InterleavedVertex)},
+                      count);
+  unpackColours({&packed[0].colour, sizeof(PackedFields)}, {&unpacked[0].colour, sizeof(InterleavedVertex)}, count);
+  decodeOctahedral({&packed[0].normal, sizeof(PackedFields)}, {&unpacked[0].normal, sizeof(InterleavedVertex)}, count);
+  decodeHalf2({&packed[0].uv, sizeof(PackedFields)}, {&unpacked[0].uv, sizeof(InterleavedVertex)}, count);
+
+  for (size_t i = 0; i < count; ++i) {
+    const InterleavedVertex &v = vertices[i];
+    const PackedFields &p = packed[i];
+    const Unorm16x4 q = quantizePosition(quantization, v.pos);
+    assert(p.pos.x == q.x && p.pos.y == q.y && p.pos.z == q.z && p.pos.w == 0xffff);
+    assert(p.colour == packUnorm4x8(Vector4(v.colour.x, v.colour.y, v.colour.z, 1.0f)));
+    assert(p.normal == encodeOctahedral(v.normal));
+    assert(sameBits(unpacked[i].pos, dequantizePosition(quantization, p.pos)));
+
+    assert(std::fabs(unpacked[i].pos.x - v.pos.x) <= 10.0f / 131070.0f + 1e-6f);
+    assert(std::fabs(unpacked[i].pos.y - v.pos.y) <= 0.5f / 131070.0f + 1e-6f);
+    assert(unpacked[i].pos.z == 5.0f);
+    for (int c = 0; c < 3; ++c) {
+      const float expected = std::min(std::max((&v.colour.x)[c], 0.0f), 1.0f);
+      assert(std::fabs((&unpacked[i].colour.x)[c] - expected) <= 0.5f / 255.0f + 1e-6f);
+    }
+    assert(std::fabs(unpacked[i].uv.x - v.uv.x) <= std::ldexp(1.0f, -9));
+    assert(std::fabs(unpacked[i].uv.y - v.uv.y) <= std::ldexp(1.0f, -11));
+  }
+  return 0;
+}
@@ -0,0 +1,110 @@
+#include "../engine/entity/entity.h"
+#include "../engine/entity/world_snapshot.h"
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+namespace {
+Position *positionOf(EntityManager &em, Entity_id id) {
+  return static_cast<Position *>(em.getComponentData(id, Components::Position));
+}
+} // namespace
+
+int main() {
+  EntityManager em;
+
+  const ComponentMask movingMask = Components::Position | Components::Velocity;
+  const ComponentMask healthMask = Components::Position | Components::Health;
+  std::vector<Entity_id> ids;
+  for (int i = 0; i < 1000; ++i) {
+    Entity_id id = em.createEntity(i % 3 == 0 ? healthMask : movingMask);
+    assert(id != NULL_ENTITY);
+    positionOf(em, id)->value = mathplease::Vector4(float(i), 0.0f, 0.0f, 1.0f);
+    ids.push_back(id);
+  }
+  auto *health = static_cast<Health *>(em.getComponentData(ids[3], Components::Health));
+  health->current = 7;
+  health->max = 9;
+  em.destroyEntity(ids[10]);
+  const bool parented = em.setParent(ids[6], ids[4]);
+  const bool owned = em.addRelation(Relation::Owns, ids[4], ids[7]);
+  assert(parented && owned);
+
+  // rollback: capture, mutate, restore
+  const std::vector<std::byte> snapshot = WorldSnapshot::capture(em);
+  positionOf(em, ids[5])->value.x = -1.0f;
+  em.destroyEntity(ids[20]);
+  em.createEntity(Components::AI);
+  const bool restored = WorldSnapshot::restore(em, snapshot);
+  assert(restored);
+
+  assert(positionOf(em, ids[5])->value.x == 5.0f);
+  assert(positionOf(em, ids[20])->value.x == 20.0f);
+  assert(em.getAllEntitiesWithComponents(Components::AI).empty());
+  assert(em.getAllEntitiesWithComponents(Components::Position).size() == 999);
+  health = static_cast<Health *>(em.getComponentData(ids[3], Components::Health));
+  assert(health->current == 7 && health->max == 9);
+  assert(em.getParent(ids[6]) == ids[4]);
+
+  // file round trip into a fresh world
+  const std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "lights_please_world_snapshot.bin";
+  const bool saved = WorldSnapshot::saveToFile(em, path);
+  assert(saved);
+
+  EntityManager loaded;
+  const bool loadedFromFile = WorldSnapshot::loadFromFile(loaded, path);
+  assert(loadedFromFile);
+  for (int i = 0; i < 1000; ++i) {
+    if (i == 10) continue;
+    assert(positionOf(loaded, ids[i])->value.x == float(i));
+  }
+  assert(loaded.getComponentData(ids[1], Components::Velocity) != nullptr);
+  assert(loaded.getComponentData(ids[3], Components::Velocity) == nullptr);
+  assert(loaded.getParent(ids[6]) == ids[4]);
+  assert(loaded.getRelationHolder(Relation::Owns, ids[7]) == ids[4]);
+
+  // freed ids survive the round trip and get reused
+  Entity_id reused = loaded.createEntity(movingMask);
+  assert((reused & BITMASK_INDEX) == (ids[10] & BITMASK_INDEX));
+  assert(reused != ids[10]); // with a new generation
+  loaded.destroyEntity(ids[4]); // relations still cascade after loading
+  assert(!loaded.isAlive(ids[6]) && !loaded.isAlive(ids[7]));
+
+  // corrupt data is rejected
+  std::vector<std::byte> corrupt = snapshot;
+  corrupt[0] = std::byte{0};
+  bool accepted = WorldSnapshot::restore(loaded, corrupt);
+  assert(!accepted);
+
+  // so are counts larger than the snapshot could hold, before anything is
+  // allocated for them (chunkCount and freeIdCount in the header)
+  for (std::size_t countOffset : {std::size_t(16), std::size_t(24)}) {
+    corrupt = snapshot;
+    for (std::size_t b = 0; b < 4; ++b) corrupt[countOffset + b] = std::byte{0xFF};
+    accepted = WorldSnapshot::restore(loaded, corrupt);
+    assert(!accepted);
+  }
+  corrupt.assign(snapshot.begin(), snapshot.end() - 1); // last chunk cut short
+  accepted = WorldSnapshot::restore(loaded, corrupt);
+  assert(!accepted);
+
+  // and chunks that disagree with the header: an entity count that is off
+  // (header offset 28), or one entity listed in two rows of the id column
+  // at the start of the first chunk (dataOffset at header offset 40)
+  corrupt = snapshot;
+  corrupt[28] = std::byte(std::to_integer<unsigned>(corrupt[28]) + 1);
+  accepted = WorldSnapshot::restore(loaded, corrupt);
+  assert(!accepted);
+  corrupt = snapshot;
+  std::uint64_t dataOffset = 0;
+  std::memcpy(&dataOffset, corrupt.data() + 40, sizeof(dataOffset));
+  std::memcpy(corrupt.data() + dataOffset + sizeof(Entity_id), corrupt.data() + dataOffset, sizeof(Entity_id));
+  accepted = WorldSnapshot::restore(loaded, corrupt);
+  assert(!accepted);
+
+  std::filesystem::remove(path);
+  return 0;
+}